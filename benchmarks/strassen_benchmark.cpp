@@ -0,0 +1,35 @@
+// Compares the blocked multiply kernel against Strassen–Winograd for a range
+// of sizes and cutoffs, to choose MultiplyOptions::strassenCutoff for the
+// machine it runs on.
+//
+//   strassen_benchmark [maxSize] [cutoff...]
+#include "engine/matrix_multiply.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+int main(int argc, char** argv) {
+    size_t maxSize = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    std::vector<size_t> cutoffs;
+    for (int i = 2; i < argc; i++) {
+        cutoffs.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+    if (cutoffs.empty()) {
+        cutoffs = {64, 128, 256, 512};
+    }
+    
+    std::vector<size_t> sizes;
+    for (size_t n = 128; n <= maxSize; n *= 2) {
+        sizes.push_back(n);
+        if (n + n / 2 <= maxSize) sizes.push_back(n + n / 2);
+    }
+    
+    std::printf("%8s %6s %7s %12s %12s %8s %10s\n", "cutoff", "n", "levels", "blocked (s)", "strassen (s)", "speedup", "max diff");
+    for (size_t cutoff : cutoffs) {
+        for (const auto& t : matrix_multiply::benchmarkCrossover(sizes, cutoff)) {
+            std::printf("%8zu %6zu %7zu %12.4f %12.4f %7.2fx %10.1e\n", cutoff, t.n, t.levels,
+                        t.blockedSeconds, t.strassenSeconds, t.blockedSeconds / t.strassenSeconds, t.maxDifference);
+        }
+    }
+    return 0;
+}
@@ -11,6 +11,7 @@ g++ -std=c++17 \
     -I/mingw64/include/SDL2 \
     -I../src \
     ../src/main.cpp \
+    ../src/engine/ast.cpp \
     ../src/engine/parser.cpp \
     ../src/engine/differentiator.cpp \
     ../src/engine/simplifier.cpp \
@@ -33,9 +34,26 @@ g++ -std=c++17 \
     ../src/engine/numerical_methods.cpp \
     ../src/engine/eigenvalues.cpp \
     ../src/engine/statistics.cpp \
+    ../src/engine/streaming_statistics.cpp \
+    ../src/engine/order_statistics.cpp \
+    ../src/engine/column_loader.cpp \
+    ../src/engine/multiple_regression.cpp \
+    ../src/engine/distributions.cpp \
+    ../src/engine/eigen_solver.cpp \
+    ../src/engine/matrix_factorization.cpp \
+    ../src/engine/sparse_matrix.cpp \
+    ../src/engine/iterative_solver.cpp \
+    ../src/engine/transform_batch.cpp \
+    ../src/engine/matrix_multiply.cpp \
+    ../src/engine/expression_program.cpp \
+    ../src/engine/ode_solver.cpp \
+    ../src/engine/root_finder.cpp \
+    ../src/engine/polynomial_operations.cpp \
+    ../src/engine/job_system.cpp \
     ../src/ui/renderer.cpp \
     ../src/ui/text_renderer.cpp \
     ../src/ui/plotter.cpp \
+    ../src/ui/live_preview.cpp \
     -L/mingw64/lib \
     -lmingw32 \
     -lSDL2main \
@@ -0,0 +1,230 @@
+#include "ast.h"
+
+namespace ast_traversal {
+
+// Work lists are reused per thread so evaluating a small tree inside a plot
+// loop does not allocate. Every traversal works above the size it found on
+// entry, which keeps a nested call on the same thread safe.
+struct EvalTask {
+    const ASTNode* node;
+    bool expanded;
+};
+
+static thread_local std::vector<EvalTask> evalTasks;
+static thread_local std::vector<double> evalValues;
+
+double evaluate(const ASTNode* root, double x, double y, bool bindY) {
+    std::vector<EvalTask>& tasks = evalTasks;
+    std::vector<double>& values = evalValues;
+    const size_t taskBase = tasks.size();
+    const size_t valueBase = values.size();
+    
+    tasks.push_back({root, false});
+    while (tasks.size() > taskBase) {
+        EvalTask task = tasks.back();
+        tasks.pop_back();
+        const ASTNode* node = task.node;
+        
+        switch (node->type) {
+            case NodeType::NUMBER:
+                values.push_back(static_cast<const NumberNode*>(node)->value);
+                break;
+            
+            case NodeType::VARIABLE:
+                if (bindY && static_cast<const VariableNode*>(node)->name == "y") {
+                    values.push_back(y);
+                } else {
+                    values.push_back(x);  // Default to x
+                }
+                break;
+            
+            case NodeType::BINARY_OP: {
+                auto binOp = static_cast<const BinaryOpNode*>(node);
+                if (!task.expanded) {
+                    tasks.push_back({node, true});
+                    tasks.push_back({binOp->right.get(), false});
+                    tasks.push_back({binOp->left.get(), false});
+                } else {
+                    double r = values.back();
+                    values.pop_back();
+                    double l = values.back();
+                    values.back() = BinaryOpNode::apply(binOp->op, l, r);
+                }
+                break;
+            }
+            
+            case NodeType::UNARY_FUNC: {
+                auto funcNode = static_cast<const UnaryFuncNode*>(node);
+                if (!task.expanded) {
+                    tasks.push_back({node, true});
+                    tasks.push_back({funcNode->arg.get(), false});
+                } else {
+                    values.back() = UnaryFuncNode::apply(funcNode->func, values.back());
+                }
+                break;
+            }
+        }
+    }
+    
+    double result = values.back();
+    values.resize(valueBase);
+    return result;
+}
+
+std::unique_ptr<ASTNode> clone(const ASTNode* root) {
+    std::vector<EvalTask> tasks;
+    std::vector<std::unique_ptr<ASTNode>> built;
+    
+    tasks.push_back({root, false});
+    while (!tasks.empty()) {
+        EvalTask task = tasks.back();
+        tasks.pop_back();
+        const ASTNode* node = task.node;
+        
+        switch (node->type) {
+            case NodeType::NUMBER:
+            case NodeType::VARIABLE:
+                built.push_back(node->clone());
+                break;
+            
+            case NodeType::BINARY_OP: {
+                auto binOp = static_cast<const BinaryOpNode*>(node);
+                if (!task.expanded) {
+                    tasks.push_back({node, true});
+                    tasks.push_back({binOp->right.get(), false});
+                    tasks.push_back({binOp->left.get(), false});
+                } else {
+                    auto r = std::move(built.back());
+                    built.pop_back();
+                    auto l = std::move(built.back());
+                    built.back() = std::make_unique<BinaryOpNode>(binOp->op, std::move(l), std::move(r));
+                }
+                break;
+            }
+            
+            case NodeType::UNARY_FUNC: {
+                auto funcNode = static_cast<const UnaryFuncNode*>(node);
+                if (!task.expanded) {
+                    tasks.push_back({node, true});
+                    tasks.push_back({funcNode->arg.get(), false});
+                } else {
+                    built.back() = std::make_unique<UnaryFuncNode>(funcNode->func, std::move(built.back()));
+                }
+                break;
+            }
+        }
+    }
+    
+    return std::move(built.back());
+}
+
+// Cuts to at most 'limit' bytes without splitting a multi-byte character (⋅, √)
+static void truncateUtf8(std::string& out, size_t limit) {
+    size_t cut = limit;
+    while (cut > 0 && (static_cast<unsigned char>(out[cut]) & 0xC0) == 0x80) {
+        cut--;
+    }
+    out.resize(cut);
+    out += "…";
+}
+
+void print(const ASTNode* root, std::string& out, size_t maxLength) {
+    // Each task either prints a node or emits a literal piece of punctuation
+    struct PrintTask {
+        const ASTNode* node;
+        const char* text;
+    };
+    std::vector<PrintTask> tasks;
+    const size_t limit = (maxLength == std::string::npos) ? maxLength : out.size() + maxLength;
+    
+    tasks.push_back({root, nullptr});
+    while (!tasks.empty()) {
+        if (out.size() > limit) {
+            truncateUtf8(out, limit);
+            return;
+        }
+        
+        PrintTask task = tasks.back();
+        tasks.pop_back();
+        
+        if (!task.node) {
+            out += task.text;
+            continue;
+        }
+        
+        const ASTNode* node = task.node;
+        switch (node->type) {
+            case NodeType::NUMBER:
+                out += node->toString();
+                break;
+            
+            case NodeType::VARIABLE:
+                out += static_cast<const VariableNode*>(node)->name;
+                break;
+            
+            case NodeType::BINARY_OP: {
+                auto binOp = static_cast<const BinaryOpNode*>(node);
+                bool needParensLeft = (binOp->left->type == NodeType::BINARY_OP);
+                bool needParensRight = (binOp->right->type == NodeType::BINARY_OP);
+                
+                // Pushed in reverse: (left) op (right)
+                if (needParensRight) tasks.push_back({nullptr, ")"});
+                tasks.push_back({binOp->right.get(), nullptr});
+                if (needParensRight) tasks.push_back({nullptr, "("});
+                tasks.push_back({nullptr, BinaryOpNode::symbol(binOp->op)});
+                if (needParensLeft) tasks.push_back({nullptr, ")"});
+                tasks.push_back({binOp->left.get(), nullptr});
+                if (needParensLeft) tasks.push_back({nullptr, "("});
+                break;
+            }
+            
+            case NodeType::UNARY_FUNC: {
+                auto funcNode = static_cast<const UnaryFuncNode*>(node);
+                out += UnaryFuncNode::name(funcNode->func);
+                out += "(";
+                tasks.push_back({nullptr, ")"});
+                tasks.push_back({funcNode->arg.get(), nullptr});
+                break;
+            }
+        }
+    }
+    
+    if (out.size() > limit) {
+        truncateUtf8(out, limit);
+    }
+}
+
+static bool isLeaf(const std::unique_ptr<ASTNode>& node) {
+    return !node || node->type == NodeType::NUMBER || node->type == NodeType::VARIABLE;
+}
+
+void releaseSubtrees(std::unique_ptr<ASTNode>& first, std::unique_ptr<ASTNode>* second) {
+    // Common case: leaf children, nothing deep to unwind
+    if (isLeaf(first) && (!second || isLeaf(*second))) {
+        return;
+    }
+    
+    std::vector<std::unique_ptr<ASTNode>> pending;
+    pending.push_back(std::move(first));
+    if (second) {
+        pending.push_back(std::move(*second));
+    }
+    
+    while (!pending.empty()) {
+        std::unique_ptr<ASTNode> node = std::move(pending.back());
+        pending.pop_back();
+        if (!node) continue;
+        
+        // Detach the children first so this node's destructor has nothing to recurse into
+        if (node->type == NodeType::BINARY_OP) {
+            auto binOp = static_cast<BinaryOpNode*>(node.get());
+            pending.push_back(std::move(binOp->left));
+            pending.push_back(std::move(binOp->right));
+        } else if (node->type == NodeType::UNARY_FUNC) {
+            auto funcNode = static_cast<UnaryFuncNode*>(node.get());
+            pending.push_back(std::move(funcNode->arg));
+        }
+    }
+}
+
+} // namespace ast_traversal
@@ -19,6 +19,22 @@ enum class UnaryFunc {
     SIN, COS, TAN, EXP, LN, SQRT
 };
 
+class ASTNode;
+
+// Explicit-stack implementations behind the virtual methods of the interior
+// nodes, so generated sums with 100k+ terms or deeply nested derivatives
+// cannot overflow the call stack (see ast.cpp).
+namespace ast_traversal {
+    double evaluate(const ASTNode* root, double x, double y, bool bindY);
+    std::unique_ptr<ASTNode> clone(const ASTNode* root);
+    
+    // Appends the printed form to 'out'; stops with "…" after maxLength bytes
+    void print(const ASTNode* root, std::string& out, size_t maxLength = std::string::npos);
+    
+    // Tears down child subtrees without recursing through their destructors
+    void releaseSubtrees(std::unique_ptr<ASTNode>& first, std::unique_ptr<ASTNode>* second);
+}
+
 class ASTNode {
 public:
     NodeType type;
@@ -27,6 +43,11 @@ public:
     virtual std::string toString() const = 0;
     virtual double evaluate(double x) const = 0;
     virtual double evaluate(double x, double y) const = 0;
+    
+    // Appends the printed form to an existing buffer instead of building a new string
+    void appendTo(std::string& out, size_t maxLength = std::string::npos) const {
+        ast_traversal::print(this, out, maxLength);
+    }
 };
 
 class NumberNode : public ASTNode {
@@ -96,33 +117,11 @@ public:
         type = NodeType::BINARY_OP;
     }
     
-    std::unique_ptr<ASTNode> clone() const override {
-        return std::make_unique<BinaryOpNode>(op, left->clone(), right->clone());
+    ~BinaryOpNode() override {
+        ast_traversal::releaseSubtrees(left, &right);
     }
     
-    std::string toString() const override {
-        std::string opStr;
-        switch (op) {
-            case BinaryOp::ADD: opStr = " + "; break;
-            case BinaryOp::SUB: opStr = " - "; break;
-            case BinaryOp::MUL: opStr = " ⋅ "; break;
-            case BinaryOp::DIV: opStr = " / "; break;
-            case BinaryOp::POW: opStr = "^"; break;
-        }
-        
-        bool needParensLeft = (left->type == NodeType::BINARY_OP);
-        bool needParensRight = (right->type == NodeType::BINARY_OP);
-        
-        std::string leftStr = needParensLeft ? "(" + left->toString() + ")" : left->toString();
-        std::string rightStr = needParensRight ? "(" + right->toString() + ")" : right->toString();
-        
-        return leftStr + opStr + rightStr;
-    }
-    
-    double evaluate(double x) const override {
-        double l = left->evaluate(x);
-        double r = right->evaluate(x);
-        
+    static double apply(BinaryOp op, double l, double r) {
         switch (op) {
             case BinaryOp::ADD: return l + r;
             case BinaryOp::SUB: return l - r;
@@ -133,18 +132,33 @@ public:
         return 0;
     }
     
-    double evaluate(double x, double y) const override {
-        double l = left->evaluate(x, y);
-        double r = right->evaluate(x, y);
-        
+    static const char* symbol(BinaryOp op) {
         switch (op) {
-            case BinaryOp::ADD: return l + r;
-            case BinaryOp::SUB: return l - r;
-            case BinaryOp::MUL: return l * r;
-            case BinaryOp::DIV: return l / r;
-            case BinaryOp::POW: return std::pow(l, r);
+            case BinaryOp::ADD: return " + ";
+            case BinaryOp::SUB: return " - ";
+            case BinaryOp::MUL: return " ⋅ ";
+            case BinaryOp::DIV: return " / ";
+            case BinaryOp::POW: return "^";
         }
-        return 0;
+        return "";
+    }
+    
+    std::unique_ptr<ASTNode> clone() const override {
+        return ast_traversal::clone(this);
+    }
+    
+    std::string toString() const override {
+        std::string out;
+        ast_traversal::print(this, out);
+        return out;
+    }
+    
+    double evaluate(double x) const override {
+        return ast_traversal::evaluate(this, x, 0.0, false);
+    }
+    
+    double evaluate(double x, double y) const override {
+        return ast_traversal::evaluate(this, x, y, true);
     }
 };
 
@@ -158,26 +172,11 @@ public:
         type = NodeType::UNARY_FUNC;
     }
     
-    std::unique_ptr<ASTNode> clone() const override {
-        return std::make_unique<UnaryFuncNode>(func, arg->clone());
-    }
-    
-    std::string toString() const override {
-        std::string funcStr;
-        switch (func) {
-            case UnaryFunc::SIN: funcStr = "sin"; break;
-            case UnaryFunc::COS: funcStr = "cos"; break;
-            case UnaryFunc::TAN: funcStr = "tan"; break;
-            case UnaryFunc::EXP: funcStr = "exp"; break;
-            case UnaryFunc::LN: funcStr = "ln"; break;
-            case UnaryFunc::SQRT: funcStr = "√"; break;
-        }
-        return funcStr + "(" + arg->toString() + ")";
+    ~UnaryFuncNode() override {
+        ast_traversal::releaseSubtrees(arg, nullptr);
     }
     
-    double evaluate(double x) const override {
-        double a = arg->evaluate(x);
-        
+    static double apply(UnaryFunc func, double a) {
         switch (func) {
             case UnaryFunc::SIN: return std::sin(a);
             case UnaryFunc::COS: return std::cos(a);
@@ -189,18 +188,34 @@ public:
         return 0;
     }
     
-    double evaluate(double x, double y) const override {
-        double a = arg->evaluate(x, y);
-        
+    static const char* name(UnaryFunc func) {
         switch (func) {
-            case UnaryFunc::SIN: return std::sin(a);
-            case UnaryFunc::COS: return std::cos(a);
-            case UnaryFunc::TAN: return std::tan(a);
-            case UnaryFunc::EXP: return std::exp(a);
-            case UnaryFunc::LN: return std::log(a);
-            case UnaryFunc::SQRT: return std::sqrt(a);
+            case UnaryFunc::SIN: return "sin";
+            case UnaryFunc::COS: return "cos";
+            case UnaryFunc::TAN: return "tan";
+            case UnaryFunc::EXP: return "exp";
+            case UnaryFunc::LN: return "ln";
+            case UnaryFunc::SQRT: return "√";
         }
-        return 0;
+        return "";
+    }
+    
+    std::unique_ptr<ASTNode> clone() const override {
+        return ast_traversal::clone(this);
+    }
+    
+    std::string toString() const override {
+        std::string out;
+        ast_traversal::print(this, out);
+        return out;
+    }
+    
+    double evaluate(double x) const override {
+        return ast_traversal::evaluate(this, x, 0.0, false);
+    }
+    
+    double evaluate(double x, double y) const override {
+        return ast_traversal::evaluate(this, x, y, true);
     }
 };
 
@@ -0,0 +1,377 @@
+#include "column_loader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot read size of file: " + path);
+    }
+    fileHandle = file;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) return;  // Empty files cannot be mapped
+    
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    mappingHandle = mapping;
+    
+    base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!base) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (base) UnmapViewOfFile(base);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+}
+#else
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot read size of file: " + path);
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        close(fd);
+        return;  // Empty files cannot be mapped
+    }
+    
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps its own reference to the file
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    madvise(mapped, length, MADV_SEQUENTIAL);
+    base = static_cast<const char*>(mapped);
+}
+
+MappedFile::~MappedFile() {
+    if (base) munmap(const_cast<char*>(base), length);
+}
+#endif
+
+static const size_t kParseGrain = size_t(1) << 20;  // Bytes of text per chunk, at least
+
+static const char* lineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', end - p);
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+static bool isBlankLine(const char* p, const char* end) {
+    for (; p < end; p++) {
+        if (*p != ' ' && *p != '\t' && *p != '\r') return false;
+    }
+    return true;
+}
+
+// Parses one field starting at p; returns the position of the delimiter or the line end
+static const char* parseField(const char* p, const char* end, char delimiter, double& value) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    if (p < end && *p == '"') p++;
+    if (p < end && *p == '+') p++;  // from_chars rejects a leading '+'
+    
+    auto parsed = std::from_chars(p, end, value);
+    if (parsed.ec != std::errc() || parsed.ptr == p) {
+        value = std::numeric_limits<double>::quiet_NaN();
+    }
+    
+    const void* next = std::memchr(p, delimiter, end - p);
+    return next ? static_cast<const char*>(next) : end;
+}
+
+static std::string trimField(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '"')) p++;
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '"')) end--;
+    return std::string(p, end);
+}
+
+struct CsvLayout {
+    const char* body;               // First data line
+    const char* end;
+    std::vector<std::string> header;
+};
+
+// Reads the first non-blank line to find the column count and whether it is a header
+static CsvLayout inspectCsv(const char* data, size_t size, char delimiter) {
+    CsvLayout layout{data, data + size, {}};
+    const char* p = data;
+    while (p < layout.end) {
+        const char* eol = lineEnd(p, layout.end);
+        if (isBlankLine(p, eol)) {
+            p = eol + (eol < layout.end ? 1 : 0);
+            continue;
+        }
+        
+        bool numeric = true;
+        const char* field = p;
+        while (true) {
+            const char* fieldEnd = static_cast<const char*>(std::memchr(field, delimiter, eol - field));
+            if (!fieldEnd) fieldEnd = eol;
+            
+            std::string name = trimField(field, fieldEnd);
+            double value;
+            auto parsed = std::from_chars(name.data(), name.data() + name.size(), value);
+            if (name.empty() || parsed.ec != std::errc()) {
+                numeric = false;
+            }
+            layout.header.push_back(name);
+            
+            if (fieldEnd == eol) break;
+            field = fieldEnd + 1;
+        }
+        
+        if (numeric) {
+            // No header: name the columns by position
+            for (size_t i = 0; i < layout.header.size(); i++) {
+                layout.header[i] = "column " + std::to_string(i + 1);
+            }
+            layout.body = p;
+        } else {
+            layout.body = eol + (eol < layout.end ? 1 : 0);
+        }
+        break;
+    }
+    return layout;
+}
+
+// Chunk boundaries moved forward to the next line start so no line is split
+static std::vector<const char*> splitAtLines(const char* begin, const char* end, size_t chunks) {
+    std::vector<const char*> bounds(chunks + 1, end);
+    bounds[0] = begin;
+    size_t step = static_cast<size_t>(end - begin) / chunks;
+    for (size_t c = 1; c < chunks; c++) {
+        const char* p = std::max(bounds[c - 1], begin + c * step);
+        if (p > begin && p < end && p[-1] != '\n') {
+            p = lineEnd(p, end);
+            if (p < end) p++;
+        }
+        bounds[c] = p;
+    }
+    return bounds;
+}
+
+// Calls fn(fields) for every non-blank line in [begin, end); missing trailing fields are NaN
+template <typename RowFn>
+static void forEachRow(const char* begin, const char* end, char delimiter, size_t fieldCount, RowFn fn) {
+    std::vector<double> row(fieldCount);
+    const char* p = begin;
+    while (p < end) {
+        const char* eol = lineEnd(p, end);
+        if (!isBlankLine(p, eol)) {
+            const char* field = p;
+            for (size_t i = 0; i < fieldCount; i++) {
+                if (field > eol) {
+                    row[i] = std::numeric_limits<double>::quiet_NaN();
+                    continue;
+                }
+                field = parseField(field, eol, delimiter, row[i]) + 1;
+            }
+            fn(row.data());
+        }
+        p = (eol < end) ? eol + 1 : end;
+    }
+}
+
+static size_t countRows(const char* begin, const char* end) {
+    size_t rows = 0;
+    const char* p = begin;
+    while (p < end) {
+        const char* eol = lineEnd(p, end);
+        if (!isBlankLine(p, eol)) rows++;
+        p = (eol < end) ? eol + 1 : end;
+    }
+    return rows;
+}
+
+// Field delimiter of a text file by extension, or 0 for a raw float64 column
+static char textDelimiter(const std::string& path) {
+    std::string extension;
+    size_t dot = path.find_last_of('.');
+    if (dot != std::string::npos) {
+        extension = path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    }
+    
+    if (extension == "csv" || extension == "txt") return ',';
+    if (extension == "tsv") return '\t';
+    return 0;
+}
+
+static std::string fileName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+void ColumnLoader::load(const std::string& path, const std::vector<std::string>& selected) {
+    char delimiter = textDelimiter(path);
+    if (delimiter) {
+        loadCsv(path, delimiter, selected);
+    } else {
+        addBinaryColumn(path);
+    }
+}
+
+std::vector<std::string> ColumnLoader::columnNames(const std::string& path) {
+    char delimiter = textDelimiter(path);
+    if (!delimiter) {
+        return {fileName(path)};
+    }
+    MappedFile text(path);
+    return inspectCsv(text.data(), text.size(), delimiter).header;
+}
+
+void ColumnLoader::addBinaryColumn(const std::string& path, const std::string& name) {
+    auto mapping = std::make_unique<MappedFile>(path);
+    if (mapping->size() % sizeof(double) != 0) {
+        throw std::runtime_error("Binary column size is not a multiple of 8 bytes: " + path);
+    }
+    
+    std::string columnName = name.empty() ? fileName(path) : name;
+    
+    // Page-aligned mapping, so the bytes can be viewed as doubles in place
+    columns.emplace_back(reinterpret_cast<const double*>(mapping->data()), mapping->size() / sizeof(double));
+    names.push_back(columnName);
+    mappings.push_back(std::move(mapping));
+}
+
+void ColumnLoader::loadCsv(const std::string& path, char delimiter, const std::vector<std::string>& selected) {
+    MappedFile text(path);
+    CsvLayout layout = inspectCsv(text.data(), text.size(), delimiter);
+    if (layout.header.empty()) {
+        throw std::runtime_error("No data in file: " + path);
+    }
+    
+    // Field index of each column to keep; rows are parsed only up to the last one
+    std::vector<size_t> fields;
+    if (selected.empty()) {
+        for (size_t i = 0; i < layout.header.size(); i++) fields.push_back(i);
+    }
+    for (const std::string& name : selected) {
+        auto found = std::find(layout.header.begin(), layout.header.end(), name);
+        if (found == layout.header.end()) {
+            throw std::out_of_range("No column named '" + name + "'");
+        }
+        fields.push_back(static_cast<size_t>(found - layout.header.begin()));
+    }
+    const size_t fieldCount = *std::max_element(fields.begin(), fields.end()) + 1;
+    
+    // Pass 1 counts rows per chunk so pass 2 can write every value straight
+    // into its final slot, without per-thread buffers to concatenate
+    size_t chunks = parallelChunkCount(layout.end - layout.body, kParseGrain);
+    std::vector<const char*> bounds = splitAtLines(layout.body, layout.end, chunks);
+    std::vector<size_t> firstRow(chunks + 1, 0);
+    
+    parallelChunks(chunks, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            firstRow[c + 1] = countRows(bounds[c], bounds[c + 1]);
+        }
+    });
+    for (size_t c = 0; c < chunks; c++) {
+        firstRow[c + 1] += firstRow[c];
+    }
+    
+    std::vector<std::unique_ptr<std::vector<double>>> parsed;
+    for (size_t i = 0; i < fields.size(); i++) {
+        parsed.push_back(std::make_unique<std::vector<double>>(firstRow[chunks]));
+    }
+    
+    parallelChunks(chunks, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            size_t row = firstRow[c];
+            forEachRow(bounds[c], bounds[c + 1], delimiter, fieldCount, [&](const double* values) {
+                for (size_t i = 0; i < fields.size(); i++) {
+                    (*parsed[i])[row] = values[fields[i]];
+                }
+                row++;
+            });
+        }
+    });
+    
+    for (size_t i = 0; i < fields.size(); i++) {
+        columns.emplace_back(*parsed[i]);
+        names.push_back(layout.header[fields[i]]);
+        parsedColumns.push_back(std::move(parsed[i]));
+    }
+}
+
+StreamingStatistics ColumnLoader::summarizeCsvColumn(const std::string& path, size_t column, char delimiter) {
+    MappedFile text(path);
+    CsvLayout layout = inspectCsv(text.data(), text.size(), delimiter);
+    const size_t fieldCount = layout.header.size();
+    if (column >= fieldCount) {
+        throw std::out_of_range("Column " + std::to_string(column) + " not in file: " + path);
+    }
+    
+    size_t chunks = parallelChunkCount(layout.end - layout.body, kParseGrain);
+    std::vector<const char*> bounds = splitAtLines(layout.body, layout.end, chunks);
+    std::vector<StreamingStatistics> partials(chunks);
+    
+    parallelChunks(chunks, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            forEachRow(bounds[c], bounds[c + 1], delimiter, column + 1, [&](const double* fields) {
+                if (fields[column] == fields[column]) {  // Skip NaN (missing values)
+                    partials[c].add(fields[column]);
+                }
+            });
+        }
+    });
+    
+    StreamingStatistics result = partials[0];
+    for (size_t c = 1; c < chunks; c++) {
+        result.merge(partials[c]);
+    }
+    return result;
+}
+
+DoubleSpan ColumnLoader::column(const std::string& name) const {
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name) return columns[i];
+    }
+    throw std::out_of_range("No column named '" + name + "'");
+}
+
+void ColumnLoader::clear() {
+    columns.clear();
+    names.clear();
+    parsedColumns.clear();
+    mappings.clear();
+}
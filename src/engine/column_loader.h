@@ -0,0 +1,72 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "double_span.h"
+#include "streaming_statistics.h"
+
+// Read-only mapping of a whole file (mmap on POSIX, MapViewOfFile on
+// Windows). Pages are loaded by the OS on demand, so a file larger than
+// memory can still be scanned. Throws std::runtime_error if the file cannot
+// be opened or mapped.
+class MappedFile {
+private:
+    const char* base = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+};
+
+// Named numeric columns loaded from disk for the statistics and regression
+// routines.
+//  - Raw binary columns (native-endian float64) are zero-copy: the column
+//    span points into the mapping, which stays open while the loader lives.
+//  - CSV files are mapped, split at line boundaries and parsed in parallel
+//    with std::from_chars straight into one array per column; the text
+//    mapping is released afterwards.
+class ColumnLoader {
+private:
+    std::vector<std::unique_ptr<MappedFile>> mappings;
+    std::vector<std::unique_ptr<std::vector<double>>> parsedColumns;
+    std::vector<std::string> names;
+    std::vector<DoubleSpan> columns;
+
+public:
+    // Picks the format by extension: .csv/.tsv/.txt are text, anything else
+    // raw float64. 'selected' limits a text file to the named columns.
+    void load(const std::string& path, const std::vector<std::string>& selected = {});
+    
+    void addBinaryColumn(const std::string& path, const std::string& name = "");
+    
+    // The first line is a header when any of its fields is not a number.
+    // Missing or non-numeric fields become NaN. Only the columns named in
+    // 'selected' are materialized (all of them when it is empty); throws
+    // std::out_of_range for a name that is not in the file.
+    void loadCsv(const std::string& path, char delimiter = ',', const std::vector<std::string>& selected = {});
+    
+    // Names of the columns in a file, from its first line, without loading it
+    static std::vector<std::string> columnNames(const std::string& path);
+    
+    // Single-column summary of a CSV file in constant memory: chunks are
+    // parsed in parallel into per-thread accumulators that are then merged,
+    // and no column array is materialized.
+    static StreamingStatistics summarizeCsvColumn(const std::string& path, size_t column, char delimiter = ',');
+    
+    size_t columnCount() const { return columns.size(); }
+    const std::string& columnName(size_t index) const { return names.at(index); }
+    DoubleSpan column(size_t index) const { return columns.at(index); }
+    DoubleSpan column(const std::string& name) const;
+    void clear();
+};
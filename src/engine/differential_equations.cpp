@@ -1,5 +1,27 @@
 #include "differential_equations.h"
+#include "expression_program.h"
+#include "job_system.h"
+#include "parallel.h"
+#include "parser.h"
+#include "step_format.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+// Components per row of the table of numerical values
+static const size_t kTableComponents = 6;
+
+static std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+}
 
 DEType DifferentialEquationSolver::classifyEquation(const std::string& equation) {
     // Simple classification based on form
@@ -114,6 +136,464 @@ std::string DifferentialEquationSolver::solveExact(const std::string& equation)
     return "F(x,y) = C";
 }
 
+void DifferentialEquationSolver::addIntegrationSteps(OdeMethod method, const OdeOptions& options,
+                                                     const OdeStats& stats) {
+    DifferentialEquationStep methodStep;
+    methodStep.description = std::string("Method: ") + odeMethodName(method) + " with adaptive step size";
+    methodStep.expression = "Tolerance: relative " + formatNumber(options.relativeTolerance) +
+                            ", absolute " + formatNumber(options.absoluteTolerance);
+    steps.push_back(methodStep);
+    
+    DifferentialEquationStep statsStep;
+    statsStep.description = "Work:";
+    statsStep.expression = std::to_string(stats.acceptedSteps) + " steps accepted, " +
+                           std::to_string(stats.rejectedSteps) + " rejected, " +
+                           std::to_string(stats.rhsEvaluations) + " right-hand side evaluations";
+    if (stats.jacobianEvaluations > 0) {
+        statsStep.expression += ", " + std::to_string(stats.jacobianEvaluations) + " Jacobians";
+    }
+    steps.push_back(statsStep);
+}
+
+std::vector<double> DifferentialEquationSolver::solveInitialValueProblem(const std::string& rhs, double x0, double y0,
+                                                                      double xEnd, size_t points, OdeMethod method) {
+    if (points < 2) {
+        throw std::invalid_argument("At least two output points are needed");
+    }
+    Parser parser;
+    std::unique_ptr<ASTNode> ast = parser.parse(rhs);
+    const ASTNode* f = ast.get();
+    
+    OdeSystem system;
+    system.rhs = [f](double t, const double* y, double* dydt) {
+        dydt[0] = f->evaluate(t, y[0]);
+    };
+    OdeOptions options;
+    options.method = method;
+    options.relativeTolerance = 1e-8;
+    options.absoluteTolerance = 1e-10;
+    
+    OdeIntegrator integrator(system, options);
+    std::vector<double> xs, ys;
+    const OdeStats& stats = integrator.solve(x0, std::vector<double>{y0}, xEnd, points, xs, ys);
+    
+    DifferentialEquationStep header;
+    header.description = "--- Numerical Solution ---";
+    header.expression = "dy/dx = " + rhs + ",  y(" + formatNumber(x0) + ") = " + formatNumber(y0);
+    steps.push_back(header);
+    
+    addIntegrationSteps(method, options, stats);
+    
+    DifferentialEquationStep tableStep;
+    tableStep.description = "Values:";
+    tableStep.expression = valueTable(points, [&](size_t i) {
+        return "y(" + formatNumber(xs[i]) + ") = " + formatNumber(ys[i]);
+    });
+    steps.push_back(tableStep);
+    
+    return ys;
+}
+
+// Handles "dy/dx = f(x,y), y(x0) = y0[, x = x1][, stiff]": adds the numerical
+// solution to the steps and sets result to y(x1). False without an initial condition.
+bool DifferentialEquationSolver::solveWithInitialCondition(const std::string& equation, std::string& result) {
+    std::vector<std::string> parts;
+    std::stringstream stream(equation);
+    std::string part;
+    while (std::getline(stream, part, ',')) {
+        parts.push_back(trim(part));
+    }
+    if (parts.size() < 2) return false;
+    
+    bool hasCondition = false, hasEnd = false;
+    double x0 = 0.0, y0 = 0.0, xEnd = 0.0;
+    OdeMethod method = OdeMethod::DormandPrince45;
+    for (size_t i = 1; i < parts.size(); i++) {
+        const std::string& condition = parts[i];
+        size_t equals = condition.find('=');
+        if (condition == "stiff") {
+            method = OdeMethod::Rosenbrock23;
+        } else if (condition.compare(0, 2, "y(") == 0 && equals != std::string::npos) {
+            size_t close = condition.find(')');
+            if (close == std::string::npos || close > equals) {
+                throw std::invalid_argument("Initial condition must look like y(x0) = y0");
+            }
+            x0 = std::stod(condition.substr(2, close - 2));
+            y0 = std::stod(condition.substr(equals + 1));
+            hasCondition = true;
+        } else if (condition[0] == 'x' && equals != std::string::npos) {
+            xEnd = std::stod(condition.substr(equals + 1));
+            hasEnd = true;
+        } else {
+            throw std::invalid_argument("Unrecognised condition: " + condition);
+        }
+    }
+    if (!hasCondition) return false;
+    if (!hasEnd) xEnd = x0 + 1.0;
+    
+    size_t equals = parts[0].find('=');
+    if (equals == std::string::npos) {
+        throw std::invalid_argument("Expected dy/dx = f(x,y)");
+    }
+    std::string rhs = trim(parts[0].substr(equals + 1));
+    std::vector<double> values = solveInitialValueProblem(rhs, x0, y0, xEnd, 101, method);
+    result = "y(" + formatNumber(xEnd) + ") ≈ " + formatNumber(values.back());
+    return true;
+}
+
+static std::shared_ptr<const ExpressionProgram> compileProgram(const std::vector<std::string>& names,
+                                                               const std::vector<std::string>& expressions,
+                                                               const std::string& independent,
+                                                               const std::vector<std::string>& parameters = {}) {
+    if (names.empty() || names.size() != expressions.size()) {
+        throw std::invalid_argument("A system needs one expression per component");
+    }
+    std::vector<std::string> variables{independent};
+    for (const std::string& name : names) {
+        if (std::find(variables.begin(), variables.end(), name) != variables.end()) {
+            throw std::invalid_argument("Component names must be distinct from each other and from " + independent);
+        }
+        variables.push_back(name);
+    }
+    for (const std::string& parameter : parameters) {
+        if (std::find(variables.begin(), variables.end(), parameter) != variables.end()) {
+            throw std::invalid_argument("Parameter " + parameter + " clashes with another name");
+        }
+        variables.push_back(parameter);
+    }
+    
+    Parser parser;
+    std::vector<std::unique_ptr<ASTNode>> trees;
+    std::vector<const ASTNode*> roots;
+    for (const std::string& expression : expressions) {
+        trees.push_back(parser.parse(expression));
+        roots.push_back(trees.back().get());
+    }
+    return std::make_shared<const ExpressionProgram>(roots, variables);
+}
+
+// Program inputs are [t, y_1, ..., y_n, p_1, ..., p_k], the parameters read
+// from 'parameters' on every call. Each callback owns its buffers, so each
+// copy of the system (one per integrator) evaluates without allocating.
+static OdeSystem makeSystem(std::shared_ptr<const ExpressionProgram> program,
+                            const double* parameters = nullptr) {
+    const size_t n = program->outputCount();
+    const size_t m = program->inputCount();
+    OdeSystem system;
+    system.dimension = n;
+    system.rhs = [program, n, m, parameters, inputs = std::vector<double>(m), registers = std::vector<double>()]
+                 (double t, const double* y, double* dydt) mutable {
+        inputs[0] = t;
+        std::copy(y, y + n, inputs.begin() + 1);
+        std::copy(parameters, parameters + (m - n - 1), inputs.begin() + n + 1);
+        program->evaluate(inputs.data(), dydt, registers);
+    };
+    system.jacobian = [program, n, m, parameters, inputs = std::vector<double>(m), values = std::vector<double>(n),
+                       full = std::vector<double>(n * m), registers = std::vector<double>(),
+                       gradients = std::vector<double>()]
+                      (double t, const double* y, double* jacobian) mutable {
+        inputs[0] = t;
+        std::copy(y, y + n, inputs.begin() + 1);
+        std::copy(parameters, parameters + (m - n - 1), inputs.begin() + n + 1);
+        program->evaluateWithJacobian(inputs.data(), values.data(), full.data(), registers, gradients);
+        for (size_t i = 0; i < n; i++) {
+            std::copy(full.begin() + i * m + 1, full.begin() + i * m + n + 1, jacobian + i * n);
+        }
+    };
+    return system;
+}
+
+OdeSystem DifferentialEquationSolver::compileSystem(const std::vector<std::string>& names,
+                                                    const std::vector<std::string>& expressions,
+                                                    const std::string& independent) {
+    return makeSystem(compileProgram(names, expressions, independent));
+}
+
+OdeSystemSolution DifferentialEquationSolver::solveSystem(const std::vector<std::string>& names,
+                                                          const std::vector<std::string>& expressions,
+                                                          double t0, const std::vector<double>& y0, double tEnd,
+                                                          size_t points, OdeMethod method,
+                                                          const std::string& independent) {
+    if (points < 2) {
+        throw std::invalid_argument("At least two output points are needed");
+    }
+    std::shared_ptr<const ExpressionProgram> program = compileProgram(names, expressions, independent);
+    
+    OdeOptions options;
+    options.method = method;
+    options.relativeTolerance = 1e-8;
+    options.absoluteTolerance = 1e-10;
+    OdeIntegrator integrator(makeSystem(program), options);
+    
+    OdeSystemSolution solution;
+    solution.names = names;
+    solution.stats = integrator.solve(t0, y0, tEnd, points, solution.times, solution.states);
+    
+    DifferentialEquationStep header;
+    header.description = "--- Numerical Solution: system of " + std::to_string(names.size()) + " equations ---";
+    for (size_t i = 0; i < names.size(); i++) {
+        if (i > 0) header.expression += "\n";
+        header.expression += names[i] + "' = " + expressions[i] + ",  " + names[i] + "(" + formatNumber(t0) +
+                             ") = " + formatNumber(y0[i]);
+    }
+    steps.push_back(header);
+    
+    DifferentialEquationStep programStep;
+    programStep.description = "Compiled right-hand side:";
+    programStep.expression = std::to_string(program->instructionCount()) + " operations per evaluation, " +
+                             std::to_string(program->sharedSubexpressions()) + " repeated subexpressions shared";
+    if (method == OdeMethod::Rosenbrock23) {
+        programStep.expression += "\nJacobian by forward-mode automatic differentiation";
+    }
+    steps.push_back(programStep);
+    
+    addIntegrationSteps(method, options, solution.stats);
+    
+    DifferentialEquationStep tableStep;
+    tableStep.description = "Values:";
+    size_t shown = std::min(names.size(), kTableComponents);
+    tableStep.expression = valueTable(points, [&](size_t i) {
+        std::string row = independent + " = " + formatNumber(solution.times[i]) + ":";
+        for (size_t c = 0; c < shown; c++) {
+            row += (c == 0 ? "  " : ", ") + names[c] + " = " + formatNumber(solution.value(i, c));
+        }
+        if (shown < names.size()) row += ", …";
+        return row;
+    });
+    steps.push_back(tableStep);
+    
+    return solution;
+}
+
+static void addStats(OdeStats& total, const OdeStats& run) {
+    total.acceptedSteps += run.acceptedSteps;
+    total.rejectedSteps += run.rejectedSteps;
+    total.rhsEvaluations += run.rhsEvaluations;
+    total.jacobianEvaluations += run.jacobianEvaluations;
+    total.factorizations += run.factorizations;
+}
+
+OdeEnsembleResult DifferentialEquationSolver::solveEnsemble(const OdeEnsembleSpec& spec, size_t runs,
+                                                            const OdeEnsembleSetup& setup) {
+    if (spec.samples < 2) {
+        throw std::invalid_argument("At least two sample times are needed");
+    }
+    std::shared_ptr<const ExpressionProgram> program =
+        compileProgram(spec.names, spec.expressions, spec.independent, spec.parameters);
+    const size_t n = spec.names.size();
+    const size_t samples = spec.samples;
+    
+    OdeEnsembleResult result;
+    result.runs = runs;
+    result.components = n;
+    result.finalStates.assign(runs * n, NAN);
+    result.maxima.assign(runs * n, NAN);
+    result.minima.assign(runs * n, NAN);
+    
+    std::vector<double> times(samples);
+    for (size_t j = 0; j < samples; j++) {
+        times[j] = spec.t0 + (spec.tEnd - spec.t0) * static_cast<double>(j) / (samples - 1);
+    }
+    
+    // Per-thread state; the system copy inside each integrator reads that
+    // thread's parameter buffer
+    struct Worker {
+        std::vector<double> parameters;
+        std::vector<double> initial;
+        std::vector<double> trajectory;
+        std::unique_ptr<OdeIntegrator> integrator;
+        OdeStats totals;
+        size_t failed = 0;
+    };
+    const size_t threadCount = parallelChunkCount(runs, 1);
+    std::vector<Worker> workers(threadCount);
+    for (Worker& worker : workers) {
+        worker.parameters.assign(spec.parameters.size(), 0.0);
+        worker.initial.assign(n, 0.0);
+        worker.trajectory.assign(samples * n, 0.0);
+        worker.integrator = std::make_unique<OdeIntegrator>(makeSystem(program, worker.parameters.data()), spec.options);
+    }
+    
+    JobContext* job = JobContext::current();
+    std::atomic<size_t> completed{0};
+    size_t grain = std::max<size_t>(1, runs / (threadCount * 32));
+    auto start = std::chrono::steady_clock::now();
+    
+    // Failed runs count as done too, and whichever worker finishes the last
+    // run reports it, so progress reaches 1
+    auto advance = [&](size_t w) {
+        size_t done = completed.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (job && (w == 0 || done == runs)) {
+            job->setProgress(static_cast<float>(done) / runs);
+        }
+    };
+    
+    parallelDynamic(runs, threadCount, grain, [&](size_t w, size_t run) {
+        if (job && job->isCancelled()) {
+            throw JobCancelled();
+        }
+        Worker& worker = workers[w];
+        setup(run, worker.initial.data(), worker.parameters.data());
+        try {
+            addStats(worker.totals, worker.integrator->solve(spec.t0, worker.initial.data(), times.data(),
+                                                             samples, worker.trajectory.data()));
+        } catch (const JobCancelled&) {
+            throw;
+        } catch (const std::runtime_error&) {
+            worker.failed++;
+            advance(w);
+            return;
+        }
+        
+        const double* trajectory = worker.trajectory.data();
+        double* highest = result.maxima.data() + run * n;
+        double* lowest = result.minima.data() + run * n;
+        std::copy(trajectory, trajectory + n, highest);
+        std::copy(trajectory, trajectory + n, lowest);
+        for (size_t j = 1; j < samples; j++) {
+            const double* state = trajectory + j * n;
+            for (size_t c = 0; c < n; c++) {
+                highest[c] = std::max(highest[c], state[c]);
+                lowest[c] = std::min(lowest[c], state[c]);
+            }
+        }
+        std::copy(trajectory + (samples - 1) * n, trajectory + samples * n, result.finalStates.begin() + run * n);
+        advance(w);
+    });
+    
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.threads = threadCount;
+    for (const Worker& worker : workers) {
+        addStats(result.totals, worker.totals);
+        result.failedRuns += worker.failed;
+    }
+    
+    // Aggregates in run order, so they do not depend on the thread schedule
+    result.finalStatistics.assign(n, RunningStatistics());
+    for (size_t run = 0; run < runs; run++) {
+        if (std::isnan(result.finalStates[run * n])) continue;
+        for (size_t c = 0; c < n; c++) {
+            result.finalStatistics[c].add(result.finalStates[run * n + c]);
+        }
+    }
+    
+    DifferentialEquationStep header;
+    header.description = "--- Ensemble: " + std::to_string(runs) + " runs of " + std::to_string(n) + " equations ---";
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0) header.expression += "\n";
+        header.expression += spec.names[i] + "' = " + spec.expressions[i];
+    }
+    steps.push_back(header);
+    
+    addIntegrationSteps(spec.options.method, spec.options, result.totals);
+    
+    DifferentialEquationStep threadStep;
+    threadStep.description = "Threads:";
+    threadStep.expression = std::to_string(threadCount) + " threads, " + formatNumber(result.seconds) + " s (" +
+                            formatNumber(result.seconds > 0.0 ? runs / result.seconds : 0.0) + " runs/s), " +
+                            std::to_string(result.failedRuns) + " runs failed";
+    steps.push_back(threadStep);
+    
+    DifferentialEquationStep finalStep;
+    finalStep.description = "Final state at " + spec.independent + " = " + formatNumber(spec.tEnd) + " across runs:";
+    for (size_t c = 0; c < std::min(n, kTableComponents); c++) {
+        const RunningStatistics& stats = result.finalStatistics[c];
+        if (c > 0) finalStep.expression += "\n";
+        finalStep.expression += spec.names[c] + ": mean " + formatNumber(stats.mean()) + ", sd " +
+                                formatNumber(stats.count() > 1 ? stats.standardDeviation() : 0.0) + ", range [" +
+                                formatNumber(stats.min()) + ", " + formatNumber(stats.max()) + "]";
+    }
+    steps.push_back(finalStep);
+    
+    return result;
+}
+
+// Several equations, or one not written dy/dx (x' = ..., dx/dt = ...)
+static bool isSystemForm(const std::string& equation) {
+    if (equation.find(';') != std::string::npos) return true;
+    std::string lhs = trim(equation.substr(0, equation.find('=')));
+    return lhs.find('\'') != std::string::npos ||
+           (lhs.size() > 1 && lhs[0] == 'd' && lhs.find("/d") != std::string::npos && lhs != "dy/dx");
+}
+
+// Handles "x' = v; v' = -x, x(0) = 1, v(0) = 0[, t = 10][, stiff]". Equations
+// may also be written dx/dt = ...; the denominator names the independent variable.
+std::string DifferentialEquationSolver::solveSystemEquation(const std::string& equation) {
+    size_t comma = equation.find(',');
+    std::vector<std::string> names, expressions;
+    std::string independent = "t";
+    std::stringstream definitions(equation.substr(0, comma));
+    std::string definition;
+    while (std::getline(definitions, definition, ';')) {
+        definition = trim(definition);
+        if (definition.empty()) continue;
+        size_t equals = definition.find('=');
+        if (equals == std::string::npos) {
+            throw std::invalid_argument("Expected name' = expression in: " + definition);
+        }
+        std::string lhs = trim(definition.substr(0, equals));
+        size_t slash = lhs.find("/d");
+        if (!lhs.empty() && lhs.back() == '\'') {
+            names.push_back(trim(lhs.substr(0, lhs.size() - 1)));
+        } else if (lhs.size() > 1 && lhs[0] == 'd' && slash != std::string::npos) {
+            names.push_back(lhs.substr(1, slash - 1));
+            independent = lhs.substr(slash + 2);
+        } else {
+            throw std::invalid_argument("Expected name' = expression in: " + definition);
+        }
+        expressions.push_back(trim(definition.substr(equals + 1)));
+    }
+    
+    std::vector<double> y0(names.size(), 0.0);
+    std::vector<bool> given(names.size(), false);
+    double t0 = 0.0, tEnd = 0.0;
+    bool hasEnd = false, hasStart = false;
+    OdeMethod method = OdeMethod::DormandPrince45;
+    std::stringstream conditions(comma == std::string::npos ? "" : equation.substr(comma + 1));
+    std::string condition;
+    while (std::getline(conditions, condition, ',')) {
+        condition = trim(condition);
+        size_t equals = condition.find('=');
+        size_t open = condition.find('(');
+        if (condition == "stiff") {
+            method = OdeMethod::Rosenbrock23;
+        } else if (equals != std::string::npos && open != std::string::npos && open < equals) {
+            std::string name = trim(condition.substr(0, open));
+            auto found = std::find(names.begin(), names.end(), name);
+            size_t close = condition.find(')');
+            if (found == names.end() || close == std::string::npos || close > equals) {
+                throw std::invalid_argument("Unrecognised initial condition: " + condition);
+            }
+            double start = std::stod(condition.substr(open + 1, close - open - 1));
+            if (hasStart && start != t0) {
+                throw std::invalid_argument("All initial conditions must be given at the same " + independent);
+            }
+            t0 = start;
+            hasStart = true;
+            y0[found - names.begin()] = std::stod(condition.substr(equals + 1));
+            given[found - names.begin()] = true;
+        } else if (equals != std::string::npos && trim(condition.substr(0, equals)) == independent) {
+            tEnd = std::stod(condition.substr(equals + 1));
+            hasEnd = true;
+        } else {
+            throw std::invalid_argument("Unrecognised condition: " + condition);
+        }
+    }
+    for (size_t i = 0; i < names.size(); i++) {
+        if (!given[i]) {
+            throw std::invalid_argument("Missing initial condition for " + names[i]);
+        }
+    }
+    if (!hasEnd) tEnd = t0 + 1.0;
+    
+    OdeSystemSolution solution = solveSystem(names, expressions, t0, y0, tEnd, 101, method, independent);
+    std::string result = "At " + independent + " = " + formatNumber(tEnd) + ":";
+    for (size_t i = 0; i < names.size(); i++) {
+        result += (i == 0 ? "  " : ", ") + names[i] + " ≈ " + formatNumber(solution.value(100, i));
+    }
+    return result;
+}
+
 std::string DifferentialEquationSolver::solveDifferentialEquation(const std::string& equation) {
     steps.clear();
     
@@ -122,12 +602,22 @@ std::string DifferentialEquationSolver::solveDifferentialEquation(const std::str
     step1.expression = "Given: " + equation;
     steps.push_back(step1);
     
+    if (isSystemForm(equation)) {
+        std::string solution = solveSystemEquation(equation);
+        
+        DifferentialEquationStep solutionStep;
+        solutionStep.description = "=== Solution ===";
+        solutionStep.expression = solution;
+        steps.push_back(solutionStep);
+        return solution;
+    }
+    
     DifferentialEquationStep step2;
     step2.description = "--- Classifying Equation ---";
     step2.expression = "";
     steps.push_back(step2);
     
-    DEType type = classifyEquation(equation);
+    DEType type = classifyEquation(equation.substr(0, equation.find(',')));
     std::string result;
     
     switch (type) {
@@ -165,5 +655,14 @@ std::string DifferentialEquationSolver::solveDifferentialEquation(const std::str
     noteStep.expression = "C is an arbitrary constant. Use initial conditions to find particular solution.";
     steps.push_back(noteStep);
     
+    std::string particular;
+    if (solveWithInitialCondition(equation, particular)) {
+        DifferentialEquationStep particularStep;
+        particularStep.description = "=== Particular Solution ===";
+        particularStep.expression = particular;
+        steps.push_back(particularStep);
+        return particular;
+    }
+    
     return result;
 }
@@ -1,12 +1,55 @@
 #pragma once
+#include <functional>
 #include <string>
 #include <vector>
+#include "ode_solver.h"
+#include "streaming_statistics.h"
 
 struct DifferentialEquationStep {
     std::string description;
     std::string expression;
 };
 
+// Trajectory of a first-order system at equally spaced times
+struct OdeSystemSolution {
+    std::vector<std::string> names;
+    std::vector<double> times;
+    std::vector<double> states;     // times.size() × names.size(), row-major
+    OdeStats stats;
+    
+    double value(size_t point, size_t component) const { return states[point * names.size() + component]; }
+};
+
+// The same system integrated for many initial states and/or parameter values
+struct OdeEnsembleSpec {
+    std::vector<std::string> names;
+    std::vector<std::string> expressions;
+    std::vector<std::string> parameters;    // Further names the expressions use, set per run
+    std::string independent = "t";
+    double t0 = 0.0;
+    double tEnd = 1.0;
+    size_t samples = 101;                   // Equally spaced times the extremes are taken over
+    OdeOptions options;
+};
+
+// Fills the initial state and parameter values of one run. Called from
+// several worker threads at once, so it must be safe to call concurrently.
+using OdeEnsembleSetup = std::function<void(size_t run, double* initialState, double* parameters)>;
+
+// Per-run summaries (runs × components, row-major) in place of trajectories
+struct OdeEnsembleResult {
+    size_t runs = 0;
+    size_t components = 0;
+    size_t failedRuns = 0;          // Integration failed; their rows are NaN
+    std::vector<double> finalStates;
+    std::vector<double> maxima;
+    std::vector<double> minima;
+    std::vector<RunningStatistics> finalStatistics;     // Per component, successful runs only
+    OdeStats totals;
+    size_t threads = 0;
+    double seconds = 0.0;
+};
+
 enum class DEType {
     SEPARABLE,
     LINEAR_FIRST_ORDER,
@@ -24,11 +67,47 @@ private:
     std::string solveSeparable(const std::string& equation);
     std::string solveLinearFirstOrder(const std::string& equation);
     std::string solveExact(const std::string& equation);
-    
+    bool solveWithInitialCondition(const std::string& equation, std::string& result);
+    std::string solveSystemEquation(const std::string& equation);
+    void addIntegrationSteps(OdeMethod method, const OdeOptions& options, const OdeStats& stats);
+
 public:
-    // Solve first-order differential equation
+    // Solve first-order differential equation. "dy/dx = f(x,y), y(x0) = y0"
+    // with an optional end point ", x = x1" and ", stiff" is also integrated
+    // numerically, as is a system "x' = v; v' = -x, x(0) = 1, v(0) = 0, t = 10".
     std::string solveDifferentialEquation(const std::string& equation);
     
+    // Integrates dy/dx = rhs (an expression in x and y) from y(x0) = y0 and
+    // returns y at 'points' equally spaced x from x0 to xEnd inclusive.
+    // Records the method, step statistics and a table of values as steps.
+    std::vector<double> solveInitialValueProblem(const std::string& rhs, double x0, double y0, double xEnd,
+                                                 size_t points, OdeMethod method = OdeMethod::DormandPrince45);
+    
+    // Right-hand side of names[i]' = expressions[i], where the expressions
+    // use the component names and the independent variable. All components
+    // are compiled into one ExpressionProgram, so subexpressions they share
+    // are evaluated once per stage, and the Jacobian comes from forward-mode
+    // differentiation of the same program. Throws std::invalid_argument for
+    // mismatched sizes or unknown variables, std::runtime_error for bad syntax.
+    static OdeSystem compileSystem(const std::vector<std::string>& names, const std::vector<std::string>& expressions,
+                                   const std::string& independent = "t");
+    
+    // Integrates the compiled system from y(t0) = y0 and returns the state at
+    // 'points' equally spaced times from t0 to tEnd. Steps summarize the
+    // program and the integration and tabulate at most a few rows, so the
+    // cost per integration step does not depend on the logging.
+    OdeSystemSolution solveSystem(const std::vector<std::string>& names, const std::vector<std::string>& expressions,
+                                  double t0, const std::vector<double>& y0, double tEnd, size_t points,
+                                  OdeMethod method = OdeMethod::DormandPrince45, const std::string& independent = "t");
+    
+    // Integrates spec's system once per run across all hardware threads.
+    // The program is compiled once; each thread keeps its own integrator and
+    // buffers, and threads claim runs from a shared counter so uneven
+    // (e.g. stiff) runs do not leave threads idle. Only the final state and
+    // the extremes at the sample times are kept per run. A run whose
+    // integration fails is counted and skipped; errors from setup propagate.
+    OdeEnsembleResult solveEnsemble(const OdeEnsembleSpec& spec, size_t runs, const OdeEnsembleSetup& setup);
+    
     const std::vector<DifferentialEquationStep>& getSteps() const { return steps; }
     void clearSteps() { steps.clear(); }
 };
@@ -1,76 +1,204 @@
 #include "differentiator.h"
 
+// Step log limits: a 100k-term sum would otherwise produce 100k steps, each
+// holding a printed copy of a large subtree
+static const size_t MAX_LOGGED_STEPS = 250;
+static const size_t MAX_STEP_EXPRESSION_LENGTH = 200;
+
+static std::string preview(const ASTNode* node) {
+    std::string out;
+    node->appendTo(out, MAX_STEP_EXPRESSION_LENGTH);
+    return out;
+}
+
+// "∂/∂x(f <op> g)" printed straight into one buffer
+static std::string binaryRuleExpression(const BinaryOpNode* binOp, const char* opStr) {
+    std::string out = "∂/∂x(";
+    binOp->left->appendTo(out, MAX_STEP_EXPRESSION_LENGTH);
+    out += opStr;
+    binOp->right->appendTo(out, MAX_STEP_EXPRESSION_LENGTH);
+    out += ")";
+    return out;
+}
+
+bool Differentiator::loggingSteps() const {
+    return steps.size() < MAX_LOGGED_STEPS;
+}
+
+void Differentiator::addStep(const char* description, std::string expression) {
+    if (loggingSteps()) {
+        DifferentiationStep step;
+        step.description = description;
+        step.expression = std::move(expression);
+        steps.push_back(std::move(step));
+    } else {
+        omittedSteps++;
+    }
+}
+
 std::unique_ptr<ASTNode> Differentiator::differentiate(const ASTNode* root) {
     steps.clear();
+    omittedSteps = 0;
     
     DifferentiationStep initialStep;
     initialStep.description = "Initial expression";
-    initialStep.expression = "∂/∂x(" + root->toString() + ")";
+    initialStep.expression = "∂/∂x(" + preview(root) + ")";
     steps.push_back(initialStep);
     
     auto result = differentiateNode(root);
     
+    if (omittedSteps > 0) {
+        DifferentiationStep noteStep;
+        noteStep.description = "Note";
+        noteStep.expression = "Remaining " + std::to_string(omittedSteps) + " rule applications omitted for brevity";
+        steps.push_back(noteStep);
+    }
+    
     DifferentiationStep finalStep;
     finalStep.description = "Final derivative";
-    finalStep.expression = "f'(x) = " + result->toString();
+    finalStep.expression = "f'(x) = " + preview(result.get());
     steps.push_back(finalStep);
     
     return result;
 }
 
-std::unique_ptr<ASTNode> Differentiator::differentiateNode(const ASTNode* node) {
-    switch (node->type) {
-        case NodeType::NUMBER: {
-            DifferentiationStep step;
-            step.description = "Constant Rule: ∂/∂x(c) = 0";
-            step.expression = "∂/∂x(" + node->toString() + ") = 0";
-            steps.push_back(step);
-            return std::make_unique<NumberNode>(0);
-        }
+std::unique_ptr<ASTNode> Differentiator::differentiateNode(const ASTNode* root) {
+    // Explicit-stack walk: a node is visited once on the way down (rule step is
+    // logged, children queued) and once on the way up, when the derivatives of
+    // its children are on top of 'results'. Steps come out in the same order as
+    // a recursive descent would produce them.
+    struct Frame {
+        const ASTNode* node;
+        bool childrenDone;
+    };
+    
+    std::vector<Frame> stack;
+    std::vector<std::unique_ptr<ASTNode>> results;
+    stack.push_back({root, false});
+    
+    while (!stack.empty()) {
+        Frame frame = stack.back();
+        stack.pop_back();
+        const ASTNode* node = frame.node;
         
-        case NodeType::VARIABLE: {
-            DifferentiationStep step;
-            step.description = "Power Rule: ∂/∂x(x) = 1";
-            step.expression = "∂/∂x(x) = 1";
-            steps.push_back(step);
-            return std::make_unique<NumberNode>(1);
+        if (!frame.childrenDone) {
+            switch (node->type) {
+                case NodeType::NUMBER:
+                    addStep("Constant Rule: ∂/∂x(c) = 0", "∂/∂x(" + node->toString() + ") = 0");
+                    results.push_back(std::make_unique<NumberNode>(0));
+                    break;
+                
+                case NodeType::VARIABLE:
+                    addStep("Power Rule: ∂/∂x(x) = 1", "∂/∂x(x) = 1");
+                    results.push_back(std::make_unique<NumberNode>(1));
+                    break;
+                
+                case NodeType::BINARY_OP: {
+                    auto binOp = static_cast<const BinaryOpNode*>(node);
+                    
+                    // General case a^b = exp(b * ln(a)) is not handled
+                    if (binOp->op == BinaryOp::POW && binOp->right->type != NodeType::NUMBER) {
+                        results.push_back(std::make_unique<NumberNode>(0));
+                        break;
+                    }
+                    
+                    if (!loggingSteps()) {
+                        omittedSteps++;
+                    } else {
+                        switch (binOp->op) {
+                            case BinaryOp::ADD:
+                                addStep("Sum Rule: ∂/∂x(f + g) = f' + g'",
+                                        binaryRuleExpression(binOp, " + "));
+                                break;
+                            case BinaryOp::SUB:
+                                addStep("Difference Rule: ∂/∂x(f - g) = f' - g'",
+                                        binaryRuleExpression(binOp, " - "));
+                                break;
+                            case BinaryOp::MUL:
+                                addStep("Product Rule: ∂/∂x(f * g) = f' * g + f * g'",
+                                        binaryRuleExpression(binOp, " * "));
+                                break;
+                            case BinaryOp::DIV:
+                                addStep("Quotient Rule: ∂/∂x(f/g) = (f' * g - f * g') / g^2",
+                                        binaryRuleExpression(binOp, " / "));
+                                break;
+                            case BinaryOp::POW: {
+                                auto numNode = static_cast<const NumberNode*>(binOp->right.get());
+                                std::string expr = "∂/∂x(";
+                                binOp->left->appendTo(expr, MAX_STEP_EXPRESSION_LENGTH);
+                                expr += "^" + std::to_string((int)numNode->value) + ")";
+                                addStep("Power Rule: ∂/∂x(x^n) = n * x^(n-1)", std::move(expr));
+                                break;
+                            }
+                        }
+                    }
+                    
+                    stack.push_back({node, true});
+                    if (binOp->op != BinaryOp::POW) {
+                        stack.push_back({binOp->right.get(), false});
+                    }
+                    stack.push_back({binOp->left.get(), false});
+                    break;
+                }
+                
+                case NodeType::UNARY_FUNC: {
+                    // The argument is differentiated before the chain rule step is logged
+                    auto funcNode = static_cast<const UnaryFuncNode*>(node);
+                    stack.push_back({node, true});
+                    stack.push_back({funcNode->arg.get(), false});
+                    break;
+                }
+            }
+            continue;
         }
         
-        case NodeType::BINARY_OP: {
+        if (node->type == NodeType::BINARY_OP) {
             auto binOp = static_cast<const BinaryOpNode*>(node);
             
+            if (binOp->op == BinaryOp::POW) {
+                // n * x^(n-1) * x'
+                auto numNode = static_cast<const NumberNode*>(binOp->right.get());
+                auto baseDeriv = std::move(results.back());
+                results.pop_back();
+                
+                auto coeff = std::make_unique<NumberNode>(numNode->value);
+                auto newPower = std::make_unique<NumberNode>(numNode->value - 1);
+                
+                auto power = std::make_unique<BinaryOpNode>(
+                    BinaryOp::POW,
+                    binOp->left->clone(),
+                    std::move(newPower)
+                );
+                
+                auto mult1 = std::make_unique<BinaryOpNode>(
+                    BinaryOp::MUL,
+                    std::move(coeff),
+                    std::move(power)
+                );
+                
+                results.push_back(std::make_unique<BinaryOpNode>(
+                    BinaryOp::MUL,
+                    std::move(mult1),
+                    std::move(baseDeriv)
+                ));
+                continue;
+            }
+            
+            auto rightDeriv = std::move(results.back());
+            results.pop_back();
+            auto leftDeriv = std::move(results.back());
+            results.pop_back();
+            
             switch (binOp->op) {
-                case BinaryOp::ADD: {
-                    DifferentiationStep step;
-                    step.description = "Sum Rule: ∂/∂x(f + g) = f' + g'";
-                    step.expression = "∂/∂x(" + binOp->left->toString() + " + " + binOp->right->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto leftDeriv = differentiateNode(binOp->left.get());
-                    auto rightDeriv = differentiateNode(binOp->right.get());
-                    return std::make_unique<BinaryOpNode>(BinaryOp::ADD, std::move(leftDeriv), std::move(rightDeriv));
-                }
+                case BinaryOp::ADD:
+                    results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::ADD, std::move(leftDeriv), std::move(rightDeriv)));
+                    break;
                 
-                case BinaryOp::SUB: {
-                    DifferentiationStep step;
-                    step.description = "Difference Rule: ∂/∂x(f - g) = f' - g'";
-                    step.expression = "∂/∂x(" + binOp->left->toString() + " - " + binOp->right->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto leftDeriv = differentiateNode(binOp->left.get());
-                    auto rightDeriv = differentiateNode(binOp->right.get());
-                    return std::make_unique<BinaryOpNode>(BinaryOp::SUB, std::move(leftDeriv), std::move(rightDeriv));
-                }
+                case BinaryOp::SUB:
+                    results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::SUB, std::move(leftDeriv), std::move(rightDeriv)));
+                    break;
                 
                 case BinaryOp::MUL: {
-                    DifferentiationStep step;
-                    step.description = "Product Rule: ∂/∂x(f * g) = f' * g + f * g'";
-                    step.expression = "∂/∂x(" + binOp->left->toString() + " * " + binOp->right->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto leftDeriv = differentiateNode(binOp->left.get());
-                    auto rightDeriv = differentiateNode(binOp->right.get());
-                    
                     // f' * g
                     auto term1 = std::make_unique<BinaryOpNode>(
                         BinaryOp::MUL,
@@ -85,18 +213,11 @@ std::unique_ptr<ASTNode> Differentiator::differentiateNode(const ASTNode* node)
                         std::move(rightDeriv)
                     );
                     
-                    return std::make_unique<BinaryOpNode>(BinaryOp::ADD, std::move(term1), std::move(term2));
+                    results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::ADD, std::move(term1), std::move(term2)));
+                    break;
                 }
                 
                 case BinaryOp::DIV: {
-                    DifferentiationStep step;
-                    step.description = "Quotient Rule: ∂/∂x(f/g) = (f' * g - f * g') / g^2";
-                    step.expression = "∂/∂x(" + binOp->left->toString() + " / " + binOp->right->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto leftDeriv = differentiateNode(binOp->left.get());
-                    auto rightDeriv = differentiateNode(binOp->right.get());
-                    
                     // f' * g
                     auto term1 = std::make_unique<BinaryOpNode>(
                         BinaryOp::MUL,
@@ -125,129 +246,88 @@ std::unique_ptr<ASTNode> Differentiator::differentiateNode(const ASTNode* node)
                         std::make_unique<NumberNode>(2)
                     );
                     
-                    return std::make_unique<BinaryOpNode>(BinaryOp::DIV, std::move(numerator), std::move(denominator));
+                    results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::DIV, std::move(numerator), std::move(denominator)));
+                    break;
                 }
                 
-                case BinaryOp::POW: {
-                    // Check if exponent is constant
-                    if (binOp->right->type == NodeType::NUMBER) {
-                        auto numNode = static_cast<const NumberNode*>(binOp->right.get());
-                        
-                        DifferentiationStep step;
-                        step.description = "Power Rule: ∂/∂x(x^n) = n * x^(n-1)";
-                        step.expression = "∂/∂x(" + binOp->left->toString() + "^" + std::to_string((int)numNode->value) + ")";
-                        steps.push_back(step);
-                        
-                        // n * x^(n-1) * x'
-                        auto coeff = std::make_unique<NumberNode>(numNode->value);
-                        auto newPower = std::make_unique<NumberNode>(numNode->value - 1);
-                        auto baseDeriv = differentiateNode(binOp->left.get());
-                        
-                        auto power = std::make_unique<BinaryOpNode>(
-                            BinaryOp::POW,
-                            binOp->left->clone(),
-                            std::move(newPower)
-                        );
-                        
-                        auto mult1 = std::make_unique<BinaryOpNode>(
-                            BinaryOp::MUL,
-                            std::move(coeff),
-                            std::move(power)
-                        );
-                        
-                        return std::make_unique<BinaryOpNode>(
-                            BinaryOp::MUL,
-                            std::move(mult1),
-                            std::move(baseDeriv)
-                        );
-                    }
-                    // General case: a^b = exp(b * ln(a))
+                case BinaryOp::POW:
                     break;
-                }
             }
-            break;
+            continue;
         }
         
-        case NodeType::UNARY_FUNC: {
-            auto funcNode = static_cast<const UnaryFuncNode*>(node);
-            auto innerDeriv = differentiateNode(funcNode->arg.get());
+        // UNARY_FUNC: chain rule with the argument's derivative on top of the stack
+        auto funcNode = static_cast<const UnaryFuncNode*>(node);
+        auto innerDeriv = std::move(results.back());
+        results.pop_back();
+        std::string u = loggingSteps() ? preview(funcNode->arg.get()) : std::string();
+        
+        switch (funcNode->func) {
+            case UnaryFunc::SIN: {
+                addStep("Chain Rule: ∂/∂x(sin(u)) = cos(u) * u'",
+                        "∂/∂x(sin(" + u + ")) = cos(" + u + ") * ∂/∂x(" + u + ")");
+                
+                auto cosNode = std::make_unique<UnaryFuncNode>(UnaryFunc::COS, funcNode->arg->clone());
+                results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(cosNode), std::move(innerDeriv)));
+                break;
+            }
             
-            switch (funcNode->func) {
-                case UnaryFunc::SIN: {
-                    DifferentiationStep step;
-                    step.description = "Chain Rule: ∂/∂x(sin(u)) = cos(u) * u'";
-                    step.expression = "∂/∂x(sin(" + funcNode->arg->toString() + ")) = cos(" + funcNode->arg->toString() + ") * ∂/∂x(" + funcNode->arg->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto cosNode = std::make_unique<UnaryFuncNode>(UnaryFunc::COS, funcNode->arg->clone());
-                    return std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(cosNode), std::move(innerDeriv));
-                }
+            case UnaryFunc::COS: {
+                addStep("Chain Rule: ∂/∂x(cos(u)) = -sin(u) * u'",
+                        "∂/∂x(cos(" + u + ")) = -sin(" + u + ") * ∂/∂x(" + u + ")");
                 
-                case UnaryFunc::COS: {
-                    DifferentiationStep step;
-                    step.description = "Chain Rule: ∂/∂x(cos(u)) = -sin(u) * u'";
-                    step.expression = "∂/∂x(cos(" + funcNode->arg->toString() + ")) = -sin(" + funcNode->arg->toString() + ") * ∂/∂x(" + funcNode->arg->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto sinNode = std::make_unique<UnaryFuncNode>(UnaryFunc::SIN, funcNode->arg->clone());
-                    auto negOne = std::make_unique<NumberNode>(-1);
-                    auto negSin = std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(negOne), std::move(sinNode));
-                    return std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(negSin), std::move(innerDeriv));
-                }
+                auto sinNode = std::make_unique<UnaryFuncNode>(UnaryFunc::SIN, funcNode->arg->clone());
+                auto negOne = std::make_unique<NumberNode>(-1);
+                auto negSin = std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(negOne), std::move(sinNode));
+                results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(negSin), std::move(innerDeriv)));
+                break;
+            }
+            
+            case UnaryFunc::TAN: {
+                addStep("Chain Rule: ∂/∂x(tan(u)) = sec^2(u) * u'", "∂/∂x(tan(" + u + "))");
                 
-                case UnaryFunc::TAN: {
-                    DifferentiationStep step;
-                    step.description = "Chain Rule: ∂/∂x(tan(u)) = sec^2(u) * u'";
-                    step.expression = "∂/∂x(tan(" + funcNode->arg->toString() + "))";
-                    steps.push_back(step);
-                    
-                    // 1 / cos^2(u)
-                    auto cosNode = std::make_unique<UnaryFuncNode>(UnaryFunc::COS, funcNode->arg->clone());
-                    auto cos2 = std::make_unique<BinaryOpNode>(BinaryOp::POW, std::move(cosNode), std::make_unique<NumberNode>(2));
-                    auto sec2 = std::make_unique<BinaryOpNode>(BinaryOp::DIV, std::make_unique<NumberNode>(1), std::move(cos2));
-                    return std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(sec2), std::move(innerDeriv));
-                }
+                // 1 / cos^2(u)
+                auto cosNode = std::make_unique<UnaryFuncNode>(UnaryFunc::COS, funcNode->arg->clone());
+                auto cos2 = std::make_unique<BinaryOpNode>(BinaryOp::POW, std::move(cosNode), std::make_unique<NumberNode>(2));
+                auto sec2 = std::make_unique<BinaryOpNode>(BinaryOp::DIV, std::make_unique<NumberNode>(1), std::move(cos2));
+                results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(sec2), std::move(innerDeriv)));
+                break;
+            }
+            
+            case UnaryFunc::LN: {
+                addStep("Chain Rule: ∂/∂x(ln(u)) = (1/u) * u'",
+                        "∂/∂x(ln(" + u + ")) = (1/" + u + ") * ∂/∂x(" + u + ")");
                 
-                case UnaryFunc::LN: {
-                    DifferentiationStep step;
-                    step.description = "Chain Rule: ∂/∂x(ln(u)) = (1/u) * u'";
-                    step.expression = "∂/∂x(ln(" + funcNode->arg->toString() + ")) = (1/" + funcNode->arg->toString() + ") * ∂/∂x(" + funcNode->arg->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto oneOverU = std::make_unique<BinaryOpNode>(
-                        BinaryOp::DIV,
-                        std::make_unique<NumberNode>(1),
-                        funcNode->arg->clone()
-                    );
-                    return std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(oneOverU), std::move(innerDeriv));
-                }
+                auto oneOverU = std::make_unique<BinaryOpNode>(
+                    BinaryOp::DIV,
+                    std::make_unique<NumberNode>(1),
+                    funcNode->arg->clone()
+                );
+                results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(oneOverU), std::move(innerDeriv)));
+                break;
+            }
+            
+            case UnaryFunc::EXP: {
+                addStep("Chain Rule: ∂/∂x(exp(u)) = exp(u) * u'",
+                        "∂/∂x(exp(" + u + ")) = exp(" + u + ") * ∂/∂x(" + u + ")");
                 
-                case UnaryFunc::EXP: {
-                    DifferentiationStep step;
-                    step.description = "Chain Rule: ∂/∂x(exp(u)) = exp(u) * u'";
-                    step.expression = "∂/∂x(exp(" + funcNode->arg->toString() + ")) = exp(" + funcNode->arg->toString() + ") * ∂/∂x(" + funcNode->arg->toString() + ")";
-                    steps.push_back(step);
-                    
-                    auto expNode = std::make_unique<UnaryFuncNode>(UnaryFunc::EXP, funcNode->arg->clone());
-                    return std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(expNode), std::move(innerDeriv));
-                }
+                auto expNode = std::make_unique<UnaryFuncNode>(UnaryFunc::EXP, funcNode->arg->clone());
+                results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(expNode), std::move(innerDeriv)));
+                break;
+            }
+            
+            case UnaryFunc::SQRT: {
+                addStep("Chain Rule: ∂/∂x(sqrt(u)) = (1/(2*sqrt(u))) * u'", "∂/∂x(sqrt(" + u + "))");
                 
-                case UnaryFunc::SQRT: {
-                    DifferentiationStep step;
-                    step.description = "Chain Rule: ∂/∂x(sqrt(u)) = (1/(2*sqrt(u))) * u'";
-                    step.expression = "∂/∂x(sqrt(" + funcNode->arg->toString() + "))";
-                    steps.push_back(step);
-                    
-                    auto sqrtNode = std::make_unique<UnaryFuncNode>(UnaryFunc::SQRT, funcNode->arg->clone());
-                    auto two = std::make_unique<NumberNode>(2);
-                    auto twoSqrt = std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(two), std::move(sqrtNode));
-                    auto coeff = std::make_unique<BinaryOpNode>(BinaryOp::DIV, std::make_unique<NumberNode>(1), std::move(twoSqrt));
-                    return std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(coeff), std::move(innerDeriv));
-                }
+                auto sqrtNode = std::make_unique<UnaryFuncNode>(UnaryFunc::SQRT, funcNode->arg->clone());
+                auto two = std::make_unique<NumberNode>(2);
+                auto twoSqrt = std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(two), std::move(sqrtNode));
+                auto coeff = std::make_unique<BinaryOpNode>(BinaryOp::DIV, std::make_unique<NumberNode>(1), std::move(twoSqrt));
+                results.push_back(std::make_unique<BinaryOpNode>(BinaryOp::MUL, std::move(coeff), std::move(innerDeriv)));
+                break;
             }
-            break;
         }
     }
     
-    return std::make_unique<NumberNode>(0);
+    return std::move(results.back());
 }
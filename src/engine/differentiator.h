@@ -5,7 +5,10 @@
 class Differentiator {
 private:
     std::vector<DifferentiationStep> steps;
+    size_t omittedSteps = 0;
     
+    bool loggingSteps() const;
+    void addStep(const char* description, std::string expression);
     std::unique_ptr<ASTNode> differentiateNode(const ASTNode* node);
     std::unique_ptr<ASTNode> applyChainRule(const ASTNode* node);
     
@@ -0,0 +1,330 @@
+#include "distributions.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace distributions {
+
+static const double kNaN = std::numeric_limits<double>::quiet_NaN();
+static const double kInfinity = std::numeric_limits<double>::infinity();
+static const int kMaxIterations = 100000;    // Continued fractions need O(√a) terms
+static const double kTiny = 1e-300;          // Lentz's method guard against division by zero
+
+double logChoose(double n, double k) {
+    return std::lgamma(n + 1) - std::lgamma(k + 1) - std::lgamma(n - k + 1);
+}
+
+// Series for P(a, x), converges quickly for x < a + 1
+static double gammaSeries(double a, double x) {
+    double term = 1.0 / a;
+    double sum = term;
+    double ap = a;
+    for (int i = 0; i < kMaxIterations; i++) {
+        ap += 1;
+        term *= x / ap;
+        sum += term;
+        if (std::abs(term) < std::abs(sum) * DBL_EPSILON) break;
+    }
+    return sum * std::exp(-x + a * std::log(x) - std::lgamma(a));
+}
+
+// Continued fraction (modified Lentz) for Q(a, x), used for x >= a + 1
+static double gammaContinuedFraction(double a, double x) {
+    double b = x + 1 - a;
+    double c = 1.0 / kTiny;
+    double d = 1.0 / b;
+    double h = d;
+    for (int i = 1; i < kMaxIterations; i++) {
+        double an = -i * (i - a);
+        b += 2;
+        d = an * d + b;
+        if (std::abs(d) < kTiny) d = kTiny;
+        c = b + an / c;
+        if (std::abs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < DBL_EPSILON) break;
+    }
+    return std::exp(-x + a * std::log(x) - std::lgamma(a)) * h;
+}
+
+double regularizedGammaP(double a, double x) {
+    if (std::isnan(a) || std::isnan(x) || a <= 0) return kNaN;
+    if (x <= 0) return 0.0;
+    if (x == kInfinity) return 1.0;
+    return x < a + 1 ? gammaSeries(a, x) : 1.0 - gammaContinuedFraction(a, x);
+}
+
+double regularizedGammaQ(double a, double x) {
+    if (std::isnan(a) || std::isnan(x) || a <= 0) return kNaN;
+    if (x <= 0) return 1.0;
+    if (x == kInfinity) return 0.0;
+    return x < a + 1 ? 1.0 - gammaSeries(a, x) : gammaContinuedFraction(a, x);
+}
+
+// Continued fraction for I_x(a, b) (modified Lentz)
+static double betaContinuedFraction(double a, double b, double x) {
+    double qab = a + b;
+    double qap = a + 1;
+    double qam = a - 1;
+    double c = 1.0;
+    double d = 1.0 - qab * x / qap;
+    if (std::abs(d) < kTiny) d = kTiny;
+    d = 1.0 / d;
+    double h = d;
+    
+    for (int m = 1; m < kMaxIterations; m++) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+        d = 1.0 + aa * d;
+        if (std::abs(d) < kTiny) d = kTiny;
+        c = 1.0 + aa / c;
+        if (std::abs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        h *= d * c;
+        
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+        d = 1.0 + aa * d;
+        if (std::abs(d) < kTiny) d = kTiny;
+        c = 1.0 + aa / c;
+        if (std::abs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < DBL_EPSILON) break;
+    }
+    return h;
+}
+
+double regularizedBeta(double a, double b, double x) {
+    if (std::isnan(x) || a <= 0 || b <= 0) return kNaN;
+    if (x <= 0) return 0.0;
+    if (x >= 1) return 1.0;
+    
+    double logFront = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b)
+                    + a * std::log(x) + b * std::log1p(-x);
+    double front = std::exp(logFront);
+    
+    // The fraction converges fastest on the side of the mean a/(a+b)
+    if (x < (a + 1) / (a + b + 2)) {
+        return front * betaContinuedFraction(a, b, x) / a;
+    }
+    return 1.0 - front * betaContinuedFraction(b, a, 1 - x) / b;
+}
+
+double inverseNormalCdf(double p) {
+    if (std::isnan(p) || p < 0 || p > 1) return kNaN;
+    if (p == 0) return -kInfinity;
+    if (p == 1) return kInfinity;
+    
+    // Acklam's rational approximation (relative error 1.15e-9) ...
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double pLow = 0.02425;
+    
+    double x;
+    if (p < pLow) {
+        double q = std::sqrt(-2 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    } else if (p <= 1 - pLow) {
+        double q = p - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+    } else {
+        double q = std::sqrt(-2 * std::log1p(-p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+             ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    
+    // ... polished to full double precision by one Halley step
+    double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+    double u = e * std::sqrt(2 * M_PI) * std::exp(x * x / 2);
+    return x - u / (1 + x * u / 2);
+}
+
+void normalPdf(const double* x, double* out, size_t n, double mu, double sigma) {
+    const double inverseSigma = 1.0 / sigma;
+    const double front = inverseSigma / std::sqrt(2 * M_PI);
+    for (size_t i = 0; i < n; i++) {
+        double z = (x[i] - mu) * inverseSigma;
+        out[i] = front * std::exp(-0.5 * z * z);
+    }
+}
+
+void normalLogPdf(const double* x, double* out, size_t n, double mu, double sigma) {
+    const double inverseSigma = 1.0 / sigma;
+    const double logFront = -std::log(sigma) - 0.5 * std::log(2 * M_PI);
+    for (size_t i = 0; i < n; i++) {
+        double z = (x[i] - mu) * inverseSigma;
+        out[i] = logFront - 0.5 * z * z;
+    }
+}
+
+void normalCdf(const double* x, double* out, size_t n, double mu, double sigma) {
+    // erfc keeps full relative accuracy in the lower tail, unlike 1 + erf
+    const double scale = 1.0 / (sigma * std::sqrt(2.0));
+    for (size_t i = 0; i < n; i++) {
+        out[i] = 0.5 * std::erfc(-(x[i] - mu) * scale);
+    }
+}
+
+void normalQuantile(const double* p, double* out, size_t n, double mu, double sigma) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = mu + sigma * inverseNormalCdf(p[i]);
+    }
+}
+
+void binomialLogPmf(const double* k, double* out, size_t n, int trials, double prob) {
+    const double logP = std::log(prob);
+    const double log1mP = std::log1p(-prob);
+    const double logTrialsFactorial = std::lgamma(trials + 1.0);
+    for (size_t i = 0; i < n; i++) {
+        double ki = k[i];
+        double failures = trials - ki;
+        // 0·log(0) terms are taken as 0 so p = 0 and p = 1 work
+        double value = logTrialsFactorial - std::lgamma(ki + 1) - std::lgamma(failures + 1)
+                     + (ki > 0 ? ki * logP : 0.0) + (failures > 0 ? failures * log1mP : 0.0);
+        out[i] = (ki >= 0 && failures >= 0) ? value : -kInfinity;
+    }
+}
+
+void binomialPmf(const double* k, double* out, size_t n, int trials, double prob) {
+    binomialLogPmf(k, out, n, trials, prob);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = std::exp(out[i]);
+    }
+}
+
+static double binomialCdfAt(double k, int trials, double prob) {
+    if (k < 0) return 0.0;
+    if (k >= trials) return 1.0;
+    double kf = std::floor(k);
+    // P(X ≤ k) = I_{1-p}(n - k, k + 1)
+    return regularizedBeta(trials - kf, kf + 1, 1 - prob);
+}
+
+void binomialCdf(const double* k, double* out, size_t n, int trials, double prob) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = binomialCdfAt(k[i], trials, prob);
+    }
+}
+
+static double poissonCdfAt(double k, double lambda) {
+    if (k < 0) return 0.0;
+    // P(X ≤ k) = Q(k + 1, λ)
+    return regularizedGammaQ(std::floor(k) + 1, lambda);
+}
+
+// Smallest integer k in [lo, hi] with cdf(k) >= p, walking from a
+// normal-approximation guess (usually only a step or two away)
+template <typename Cdf>
+static double discreteQuantile(double p, double guess, double lo, double hi, Cdf cdf) {
+    if (std::isnan(p) || p < 0 || p > 1) return kNaN;
+    if (p == 0) return lo;
+    if (p == 1) return hi;
+    
+    // Tolerance so rounding in the cdf cannot push the answer one step too far
+    double target = p * (1 - 64 * DBL_EPSILON);
+    double k = std::min(hi, std::max(lo, std::floor(guess + 0.5)));
+    if (cdf(k) >= target) {
+        while (k > lo && cdf(k - 1) >= target) k--;
+    } else {
+        while (k < hi && cdf(k) < target) k++;
+    }
+    return k;
+}
+
+void binomialQuantile(const double* p, double* out, size_t n, int trials, double prob) {
+    const double mean = trials * prob;
+    const double sd = std::sqrt(trials * prob * (1 - prob));
+    auto cdf = [trials, prob](double k) { return binomialCdfAt(k, trials, prob); };
+    for (size_t i = 0; i < n; i++) {
+        double guess = mean + sd * inverseNormalCdf(std::min(1 - DBL_EPSILON, std::max(DBL_EPSILON, p[i])));
+        out[i] = discreteQuantile(p[i], guess, 0, trials, cdf);
+    }
+}
+
+void poissonLogPmf(const double* k, double* out, size_t n, double lambda) {
+    const double logLambda = std::log(lambda);
+    for (size_t i = 0; i < n; i++) {
+        double ki = k[i];
+        double value = (ki > 0 ? ki * logLambda : 0.0) - lambda - std::lgamma(ki + 1);
+        out[i] = ki >= 0 ? value : -kInfinity;
+    }
+}
+
+void poissonPmf(const double* k, double* out, size_t n, double lambda) {
+    poissonLogPmf(k, out, n, lambda);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = std::exp(out[i]);
+    }
+}
+
+void poissonCdf(const double* k, double* out, size_t n, double lambda) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = poissonCdfAt(k[i], lambda);
+    }
+}
+
+void poissonQuantile(const double* p, double* out, size_t n, double lambda) {
+    const double sd = std::sqrt(lambda);
+    auto cdf = [lambda](double k) { return poissonCdfAt(k, lambda); };
+    for (size_t i = 0; i < n; i++) {
+        double guess = lambda + sd * inverseNormalCdf(std::min(1 - DBL_EPSILON, std::max(DBL_EPSILON, p[i])));
+        out[i] = discreteQuantile(p[i], guess, 0, kInfinity, cdf);
+    }
+}
+
+void exponentialPdf(const double* x, double* out, size_t n, double rate) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = x[i] >= 0 ? rate * std::exp(-rate * x[i]) : 0.0;
+    }
+}
+
+void exponentialCdf(const double* x, double* out, size_t n, double rate) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = x[i] > 0 ? -std::expm1(-rate * x[i]) : 0.0;
+    }
+}
+
+void exponentialQuantile(const double* p, double* out, size_t n, double rate) {
+    const double inverseRate = 1.0 / rate;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (p[i] >= 0 && p[i] <= 1) ? -std::log1p(-p[i]) * inverseRate : kNaN;
+    }
+}
+
+void gammaPdf(const double* x, double* out, size_t n, double shape, double scale) {
+    const double logFront = -std::lgamma(shape) - shape * std::log(scale);
+    const double inverseScale = 1.0 / scale;
+    // Density at 0 is ∞, 1/θ or 0 depending on whether the shape is <, = or > 1
+    const double atZero = shape < 1 ? kInfinity : (shape == 1 ? inverseScale : 0.0);
+    for (size_t i = 0; i < n; i++) {
+        double xi = x[i];
+        double value = std::exp(logFront + (shape - 1) * std::log(xi) - xi * inverseScale);
+        out[i] = xi > 0 ? value : (xi == 0 ? atZero : 0.0);
+    }
+}
+
+void gammaCdf(const double* x, double* out, size_t n, double shape, double scale) {
+    const double inverseScale = 1.0 / scale;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = regularizedGammaP(shape, x[i] * inverseScale);
+    }
+}
+
+} // namespace distributions
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+
+// Batched probability distribution kernels: out[i] = f(x[i]) for n points.
+//
+// Everything is computed in log space (lgamma, log1p) so large counts never
+// overflow: a binomial coefficient or k! is never formed directly. Parameter-
+// only terms are hoisted out of the loops, and the loops have no
+// data-dependent branches, so the compiler can vectorize the arithmetic.
+// Discrete distributions take their support points as doubles holding integers.
+namespace distributions {
+
+// Normal N(mu, sigma²)
+void normalPdf(const double* x, double* out, size_t n, double mu, double sigma);
+void normalLogPdf(const double* x, double* out, size_t n, double mu, double sigma);
+void normalCdf(const double* x, double* out, size_t n, double mu, double sigma);
+void normalQuantile(const double* p, double* out, size_t n, double mu, double sigma);
+
+// Binomial(trials, prob)
+void binomialLogPmf(const double* k, double* out, size_t n, int trials, double prob);
+void binomialPmf(const double* k, double* out, size_t n, int trials, double prob);
+void binomialCdf(const double* k, double* out, size_t n, int trials, double prob);
+void binomialQuantile(const double* p, double* out, size_t n, int trials, double prob);
+
+// Poisson(lambda)
+void poissonLogPmf(const double* k, double* out, size_t n, double lambda);
+void poissonPmf(const double* k, double* out, size_t n, double lambda);
+void poissonCdf(const double* k, double* out, size_t n, double lambda);
+void poissonQuantile(const double* p, double* out, size_t n, double lambda);
+
+// Exponential(rate)
+void exponentialPdf(const double* x, double* out, size_t n, double rate);
+void exponentialCdf(const double* x, double* out, size_t n, double rate);
+void exponentialQuantile(const double* p, double* out, size_t n, double rate);
+
+// Gamma(shape, scale); chi-squared(ν) is Gamma(ν/2, 2)
+void gammaPdf(const double* x, double* out, size_t n, double shape, double scale);
+void gammaCdf(const double* x, double* out, size_t n, double shape, double scale);
+
+// Scalar building blocks, also used by StatisticsCalculator
+double logChoose(double n, double k);
+double regularizedGammaP(double a, double x);   // P(a, x) = γ(a, x)/Γ(a)
+double regularizedGammaQ(double a, double x);   // Q(a, x) = 1 - P(a, x)
+double regularizedBeta(double a, double b, double x);  // I_x(a, b)
+double inverseNormalCdf(double p);              // Standard normal Φ⁻¹(p)
+
+} // namespace distributions
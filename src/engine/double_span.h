@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Non-owning view of contiguous doubles. Columns loaded by ColumnLoader are
+// handed out this way (often pointing straight into a memory-mapped file),
+// and in-memory vectors convert implicitly, so routines taking a DoubleSpan
+// serve both without copying.
+struct DoubleSpan {
+    const double* values = nullptr;
+    size_t length = 0;
+    
+    DoubleSpan() = default;
+    DoubleSpan(const double* values, size_t length) : values(values), length(length) {}
+    DoubleSpan(const std::vector<double>& data) : values(data.data()), length(data.size()) {}
+    
+    const double* data() const { return values; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    double operator[](size_t i) const { return values[i]; }
+    const double* begin() const { return values; }
+    const double* end() const { return values + length; }
+    
+    DoubleSpan subspan(size_t offset, size_t count) const {
+        if (offset > length) offset = length;
+        if (count > length - offset) count = length - offset;
+        return DoubleSpan(values + offset, count);
+    }
+};
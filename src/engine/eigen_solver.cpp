@@ -0,0 +1,828 @@
+#include "eigen_solver.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+// Sweeps allowed per eigenvalue before giving up (typically 2–3 are needed)
+static const int kMaxSweepsPerValue = 60;
+
+bool EigenSolver::isSymmetric(const Matrix& A) {
+    if (A.rows != A.cols) return false;
+    double scale = 0.0;
+    for (int i = 0; i < A.rows; i++) {
+        for (int j = 0; j < A.cols; j++) {
+            scale = std::max(scale, std::abs(A.data[i][j]));
+        }
+    }
+    for (int i = 0; i < A.rows; i++) {
+        for (int j = i + 1; j < A.cols; j++) {
+            if (std::abs(A.data[i][j] - A.data[j][i]) > 1e-14 * scale) return false;
+        }
+    }
+    return true;
+}
+
+EigenDecomposition EigenSolver::compute(const Matrix& A, bool computeVectors) {
+    if (isSymmetric(A)) {
+        return computeSymmetric(A, computeVectors);
+    }
+    return computeGeneral(A, computeVectors);
+}
+
+// Householder tridiagonalization of a symmetric matrix (EISPACK tred2).
+// v is column-major so the inner loops, which run down columns, are
+// contiguous. On return d holds the diagonal, e the subdiagonal in e[1..n-1],
+// and v the accumulated orthogonal transformation if wantVectors.
+static void tridiagonalize(std::vector<double>& v, size_t n, std::vector<double>& d,
+                           std::vector<double>& e, bool wantVectors) {
+    auto V = [&](size_t r, size_t c) -> double& { return v[c * n + r]; };
+    
+    for (size_t j = 0; j < n; j++) {
+        d[j] = V(n - 1, j);
+    }
+    
+    for (size_t i = n - 1; i > 0; i--) {
+        if (i % 64 == 0) JobContext::checkpoint();
+        
+        double scale = 0.0;
+        double h = 0.0;
+        for (size_t k = 0; k < i; k++) {
+            scale += std::abs(d[k]);
+        }
+        
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (size_t j = 0; j < i; j++) {
+                d[j] = V(i - 1, j);
+                V(i, j) = 0.0;
+                V(j, i) = 0.0;
+            }
+        } else {
+            // Householder vector from the scaled row
+            for (size_t k = 0; k < i; k++) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0) g = -g;
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (size_t j = 0; j < i; j++) {
+                e[j] = 0.0;
+            }
+            
+            // Apply the similarity transformation to the remaining columns
+            for (size_t j = 0; j < i; j++) {
+                f = d[j];
+                V(j, i) = f;
+                g = e[j] + V(j, j) * f;
+                double* column = &V(0, j);
+                for (size_t k = j + 1; k <= i - 1; k++) {
+                    g += column[k] * d[k];
+                    e[k] += column[k] * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (size_t j = 0; j < i; j++) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            double hh = f / (h + h);
+            for (size_t j = 0; j < i; j++) {
+                e[j] -= hh * d[j];
+            }
+            for (size_t j = 0; j < i; j++) {
+                f = d[j];
+                g = e[j];
+                double* column = &V(0, j);
+                for (size_t k = j; k <= i - 1; k++) {
+                    column[k] -= (f * e[k] + g * d[k]);
+                }
+                d[j] = V(i - 1, j);
+                V(i, j) = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+    
+    if (!wantVectors) {
+        // The tridiagonal's diagonal was left on the diagonal of v
+        for (size_t j = 0; j < n; j++) {
+            d[j] = V(j, j);
+        }
+        e[0] = 0.0;
+        return;
+    }
+    
+    // Accumulate the transformations
+    for (size_t i = 0; i + 1 < n; i++) {
+        V(n - 1, i) = V(i, i);
+        V(i, i) = 1.0;
+        double h = d[i + 1];
+        if (h != 0.0) {
+            const double* next = &V(0, i + 1);
+            for (size_t k = 0; k <= i; k++) {
+                d[k] = next[k] / h;
+            }
+            for (size_t j = 0; j <= i; j++) {
+                double* column = &V(0, j);
+                double g = 0.0;
+                for (size_t k = 0; k <= i; k++) {
+                    g += next[k] * column[k];
+                }
+                for (size_t k = 0; k <= i; k++) {
+                    column[k] -= g * d[k];
+                }
+            }
+        }
+        for (size_t k = 0; k <= i; k++) {
+            V(k, i + 1) = 0.0;
+        }
+    }
+    for (size_t j = 0; j < n; j++) {
+        d[j] = V(n - 1, j);
+        V(n - 1, j) = 0.0;
+    }
+    V(n - 1, n - 1) = 1.0;
+    e[0] = 0.0;
+}
+
+// Implicit QL with Wilkinson shifts on the tridiagonal (EISPACK tql2).
+// Rotations are applied to the columns of v when wantVectors.
+static int tridiagonalQL(std::vector<double>& v, size_t n, std::vector<double>& d,
+                         std::vector<double>& e, bool wantVectors) {
+    for (size_t i = 1; i < n; i++) {
+        e[i - 1] = e[i];
+    }
+    e[n - 1] = 0.0;
+    
+    int sweeps = 0;
+    double f = 0.0;
+    double tst1 = 0.0;
+    for (size_t l = 0; l < n; l++) {
+        // Find a small subdiagonal element that splits off the block l..m
+        tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+        size_t m = l;
+        while (m < n - 1 && std::abs(e[m]) > DBL_EPSILON * tst1) {
+            m++;
+        }
+        
+        if (m > l) {
+            int iterations = 0;
+            do {
+                if (++iterations > kMaxSweepsPerValue) {
+                    throw std::runtime_error("Symmetric QL iteration did not converge");
+                }
+                sweeps++;
+                
+                // Shift from the leading 2×2 block
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0) r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (size_t i = l + 2; i < n; i++) {
+                    d[i] -= h;
+                }
+                f += h;
+                
+                // Chase the bulge with Givens rotations
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0;
+                double el1 = e[l + 1];
+                double s = 0.0, s2 = 0.0;
+                for (size_t i = m; i-- > l;) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    
+                    if (wantVectors) {
+                        double* left = &v[i * n];
+                        double* right = &v[(i + 1) * n];
+                        for (size_t k = 0; k < n; k++) {
+                            double rk = right[k];
+                            right[k] = s * left[k] + c * rk;
+                            left[k] = c * left[k] - s * rk;
+                        }
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::abs(e[l]) > DBL_EPSILON * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+    return sweeps;
+}
+
+EigenDecomposition EigenSolver::computeSymmetric(const Matrix& A, bool computeVectors) {
+    steps.clear();
+    if (A.rows != A.cols) {
+        throw std::invalid_argument("Eigenvalues need a square matrix");
+    }
+    
+    const size_t n = A.rows;
+    EigenDecomposition result;
+    result.symmetric = true;
+    if (n == 0) return result;
+    
+    std::vector<double> v(n * n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            v[j * n + i] = A.data[i][j];
+        }
+    }
+    std::vector<double> d(n), e(n);
+    
+    tridiagonalize(v, n, d, e, computeVectors);
+    steps.push_back({"Householder tridiagonalization", "A = Q·T·Qᵀ, T symmetric tridiagonal (" +
+                     std::to_string(n) + "×" + std::to_string(n) + ")"});
+    
+    result.iterations = tridiagonalQL(v, n, d, e, computeVectors);
+    steps.push_back({"Implicit QL with Wilkinson shifts", "T = Z·Λ·Zᵀ after " +
+                     std::to_string(result.iterations) + " sweeps"});
+    
+    // Ascending order; vectors follow their values
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return d[a] < d[b]; });
+    
+    for (size_t index : order) {
+        result.values.emplace_back(d[index], 0.0);
+        if (computeVectors) {
+            const double* column = &v[index * n];
+            result.vectors.emplace_back(column, column + n);
+        }
+    }
+    
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(4);
+    size_t shown = std::min<size_t>(n, 8);
+    for (size_t i = 0; i < shown; i++) {
+        if (i > 0) oss << ", ";
+        oss << "λ" << (i + 1) << " = " << result.values[i].real();
+    }
+    if (n > shown) oss << ", ... (" << n << " total)";
+    steps.push_back({"Eigenvalues (ascending)", oss.str()});
+    return result;
+}
+
+// Scales rows/columns by powers of two so they have comparable norms, which
+// tightens the QR error bound (EISPACK balanc, scaling only). Returns D with
+// B = D⁻¹·A·D.
+static std::vector<double> balance(std::vector<double>& h, size_t n) {
+    const double radix = 2.0;
+    std::vector<double> scale(n, 1.0);
+    bool converged = false;
+    while (!converged) {
+        converged = true;
+        for (size_t i = 0; i < n; i++) {
+            double c = 0.0, r = 0.0;
+            for (size_t j = 0; j < n; j++) {
+                if (j == i) continue;
+                c += std::abs(h[j * n + i]);
+                r += std::abs(h[i * n + j]);
+            }
+            if (c == 0.0 || r == 0.0) continue;
+            
+            double g = r / radix;
+            double f = 1.0;
+            double s = c + r;
+            while (c < g) {
+                f *= radix;
+                c *= radix * radix;
+            }
+            g = r * radix;
+            while (c > g) {
+                f /= radix;
+                c /= radix * radix;
+            }
+            if ((c + r) / f < 0.95 * s) {
+                converged = false;
+                scale[i] *= f;
+                for (size_t j = 0; j < n; j++) h[i * n + j] /= f;
+                for (size_t j = 0; j < n; j++) h[j * n + i] *= f;
+            }
+        }
+    }
+    return scale;
+}
+
+// Householder reduction to upper Hessenberg form (EISPACK orthes/ortran).
+// Both matrices are row-major; the left updates are organized by rows so
+// every inner loop is contiguous.
+static void hessenberg(std::vector<double>& h, size_t n, std::vector<double>* v) {
+    std::vector<double> ort(n, 0.0), f(n);
+    
+    for (size_t m = 1; m + 1 < n; m++) {
+        if (m % 32 == 0) JobContext::checkpoint();
+        
+        double scale = 0.0;
+        for (size_t i = m; i < n; i++) {
+            scale += std::abs(h[i * n + m - 1]);
+        }
+        if (scale == 0.0) continue;
+        
+        double hh = 0.0;
+        for (size_t i = n; i-- > m;) {
+            ort[i] = h[i * n + m - 1] / scale;
+            hh += ort[i] * ort[i];
+        }
+        double g = std::sqrt(hh);
+        if (ort[m] > 0) g = -g;
+        hh -= ort[m] * g;
+        ort[m] -= g;
+        
+        // H = (I - uuᵀ/h)·H: f = uᵀH, then subtract u·f/h row by row
+        std::fill(f.begin() + m, f.end(), 0.0);
+        for (size_t i = m; i < n; i++) {
+            const double* row = &h[i * n];
+            double u = ort[i];
+            for (size_t j = m; j < n; j++) f[j] += u * row[j];
+        }
+        for (size_t i = m; i < n; i++) {
+            double* row = &h[i * n];
+            double u = ort[i] / hh;
+            for (size_t j = m; j < n; j++) row[j] -= u * f[j];
+        }
+        
+        // H = H·(I - uuᵀ/h)
+        for (size_t i = 0; i < n; i++) {
+            double* row = &h[i * n];
+            double sum = 0.0;
+            for (size_t j = m; j < n; j++) sum += ort[j] * row[j];
+            sum /= hh;
+            for (size_t j = m; j < n; j++) row[j] -= sum * ort[j];
+        }
+        ort[m] *= scale;
+        h[m * n + m - 1] = scale * g;
+    }
+    
+    if (v) {
+        // Accumulate the reflections into V, last one first
+        std::vector<double>& V = *v;
+        std::fill(V.begin(), V.end(), 0.0);
+        for (size_t i = 0; i < n; i++) V[i * n + i] = 1.0;
+        
+        for (size_t m = n - 2; m >= 1 && n >= 3; m--) {
+            double sub = h[m * n + m - 1];
+            if (sub != 0.0) {
+                for (size_t i = m + 1; i < n; i++) ort[i] = h[i * n + m - 1];
+                std::fill(f.begin() + m, f.end(), 0.0);
+                for (size_t i = m; i < n; i++) {
+                    const double* row = &V[i * n];
+                    for (size_t j = m; j < n; j++) f[j] += ort[i] * row[j];
+                }
+                for (size_t j = m; j < n; j++) {
+                    f[j] = (f[j] / ort[m]) / sub;  // Two divisions avoid underflow
+                }
+                for (size_t i = m; i < n; i++) {
+                    double* row = &V[i * n];
+                    for (size_t j = m; j < n; j++) row[j] += f[j] * ort[i];
+                }
+            }
+            if (m == 1) break;
+        }
+    }
+    
+    // Clear the reflector storage below the subdiagonal
+    for (size_t i = 2; i < n; i++) {
+        for (size_t j = 0; j + 1 < i; j++) h[i * n + j] = 0.0;
+    }
+}
+
+static void complexDivide(double xr, double xi, double yr, double yi, double& cr, double& ci) {
+    std::complex<double> q = std::complex<double>(xr, xi) / std::complex<double>(yr, yi);
+    cr = q.real();
+    ci = q.imag();
+}
+
+// Francis double-shift QR on the Hessenberg matrix (EISPACK hqr2). Eigenvalues
+// go to d + i·e. With vectors, H is reduced to real Schur form, Schur vectors
+// are accumulated into V and eigenvectors are back-substituted; without,
+// sweeps touch only the active block.
+static int francisQR(std::vector<double>& hv, size_t size, std::vector<double>& d,
+                     std::vector<double>& e, std::vector<double>* vv) {
+    const int nn = static_cast<int>(size);
+    const bool wantVectors = vv != nullptr;
+    auto H = [&](int r, int c) -> double& { return hv[static_cast<size_t>(r) * size + c]; };
+    auto V = [&](int r, int c) -> double& { return (*vv)[static_cast<size_t>(r) * size + c]; };
+    
+    const double eps = DBL_EPSILON;
+    double exshift = 0.0;
+    double p = 0, q = 0, r = 0, s = 0, z = 0, t, w, x, y;
+    int sweeps = 0;
+    
+    double norm = 0.0;
+    for (int i = 0; i < nn; i++) {
+        for (int j = std::max(i - 1, 0); j < nn; j++) {
+            norm += std::abs(H(i, j));
+        }
+    }
+    
+    int n = nn - 1;
+    int iter = 0;
+    while (n >= 0) {
+        // Look for a single small subdiagonal element
+        int l = n;
+        while (l > 0) {
+            s = std::abs(H(l - 1, l - 1)) + std::abs(H(l, l));
+            if (s == 0.0) s = norm;
+            if (std::abs(H(l, l - 1)) < eps * s) break;
+            l--;
+        }
+        
+        if (l == n) {
+            // One root found
+            H(n, n) += exshift;
+            d[n] = H(n, n);
+            e[n] = 0.0;
+            n--;
+            iter = 0;
+        } else if (l == n - 1) {
+            // Two roots found
+            w = H(n, n - 1) * H(n - 1, n);
+            p = (H(n - 1, n - 1) - H(n, n)) / 2.0;
+            q = p * p + w;
+            z = std::sqrt(std::abs(q));
+            H(n, n) += exshift;
+            H(n - 1, n - 1) += exshift;
+            x = H(n, n);
+            
+            if (q >= 0) {
+                // Real pair
+                z = (p >= 0) ? p + z : p - z;
+                d[n - 1] = x + z;
+                d[n] = d[n - 1];
+                if (z != 0.0) d[n] = x - w / z;
+                e[n - 1] = 0.0;
+                e[n] = 0.0;
+                
+                if (wantVectors) {
+                    // Rotate the 2×2 block to upper triangular
+                    x = H(n, n - 1);
+                    s = std::abs(x) + std::abs(z);
+                    p = x / s;
+                    q = z / s;
+                    r = std::sqrt(p * p + q * q);
+                    p /= r;
+                    q /= r;
+                    for (int j = n - 1; j < nn; j++) {
+                        z = H(n - 1, j);
+                        H(n - 1, j) = q * z + p * H(n, j);
+                        H(n, j) = q * H(n, j) - p * z;
+                    }
+                    for (int i = 0; i <= n; i++) {
+                        z = H(i, n - 1);
+                        H(i, n - 1) = q * z + p * H(i, n);
+                        H(i, n) = q * H(i, n) - p * z;
+                    }
+                    for (int i = 0; i < nn; i++) {
+                        z = V(i, n - 1);
+                        V(i, n - 1) = q * z + p * V(i, n);
+                        V(i, n) = q * V(i, n) - p * z;
+                    }
+                }
+            } else {
+                // Complex pair
+                d[n - 1] = x + p;
+                d[n] = x + p;
+                e[n - 1] = z;
+                e[n] = -z;
+            }
+            n -= 2;
+            iter = 0;
+        } else {
+            // No convergence yet: form the shift
+            x = H(n, n);
+            y = 0.0;
+            w = 0.0;
+            if (l < n) {
+                y = H(n - 1, n - 1);
+                w = H(n, n - 1) * H(n - 1, n);
+            }
+            
+            // Exceptional shifts break cycles (Wilkinson's, then MATLAB's)
+            if (iter == 10) {
+                exshift += x;
+                for (int i = 0; i <= n; i++) H(i, i) -= x;
+                s = std::abs(H(n, n - 1)) + std::abs(H(n - 1, n - 2));
+                x = y = 0.75 * s;
+                w = -0.4375 * s * s;
+            }
+            if (iter == 30) {
+                s = (y - x) / 2.0;
+                s = s * s + w;
+                if (s > 0) {
+                    s = std::sqrt(s);
+                    if (y < x) s = -s;
+                    s = x - w / ((y - x) / 2.0 + s);
+                    for (int i = 0; i <= n; i++) H(i, i) -= s;
+                    exshift += s;
+                    x = y = w = 0.964;
+                }
+            }
+            
+            if (++iter > kMaxSweepsPerValue) {
+                throw std::runtime_error("QR iteration did not converge");
+            }
+            sweeps++;
+            if (sweeps % 64 == 0) JobContext::checkpoint();
+            
+            // Look for two consecutive small subdiagonal elements
+            int m = n - 2;
+            while (m >= l) {
+                z = H(m, m);
+                r = x - z;
+                s = y - z;
+                p = (r * s - w) / H(m + 1, m) + H(m, m + 1);
+                q = H(m + 1, m + 1) - z - r - s;
+                r = H(m + 2, m + 1);
+                s = std::abs(p) + std::abs(q) + std::abs(r);
+                p /= s;
+                q /= s;
+                r /= s;
+                if (m == l) break;
+                if (std::abs(H(m, m - 1)) * (std::abs(q) + std::abs(r)) <
+                    eps * (std::abs(p) * (std::abs(H(m - 1, m - 1)) + std::abs(z) + std::abs(H(m + 1, m + 1))))) {
+                    break;
+                }
+                m--;
+            }
+            
+            for (int i = m + 2; i <= n; i++) {
+                H(i, i - 2) = 0.0;
+                if (i > m + 2) H(i, i - 3) = 0.0;
+            }
+            
+            // Double QR step on rows l..n and columns m..n; the Schur form
+            // needs the full rows/columns, eigenvalues only the active block
+            const int lastColumn = wantVectors ? nn - 1 : n;
+            const int firstRow = wantVectors ? 0 : l;
+            for (int k = m; k <= n - 1; k++) {
+                bool notLast = (k != n - 1);
+                if (k != m) {
+                    p = H(k, k - 1);
+                    q = H(k + 1, k - 1);
+                    r = notLast ? H(k + 2, k - 1) : 0.0;
+                    x = std::abs(p) + std::abs(q) + std::abs(r);
+                    if (x == 0.0) continue;
+                    p /= x;
+                    q /= x;
+                    r /= x;
+                }
+                
+                s = std::sqrt(p * p + q * q + r * r);
+                if (p < 0) s = -s;
+                if (s == 0) continue;
+                
+                if (k != m) {
+                    H(k, k - 1) = -s * x;
+                } else if (l != m) {
+                    H(k, k - 1) = -H(k, k - 1);
+                }
+                p += s;
+                x = p / s;
+                y = q / s;
+                z = r / s;
+                q /= p;
+                r /= p;
+                
+                // Row modification
+                for (int j = k; j <= lastColumn; j++) {
+                    p = H(k, j) + q * H(k + 1, j);
+                    if (notLast) {
+                        p += r * H(k + 2, j);
+                        H(k + 2, j) -= p * z;
+                    }
+                    H(k, j) -= p * x;
+                    H(k + 1, j) -= p * y;
+                }
+                
+                // Column modification
+                for (int i = firstRow; i <= std::min(n, k + 3); i++) {
+                    p = x * H(i, k) + y * H(i, k + 1);
+                    if (notLast) {
+                        p += z * H(i, k + 2);
+                        H(i, k + 2) -= p * r;
+                    }
+                    H(i, k) -= p;
+                    H(i, k + 1) -= p * q;
+                }
+                
+                if (wantVectors) {
+                    for (int i = 0; i < nn; i++) {
+                        p = x * V(i, k) + y * V(i, k + 1);
+                        if (notLast) {
+                            p += z * V(i, k + 2);
+                            V(i, k + 2) -= p * r;
+                        }
+                        V(i, k) -= p;
+                        V(i, k + 1) -= p * q;
+                    }
+                }
+            }
+        }
+    }
+    
+    if (!wantVectors || norm == 0.0) {
+        return sweeps;
+    }
+    
+    // Back-substitute to find the vectors of the quasi-triangular form
+    for (n = nn - 1; n >= 0; n--) {
+        p = d[n];
+        q = e[n];
+        
+        if (q == 0) {
+            // Real vector
+            int l = n;
+            H(n, n) = 1.0;
+            for (int i = n - 1; i >= 0; i--) {
+                w = H(i, i) - p;
+                r = 0.0;
+                for (int j = l; j <= n; j++) r += H(i, j) * H(j, n);
+                if (e[i] < 0.0) {
+                    z = w;
+                    s = r;
+                } else {
+                    l = i;
+                    if (e[i] == 0.0) {
+                        H(i, n) = (w != 0.0) ? -r / w : -r / (eps * norm);
+                    } else {
+                        x = H(i, i + 1);
+                        y = H(i + 1, i);
+                        q = (d[i] - p) * (d[i] - p) + e[i] * e[i];
+                        t = (x * s - z * r) / q;
+                        H(i, n) = t;
+                        H(i + 1, n) = (std::abs(x) > std::abs(z)) ? (-r - w * t) / x : (-s - y * t) / z;
+                    }
+                    
+                    // Overflow control
+                    t = std::abs(H(i, n));
+                    if ((eps * t) * t > 1) {
+                        for (int j = i; j <= n; j++) H(j, n) /= t;
+                    }
+                }
+            }
+        } else if (q < 0) {
+            // Complex vector (real part in column n-1, imaginary in n)
+            int l = n - 1;
+            if (std::abs(H(n, n - 1)) > std::abs(H(n - 1, n))) {
+                H(n - 1, n - 1) = q / H(n, n - 1);
+                H(n - 1, n) = -(H(n, n) - p) / H(n, n - 1);
+            } else {
+                complexDivide(0.0, -H(n - 1, n), H(n - 1, n - 1) - p, q, H(n - 1, n - 1), H(n - 1, n));
+            }
+            H(n, n - 1) = 0.0;
+            H(n, n) = 1.0;
+            
+            for (int i = n - 2; i >= 0; i--) {
+                double ra = 0.0, sa = 0.0, vr, vi;
+                for (int j = l; j <= n; j++) {
+                    ra += H(i, j) * H(j, n - 1);
+                    sa += H(i, j) * H(j, n);
+                }
+                w = H(i, i) - p;
+                
+                if (e[i] < 0.0) {
+                    z = w;
+                    r = ra;
+                    s = sa;
+                } else {
+                    l = i;
+                    if (e[i] == 0) {
+                        complexDivide(-ra, -sa, w, q, H(i, n - 1), H(i, n));
+                    } else {
+                        x = H(i, i + 1);
+                        y = H(i + 1, i);
+                        vr = (d[i] - p) * (d[i] - p) + e[i] * e[i] - q * q;
+                        vi = (d[i] - p) * 2.0 * q;
+                        if (vr == 0.0 && vi == 0.0) {
+                            vr = eps * norm * (std::abs(w) + std::abs(q) + std::abs(x) + std::abs(y) + std::abs(z));
+                        }
+                        complexDivide(x * r - z * ra + q * sa, x * s - z * sa - q * ra, vr, vi, H(i, n - 1), H(i, n));
+                        if (std::abs(x) > (std::abs(z) + std::abs(q))) {
+                            H(i + 1, n - 1) = (-ra - w * H(i, n - 1) + q * H(i, n)) / x;
+                            H(i + 1, n) = (-sa - w * H(i, n) - q * H(i, n - 1)) / x;
+                        } else {
+                            complexDivide(-r - y * H(i, n - 1), -s - y * H(i, n), z, q, H(i + 1, n - 1), H(i + 1, n));
+                        }
+                    }
+                    
+                    // Overflow control
+                    t = std::max(std::abs(H(i, n - 1)), std::abs(H(i, n)));
+                    if ((eps * t) * t > 1) {
+                        for (int j = i; j <= n; j++) {
+                            H(j, n - 1) /= t;
+                            H(j, n) /= t;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    // Back-transform: eigenvectors of A = V · (vectors of the Schur form)
+    std::vector<double> row(nn);
+    for (int i = 0; i < nn; i++) {
+        for (int j = 0; j < nn; j++) {
+            double sum = 0.0;
+            for (int k = 0; k <= j; k++) sum += V(i, k) * H(k, j);
+            row[j] = sum;
+        }
+        for (int j = 0; j < nn; j++) V(i, j) = row[j];
+    }
+    return sweeps;
+}
+
+EigenDecomposition EigenSolver::computeGeneral(const Matrix& A, bool computeVectors) {
+    steps.clear();
+    if (A.rows != A.cols) {
+        throw std::invalid_argument("Eigenvalues need a square matrix");
+    }
+    
+    const size_t n = A.rows;
+    EigenDecomposition result;
+    if (n == 0) return result;
+    
+    std::vector<double> h(n * n);
+    for (size_t i = 0; i < n; i++) {
+        std::copy(A.data[i].begin(), A.data[i].end(), h.begin() + i * n);
+    }
+    
+    std::vector<double> scale = balance(h, n);
+    steps.push_back({"Balancing", "B = D⁻¹·A·D with power-of-two diagonal D"});
+    
+    std::vector<double> v;
+    if (computeVectors) v.resize(n * n);
+    hessenberg(h, n, computeVectors ? &v : nullptr);
+    steps.push_back({"Householder reduction", "B = Q·H·Qᵀ, H upper Hessenberg (" +
+                     std::to_string(n) + "×" + std::to_string(n) + ")"});
+    
+    std::vector<double> d(n), e(n);
+    result.iterations = francisQR(h, n, d, e, computeVectors ? &v : nullptr);
+    steps.push_back({"Francis double-shift QR", "H → quasi-triangular Schur form after " +
+                     std::to_string(result.iterations) + " sweeps"});
+    
+    for (size_t j = 0; j < n; j++) {
+        result.values.emplace_back(d[j], e[j]);
+    }
+    
+    if (computeVectors) {
+        // Real eigenvalue: column j. Pair with e[j] > 0: columns j ± i·(j+1).
+        // Undo balancing (x = D·y) and normalize.
+        for (size_t j = 0; j < n; j++) {
+            std::vector<std::complex<double>> vec(n);
+            if (e[j] == 0.0) {
+                for (size_t i = 0; i < n; i++) vec[i] = scale[i] * v[i * n + j];
+            } else if (e[j] > 0.0) {
+                for (size_t i = 0; i < n; i++) vec[i] = scale[i] * std::complex<double>(v[i * n + j], v[i * n + j + 1]);
+            } else {
+                for (size_t i = 0; i < n; i++) vec[i] = scale[i] * std::complex<double>(v[i * n + j - 1], -v[i * n + j]);
+            }
+            
+            double norm = 0.0;
+            for (const auto& c : vec) norm += std::norm(c);
+            norm = std::sqrt(norm);
+            if (norm > 0.0) {
+                for (auto& c : vec) c /= norm;
+            }
+            result.vectors.push_back(std::move(vec));
+        }
+    }
+    
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(4);
+    size_t shown = std::min<size_t>(n, 8);
+    for (size_t i = 0; i < shown; i++) {
+        if (i > 0) oss << ", ";
+        oss << "λ" << (i + 1) << " = " << result.values[i].real();
+        if (result.values[i].imag() != 0.0) {
+            oss << (result.values[i].imag() > 0 ? " + " : " - ") << std::abs(result.values[i].imag()) << "i";
+        }
+    }
+    if (n > shown) oss << ", ... (" << n << " total)";
+    steps.push_back({"Eigenvalues", oss.str()});
+    return result;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <complex>
+#include <vector>
+#include "eigenvalues.h"
+#include "matrix_operations.h"
+
+struct EigenDecomposition {
+    // Symmetric input: real, ascending. General input: complex conjugate
+    // pairs are adjacent with the positive imaginary part first.
+    std::vector<std::complex<double>> values;
+    
+    // vectors[j] is the unit-norm eigenvector for values[j]; empty unless
+    // eigenvectors were requested. Real (zero imaginary parts) and mutually
+    // orthogonal in the symmetric case.
+    std::vector<std::vector<std::complex<double>>> vectors;
+    
+    bool symmetric = false;
+    int iterations = 0;     // QR/QL sweeps performed
+};
+
+// Dense eigensolver for n×n Matrix. Work is done on a contiguous copy.
+//  - Symmetric: Householder tridiagonalization, then implicit QL with
+//    Wilkinson shifts on the tridiagonal. The QL stage is O(n²) for values
+//    only, so the O(n³) reduction dominates either way.
+//  - General: balancing, Householder reduction to upper Hessenberg form,
+//    then Francis implicit double-shift QR; eigenvectors by back-substitution
+//    on the quasi-triangular Schur form.
+// Skipping eigenvectors skips every transformation accumulation and
+// restricts QR sweeps to the active block. Throws std::invalid_argument for
+// non-square input and std::runtime_error if QR fails to converge.
+class EigenSolver {
+private:
+    std::vector<EigenStep> steps;
+
+public:
+    // Chooses the symmetric path when A equals its transpose (to rounding)
+    EigenDecomposition compute(const Matrix& A, bool computeVectors = false);
+    EigenDecomposition computeSymmetric(const Matrix& A, bool computeVectors = false);
+    EigenDecomposition computeGeneral(const Matrix& A, bool computeVectors = false);
+    
+    static bool isSymmetric(const Matrix& A);
+    
+    const std::vector<EigenStep>& getSteps() const { return steps; }
+    void clearSteps() { steps.clear(); }
+};
@@ -0,0 +1,407 @@
+#include "expression_program.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+using OpCode = ExpressionProgram::OpCode;
+
+static bool isUnary(OpCode op) {
+    return op >= OpCode::SQUARE;
+}
+
+static OpCode toOpCode(BinaryOp op) {
+    switch (op) {
+        case BinaryOp::ADD: return OpCode::ADD;
+        case BinaryOp::SUB: return OpCode::SUB;
+        case BinaryOp::MUL: return OpCode::MUL;
+        case BinaryOp::DIV: return OpCode::DIV;
+        case BinaryOp::POW: return OpCode::POW;
+    }
+    return OpCode::ADD;
+}
+
+static OpCode toOpCode(UnaryFunc func) {
+    switch (func) {
+        case UnaryFunc::SIN: return OpCode::SIN;
+        case UnaryFunc::COS: return OpCode::COS;
+        case UnaryFunc::TAN: return OpCode::TAN;
+        case UnaryFunc::EXP: return OpCode::EXP;
+        case UnaryFunc::LN: return OpCode::LN;
+        case UnaryFunc::SQRT: return OpCode::SQRT;
+    }
+    return OpCode::SIN;
+}
+
+static inline double apply(OpCode op, double a, double b) {
+    switch (op) {
+        case OpCode::ADD: return a + b;
+        case OpCode::SUB: return a - b;
+        case OpCode::MUL: return a * b;
+        case OpCode::DIV: return a / b;
+        case OpCode::POW: return std::pow(a, b);
+        case OpCode::SQUARE: return a * a;
+        case OpCode::NEGATE: return -a;
+        case OpCode::SIN: return std::sin(a);
+        case OpCode::COS: return std::cos(a);
+        case OpCode::TAN: return std::tan(a);
+        case OpCode::EXP: return std::exp(a);
+        case OpCode::LN: return std::log(a);
+        case OpCode::SQRT: return std::sqrt(a);
+    }
+    return 0.0;
+}
+
+// z^b by repeated squaring when b is a small integer, which is exact for
+// polynomials in s and far cheaper than exp(b·log z)
+static std::complex<double> complexPower(std::complex<double> z, std::complex<double> b) {
+    double exponent = b.real();
+    if (b.imag() == 0.0 && exponent == std::floor(exponent) && std::abs(exponent) <= 64.0) {
+        unsigned int k = static_cast<unsigned int>(std::abs(exponent));
+        std::complex<double> result = 1.0;
+        std::complex<double> base = z;
+        while (k > 0) {
+            if (k & 1u) result *= base;
+            base *= base;
+            k >>= 1;
+        }
+        return exponent < 0.0 ? 1.0 / result : result;
+    }
+    return std::pow(z, b);
+}
+
+static inline std::complex<double> apply(OpCode op, std::complex<double> a, std::complex<double> b) {
+    switch (op) {
+        case OpCode::ADD: return a + b;
+        case OpCode::SUB: return a - b;
+        case OpCode::MUL: return a * b;
+        case OpCode::DIV: return a / b;
+        case OpCode::POW: return complexPower(a, b);
+        case OpCode::SQUARE: return a * a;
+        case OpCode::NEGATE: return -a;
+        case OpCode::SIN: return std::sin(a);
+        case OpCode::COS: return std::cos(a);
+        case OpCode::TAN: return std::tan(a);
+        case OpCode::EXP: return std::exp(a);
+        case OpCode::LN: return std::log(a);
+        case OpCode::SQRT: return std::sqrt(a);
+    }
+    return 0.0;
+}
+
+// Builds the register file and instruction list, assigning each distinct
+// (operation, operands) pair one slot
+class ProgramBuilder {
+public:
+    std::vector<double> registers;
+    std::vector<bool> constant;
+    std::vector<ExpressionProgram::Instruction> instructions;
+    size_t shared = 0;
+
+private:
+    std::map<uint64_t, uint32_t> constants;     // Keyed by bit pattern
+    std::map<std::tuple<OpCode, uint32_t, uint32_t>, uint32_t> computed;
+    
+    uint32_t newSlot(double value, bool isConstant) {
+        registers.push_back(value);
+        constant.push_back(isConstant);
+        return static_cast<uint32_t>(registers.size() - 1);
+    }
+
+public:
+    uint32_t addVariable() {
+        return newSlot(0.0, false);
+    }
+    
+    uint32_t addConstant(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        auto found = constants.find(bits);
+        if (found != constants.end()) return found->second;
+        uint32_t slot = newSlot(value, true);
+        constants.emplace(bits, slot);
+        return slot;
+    }
+    
+    uint32_t addOperation(OpCode op, uint32_t a, uint32_t b) {
+        if (isUnary(op)) {
+            b = 0;
+        } else if ((op == OpCode::ADD || op == OpCode::MUL) && a > b) {
+            std::swap(a, b);    // Commutative: one canonical operand order
+        }
+        if (constant[a] && (isUnary(op) || constant[b])) {
+            return addConstant(apply(op, registers[a], registers[b]));
+        }
+        
+        // Strength reduction for the forms the parser produces: -u is (-1)·u
+        if (op == OpCode::MUL && (constant[a] || constant[b])) {
+            uint32_t factor = constant[a] ? a : b;
+            if (registers[factor] == -1.0) {
+                return addOperation(OpCode::NEGATE, factor == a ? b : a, 0);
+            }
+        }
+        if (op == OpCode::POW && constant[b] && registers[b] == 2.0) {
+            return addOperation(OpCode::SQUARE, a, 0);
+        }
+        
+        auto key = std::make_tuple(op, a, b);
+        auto found = computed.find(key);
+        if (found != computed.end()) {
+            shared++;
+            return found->second;
+        }
+        uint32_t slot = newSlot(0.0, false);
+        instructions.push_back({op, slot, a, b});
+        computed.emplace(key, slot);
+        return slot;
+    }
+};
+
+ExpressionProgram::ExpressionProgram(const std::vector<const ASTNode*>& expressions,
+                                     const std::vector<std::string>& variableNames)
+    : variableCount(variableNames.size()), variables(variableNames) {
+    ProgramBuilder builder;
+    for (size_t i = 0; i < variableCount; i++) {
+        builder.addVariable();
+    }
+    
+    // Post-order walk with an explicit stack, as in ast_traversal
+    struct Task {
+        const ASTNode* node;
+        bool expanded;
+    };
+    std::vector<Task> tasks;
+    std::vector<uint32_t> slots;
+    for (const ASTNode* root : expressions) {
+        tasks.push_back({root, false});
+        while (!tasks.empty()) {
+            Task task = tasks.back();
+            tasks.pop_back();
+            const ASTNode* node = task.node;
+            
+            switch (node->type) {
+                case NodeType::NUMBER:
+                    slots.push_back(builder.addConstant(static_cast<const NumberNode*>(node)->value));
+                    break;
+                
+                case NodeType::VARIABLE: {
+                    const std::string& name = static_cast<const VariableNode*>(node)->name;
+                    size_t index = 0;
+                    while (index < variableCount && variables[index] != name) index++;
+                    if (index == variableCount) {
+                        std::string known;
+                        for (const std::string& variable : variables) {
+                            known += (known.empty() ? "" : ", ") + variable;
+                        }
+                        throw std::invalid_argument("Unknown variable '" + name + "' (expected one of: " + known + ")");
+                    }
+                    slots.push_back(static_cast<uint32_t>(index));
+                    break;
+                }
+                
+                case NodeType::BINARY_OP: {
+                    auto binOp = static_cast<const BinaryOpNode*>(node);
+                    if (!task.expanded) {
+                        tasks.push_back({node, true});
+                        tasks.push_back({binOp->right.get(), false});
+                        tasks.push_back({binOp->left.get(), false});
+                    } else {
+                        uint32_t right = slots.back();
+                        slots.pop_back();
+                        slots.back() = builder.addOperation(toOpCode(binOp->op), slots.back(), right);
+                    }
+                    break;
+                }
+                
+                case NodeType::UNARY_FUNC: {
+                    auto funcNode = static_cast<const UnaryFuncNode*>(node);
+                    if (!task.expanded) {
+                        tasks.push_back({node, true});
+                        tasks.push_back({funcNode->arg.get(), false});
+                    } else {
+                        slots.back() = builder.addOperation(toOpCode(funcNode->func), slots.back(), 0);
+                    }
+                    break;
+                }
+            }
+        }
+        outputSlots.push_back(slots.back());
+        slots.pop_back();
+    }
+    
+    instructions = std::move(builder.instructions);
+    initialRegisters = std::move(builder.registers);
+    constantSlot = std::move(builder.constant);
+    sharedCount = builder.shared;
+}
+
+std::vector<std::string> ExpressionProgram::variablesOf(const ASTNode* root) {
+    std::vector<std::string> names;
+    std::vector<const ASTNode*> stack{root};
+    while (!stack.empty()) {
+        const ASTNode* node = stack.back();
+        stack.pop_back();
+        switch (node->type) {
+            case NodeType::NUMBER:
+                break;
+            case NodeType::VARIABLE: {
+                const std::string& name = static_cast<const VariableNode*>(node)->name;
+                if (std::find(names.begin(), names.end(), name) == names.end()) {
+                    names.push_back(name);
+                }
+                break;
+            }
+            case NodeType::BINARY_OP: {
+                auto binOp = static_cast<const BinaryOpNode*>(node);
+                stack.push_back(binOp->right.get());
+                stack.push_back(binOp->left.get());
+                break;
+            }
+            case NodeType::UNARY_FUNC:
+                stack.push_back(static_cast<const UnaryFuncNode*>(node)->arg.get());
+                break;
+        }
+    }
+    return names;
+}
+
+void ExpressionProgram::prepare(std::vector<double>& registers) const {
+    // Constants are never written, so they only need copying in once
+    if (registers.size() != initialRegisters.size()) {
+        registers = initialRegisters;
+    }
+}
+
+void ExpressionProgram::evaluate(const double* inputs, double* outputs, std::vector<double>& registers) const {
+    prepare(registers);
+    double* r = registers.data();
+    for (size_t i = 0; i < variableCount; i++) {
+        r[i] = inputs[i];
+    }
+    for (const Instruction& instruction : instructions) {
+        r[instruction.result] = apply(instruction.op, r[instruction.a], r[instruction.b]);
+    }
+    for (size_t i = 0; i < outputSlots.size(); i++) {
+        outputs[i] = r[outputSlots[i]];
+    }
+}
+
+void ExpressionProgram::evaluateBlock(const double* inputs, size_t count, double* outputs,
+                                      std::vector<double>& registers) const {
+    const size_t B = kBlockSize;
+    if (registers.size() != initialRegisters.size() * B) {
+        // Register k occupies [k·B, (k+1)·B); constants are broadcast once
+        registers.resize(initialRegisters.size() * B);
+        for (size_t k = 0; k < initialRegisters.size(); k++) {
+            std::fill(registers.begin() + k * B, registers.begin() + (k + 1) * B, initialRegisters[k]);
+        }
+    }
+    double* r = registers.data();
+    
+    for (size_t begin = 0; begin < count; begin += B) {
+        const size_t n = std::min(B, count - begin);
+        for (size_t v = 0; v < variableCount; v++) {
+            std::memcpy(r + v * B, inputs + v * count + begin, n * sizeof(double));
+        }
+        for (const Instruction& instruction : instructions) {
+            double* out = r + instruction.result * B;
+            const double* a = r + instruction.a * B;
+            const double* b = r + instruction.b * B;
+            switch (instruction.op) {
+                case OpCode::ADD: for (size_t p = 0; p < n; p++) out[p] = a[p] + b[p]; break;
+                case OpCode::SUB: for (size_t p = 0; p < n; p++) out[p] = a[p] - b[p]; break;
+                case OpCode::MUL: for (size_t p = 0; p < n; p++) out[p] = a[p] * b[p]; break;
+                case OpCode::DIV: for (size_t p = 0; p < n; p++) out[p] = a[p] / b[p]; break;
+                case OpCode::SQUARE: for (size_t p = 0; p < n; p++) out[p] = a[p] * a[p]; break;
+                case OpCode::NEGATE: for (size_t p = 0; p < n; p++) out[p] = -a[p]; break;
+                case OpCode::SQRT: for (size_t p = 0; p < n; p++) out[p] = std::sqrt(a[p]); break;
+                default:
+                    for (size_t p = 0; p < n; p++) out[p] = apply(instruction.op, a[p], b[p]);
+                    break;
+            }
+        }
+        for (size_t i = 0; i < outputSlots.size(); i++) {
+            std::memcpy(outputs + i * count + begin, r + outputSlots[i] * B, n * sizeof(double));
+        }
+    }
+}
+
+void ExpressionProgram::evaluate(const std::complex<double>* inputs, std::complex<double>* outputs,
+                                 std::vector<std::complex<double>>& registers) const {
+    if (registers.size() != initialRegisters.size()) {
+        registers.assign(initialRegisters.begin(), initialRegisters.end());
+    }
+    std::complex<double>* r = registers.data();
+    for (size_t i = 0; i < variableCount; i++) {
+        r[i] = inputs[i];
+    }
+    for (const Instruction& instruction : instructions) {
+        r[instruction.result] = apply(instruction.op, r[instruction.a], r[instruction.b]);
+    }
+    for (size_t i = 0; i < outputSlots.size(); i++) {
+        outputs[i] = r[outputSlots[i]];
+    }
+}
+
+void ExpressionProgram::evaluateWithJacobian(const double* inputs, double* outputs, double* jacobian,
+                                             std::vector<double>& registers, std::vector<double>& gradients) const {
+    const size_t m = variableCount;
+    if (gradients.size() != initialRegisters.size() * m) {
+        // Variables seed unit gradients, constants zero; neither is overwritten
+        gradients.assign(initialRegisters.size() * m, 0.0);
+        for (size_t i = 0; i < m; i++) {
+            gradients[i * m + i] = 1.0;
+        }
+    }
+    prepare(registers);
+    double* r = registers.data();
+    for (size_t i = 0; i < m; i++) {
+        r[i] = inputs[i];
+    }
+    
+    for (const Instruction& instruction : instructions) {
+        const double a = r[instruction.a];
+        const double b = r[instruction.b];
+        const double value = apply(instruction.op, a, b);
+        r[instruction.result] = value;
+        
+        // d(value) = da·ga + db·gb
+        double da = 0.0, db = 0.0;
+        switch (instruction.op) {
+            case OpCode::ADD: da = 1.0; db = 1.0; break;
+            case OpCode::SUB: da = 1.0; db = -1.0; break;
+            case OpCode::MUL: da = b; db = a; break;
+            case OpCode::DIV: da = 1.0 / b; db = -value / b; break;
+            case OpCode::POW:
+                da = b * std::pow(a, b - 1.0);
+                // a^b·ln a; left at zero for a constant exponent so a ≤ 0 stays finite
+                db = constantSlot[instruction.b] ? 0.0 : value * std::log(a);
+                break;
+            case OpCode::SQUARE: da = 2.0 * a; break;
+            case OpCode::NEGATE: da = -1.0; break;
+            case OpCode::SIN: da = std::cos(a); break;
+            case OpCode::COS: da = -std::sin(a); break;
+            case OpCode::TAN: da = 1.0 + value * value; break;
+            case OpCode::EXP: da = value; break;
+            case OpCode::LN: da = 1.0 / a; break;
+            case OpCode::SQRT: da = 0.5 / value; break;
+        }
+        
+        double* g = gradients.data() + static_cast<size_t>(instruction.result) * m;
+        const double* ga = gradients.data() + static_cast<size_t>(instruction.a) * m;
+        if (isUnary(instruction.op) || db == 0.0) {
+            for (size_t j = 0; j < m; j++) g[j] = da * ga[j];
+        } else {
+            const double* gb = gradients.data() + static_cast<size_t>(instruction.b) * m;
+            for (size_t j = 0; j < m; j++) g[j] = da * ga[j] + db * gb[j];
+        }
+    }
+    
+    for (size_t i = 0; i < outputSlots.size(); i++) {
+        outputs[i] = r[outputSlots[i]];
+        const double* g = gradients.data() + static_cast<size_t>(outputSlots[i]) * m;
+        std::copy(g, g + m, jacobian + i * m);
+    }
+}
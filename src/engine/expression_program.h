@@ -0,0 +1,79 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ast.h"
+
+// Straight-line program compiled from several expression trees over named
+// variables, for evaluating a vector of expressions many times (e.g. the
+// right-hand side of an ODE system at every stage). Identical subexpressions
+// across all outputs are computed once, constant subtrees are folded, and
+// evaluation is a single pass over a flat register file with no tree walking
+// or allocation. Derivatives with respect to every variable come from the
+// same pass in forward mode (automatic differentiation).
+class ExpressionProgram {
+public:
+    enum class OpCode : uint8_t {
+        ADD, SUB, MUL, DIV, POW, SQUARE, NEGATE,
+        SIN, COS, TAN, EXP, LN, SQRT
+    };
+    
+    struct Instruction {
+        OpCode op;
+        uint32_t result;
+        uint32_t a;
+        uint32_t b;     // Unused by unary operations
+    };
+
+private:
+    size_t variableCount;
+    std::vector<std::string> variables;
+    std::vector<Instruction> instructions;
+    std::vector<uint32_t> outputSlots;
+    std::vector<double> initialRegisters;   // Constants in place, variables zero
+    std::vector<bool> constantSlot;
+    size_t sharedCount = 0;
+    
+    void prepare(std::vector<double>& registers) const;
+
+public:
+    // Compiles each expression against the given variable names. Throws
+    // std::invalid_argument for a variable not in the list.
+    ExpressionProgram(const std::vector<const ASTNode*>& expressions, const std::vector<std::string>& variableNames);
+    
+    // outputs[i] = value of expression i at the given variable values. The
+    // register workspace is sized on first use; keep one per thread.
+    void evaluate(const double* inputs, double* outputs, std::vector<double>& registers) const;
+    
+    // Same at complex inputs, with principal branches for ln, sqrt and
+    // non-integer powers (e.g. a transform F(s) off the real axis)
+    void evaluate(const std::complex<double>* inputs, std::complex<double>* outputs,
+                  std::vector<std::complex<double>>& registers) const;
+    
+    // Many points at once: inputs[v·count + p] is variable v at point p and
+    // outputs[i·count + p] receives expression i. Registers hold a run of
+    // kBlockSize points each, so every instruction is one tight loop over
+    // the points (vectorised for arithmetic) instead of one dispatch per
+    // point.
+    static constexpr size_t kBlockSize = 256;
+    void evaluateBlock(const double* inputs, size_t count, double* outputs, std::vector<double>& registers) const;
+    
+    // Values as above, plus jacobian (outputs × variables, row-major) with
+    // jacobian[i·variables + j] = ∂ expression i / ∂ variable j
+    void evaluateWithJacobian(const double* inputs, double* outputs, double* jacobian,
+                              std::vector<double>& registers, std::vector<double>& gradients) const;
+    
+    // Distinct variable names in a tree, in order of first appearance; for
+    // compiling a one-variable function where every name stands for x, as
+    // in ASTNode::evaluate(x)
+    static std::vector<std::string> variablesOf(const ASTNode* root);
+    
+    size_t inputCount() const { return variableCount; }
+    size_t outputCount() const { return outputSlots.size(); }
+    size_t instructionCount() const { return instructions.size(); }
+    // Subexpressions reused rather than recomputed
+    size_t sharedSubexpressions() const { return sharedCount; }
+    const std::vector<std::string>& getVariables() const { return variables; }
+};
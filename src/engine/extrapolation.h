@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Sequence extrapolation shared by the series and limit calculators.
+
+// Neville extrapolation to h = 0 of values sampled at h, h/2, h/4, ... whose
+// error has an expansion in powers of h. Returns the diagonal T_{k,k}.
+inline std::vector<double> extrapolateHalving(const std::vector<double>& values) {
+    std::vector<double> row(values.size()), diagonal;
+    diagonal.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        double previous = row[0];
+        row[0] = values[i];
+        double factor = 1.0;
+        for (size_t j = 1; j <= i; j++) {
+            factor *= 2.0;
+            double current = row[j];
+            row[j] = row[j - 1] + (row[j - 1] - previous) / (factor - 1.0);
+            previous = current;
+        }
+        diagonal.push_back(row[i]);
+    }
+    return diagonal;
+}
+
+// Wynn's ε algorithm: ε_{k+1}⁽ⁿ⁾ = ε_{k-1}⁽ⁿ⁺¹⁾ + 1/(ε_k⁽ⁿ⁺¹⁾ - ε_k⁽ⁿ⁾), built
+// one ascending diagonal per value. The estimate after each value is the
+// highest even column reached.
+inline std::vector<double> wynnEpsilon(const std::vector<double>& values) {
+    std::vector<double> estimates, previous, current;
+    estimates.reserve(values.size());
+    for (double value : values) {
+        current.assign(1, value);
+        for (size_t k = 0; k < previous.size(); k++) {
+            double difference = current[k] - previous[k];
+            if (difference == 0.0) break;
+            current.push_back((k > 0 ? previous[k - 1] : 0.0) + 1.0 / difference);
+        }
+        estimates.push_back(current[(current.size() - 1) & ~size_t(1)]);
+        previous.swap(current);
+    }
+    return estimates;
+}
@@ -1,4 +1,5 @@
 #include "fourier_series.h"
+#include "job_system.h"
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -104,6 +105,7 @@ std::string FourierSeriesCalculator::computeFourierSeries(const ASTNode* func, d
     
     // Compute coefficients
     for (int n = 1; n <= numTerms; n++) {
+        JobContext::reportProgress(n - 1, numTerms);
         double an = computeCoefficient(func, L, n, true);
         double bn = computeCoefficient(func, L, n, false);
         
@@ -0,0 +1,355 @@
+#include "iterative_solver.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+static double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+static double norm2(const std::vector<double>& a) {
+    return std::sqrt(dot(a, a));
+}
+
+static const char* preconditionerName(Preconditioner kind) {
+    switch (kind) {
+        case Preconditioner::Jacobi: return "Jacobi";
+        case Preconditioner::ILU0: return "ILU(0)";
+        default: return "none";
+    }
+}
+
+// z = M⁻¹·r for the chosen preconditioner, built once per solve
+class PreconditionerOperator {
+private:
+    Preconditioner kind;
+    std::vector<double> inverseDiagonal;
+    
+    // ILU(0): L (unit, strictly lower) and U share A's pattern and row layout
+    const std::vector<size_t>* rowStart = nullptr;
+    const std::vector<size_t>* columnIndex = nullptr;
+    std::vector<double> factors;
+    std::vector<size_t> diagonalIndex;
+    
+    void buildIncompleteLU(const SparseMatrix& A) {
+        const size_t n = A.rows();
+        rowStart = &A.getRowStart();
+        columnIndex = &A.getColumnIndex();
+        const std::vector<size_t>& start = *rowStart;
+        const std::vector<size_t>& col = *columnIndex;
+        factors = A.getValues();
+        
+        diagonalIndex.assign(n, 0);
+        for (size_t i = 0; i < n; i++) {
+            size_t k = start[i];
+            while (k < start[i + 1] && col[k] < i) k++;
+            if (k == start[i + 1] || col[k] != i) {
+                throw std::runtime_error("ILU(0) needs every diagonal entry of A to be stored");
+            }
+            diagonalIndex[i] = k;
+        }
+        
+        // IKJ elimination restricted to the pattern: position[] maps a column
+        // to its slot in the current row
+        const size_t absent = static_cast<size_t>(-1);
+        std::vector<size_t> position(n, absent);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t k = start[i]; k < start[i + 1]; k++) {
+                position[col[k]] = k;
+            }
+            for (size_t k = start[i]; k < diagonalIndex[i]; k++) {
+                size_t pivotRow = col[k];
+                factors[k] /= factors[diagonalIndex[pivotRow]];
+                double multiplier = factors[k];
+                for (size_t kk = diagonalIndex[pivotRow] + 1; kk < start[pivotRow + 1]; kk++) {
+                    size_t slot = position[col[kk]];
+                    if (slot != absent) {
+                        factors[slot] -= multiplier * factors[kk];
+                    }
+                }
+            }
+            if (factors[diagonalIndex[i]] == 0.0) {
+                throw std::runtime_error("ILU(0) broke down with a zero pivot");
+            }
+            for (size_t k = start[i]; k < start[i + 1]; k++) {
+                position[col[k]] = absent;
+            }
+        }
+    }
+
+public:
+    PreconditionerOperator(const SparseMatrix& A, Preconditioner kind) : kind(kind) {
+        if (kind == Preconditioner::Jacobi) {
+            inverseDiagonal = A.diagonal();
+            for (double& d : inverseDiagonal) {
+                if (d == 0.0) {
+                    throw std::runtime_error("Jacobi preconditioner needs a nonzero diagonal");
+                }
+                d = 1.0 / d;
+            }
+        } else if (kind == Preconditioner::ILU0) {
+            buildIncompleteLU(A);
+        }
+    }
+    
+    void apply(const std::vector<double>& r, std::vector<double>& z) const {
+        const size_t n = r.size();
+        if (kind == Preconditioner::Jacobi) {
+            for (size_t i = 0; i < n; i++) z[i] = r[i] * inverseDiagonal[i];
+        } else if (kind == Preconditioner::ILU0) {
+            const std::vector<size_t>& start = *rowStart;
+            const std::vector<size_t>& col = *columnIndex;
+            for (size_t i = 0; i < n; i++) {
+                double sum = r[i];
+                for (size_t k = start[i]; k < diagonalIndex[i]; k++) {
+                    sum -= factors[k] * z[col[k]];
+                }
+                z[i] = sum;
+            }
+            for (size_t i = n; i-- > 0;) {
+                double sum = z[i];
+                for (size_t k = diagonalIndex[i] + 1; k < start[i + 1]; k++) {
+                    sum -= factors[k] * z[col[k]];
+                }
+                z[i] = sum / factors[diagonalIndex[i]];
+            }
+        } else {
+            z = r;
+        }
+    }
+};
+
+static void validateSystem(const SparseMatrix& A, const std::vector<double>& b,
+                           const std::vector<double>& initialGuess) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Iterative solvers need a square matrix");
+    }
+    if (b.size() != A.rows() || (!initialGuess.empty() && initialGuess.size() != A.rows())) {
+        throw std::invalid_argument("Right-hand side and initial guess must have length n");
+    }
+}
+
+static std::string systemSummary(const SparseMatrix& A, const IterativeSolverOptions& options) {
+    std::ostringstream oss;
+    double density = A.rows() > 0 ? 100.0 * A.nonZeros() / (static_cast<double>(A.rows()) * A.cols()) : 0.0;
+    oss << "n = " << A.rows() << ", nonzeros = " << A.nonZeros() << " ("
+        << std::setprecision(3) << density << "% dense), preconditioner: "
+        << preconditionerName(options.preconditioner);
+    return oss.str();
+}
+
+static bool isPowerOfTwo(size_t value) {
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+// Records residuals at iterations 1, 2, 4, 8, ... so long runs stay readable
+static void recordResidual(std::ostringstream& history, size_t iteration, double residual) {
+    if (isPowerOfTwo(iteration)) {
+        if (iteration > 1) history << "\n";
+        history << "k = " << iteration << ": " << std::scientific << std::setprecision(3) << residual;
+    }
+}
+
+static void addResultStep(std::vector<MatrixStep>& steps, std::ostringstream& history,
+                          const IterativeSolution& result) {
+    if (result.iterations > 0 && !isPowerOfTwo(result.iterations)) {
+        history << "\nk = " << result.iterations << ": " << std::scientific << std::setprecision(3)
+                << result.relativeResidual;
+    }
+    steps.push_back({"Relative residual ‖b - Ax‖/‖b‖", history.str()});
+    std::ostringstream oss;
+    oss << (result.converged ? "Converged" : "Did not converge") << " after " << result.iterations
+        << " iteration" << (result.iterations == 1 ? "" : "s") << ", relative residual "
+        << std::scientific << std::setprecision(3) << result.relativeResidual;
+    steps.push_back({"Result", oss.str()});
+}
+
+IterativeSolution IterativeSolver::conjugateGradient(const SparseMatrix& A, const std::vector<double>& b,
+                                                     const IterativeSolverOptions& options,
+                                                     const std::vector<double>& initialGuess) {
+    steps.clear();
+    validateSystem(A, b, initialGuess);
+    const size_t n = A.rows();
+    const size_t maxIterations = options.maxIterations > 0 ? options.maxIterations : 10 * n;
+    
+    steps.push_back({"=== Preconditioned Conjugate Gradient ===", systemSummary(A, options)});
+    // ILU(0) of a symmetric matrix is L·D·Lᵀ, so it is a valid symmetric CG preconditioner
+    PreconditionerOperator preconditioner(A, options.preconditioner);
+    
+    IterativeSolution result;
+    result.x = initialGuess.empty() ? std::vector<double>(n, 0.0) : initialGuess;
+    double bNorm = norm2(b);
+    if (bNorm == 0.0) {
+        result.x.assign(n, 0.0);
+        result.converged = true;
+        steps.push_back({"Result", "b = 0, so x = 0"});
+        return result;
+    }
+    
+    std::vector<double> r(n), z(n), p(n), q(n);
+    A.multiply(result.x.data(), q.data());
+    for (size_t i = 0; i < n; i++) r[i] = b[i] - q[i];
+    result.relativeResidual = norm2(r) / bNorm;
+    
+    preconditioner.apply(r, z);
+    p = z;
+    double rz = dot(r, z);
+    std::ostringstream history;
+    
+    while (result.relativeResidual > options.tolerance && result.iterations < maxIterations) {
+        JobContext::reportProgress(static_cast<double>(result.iterations), static_cast<double>(maxIterations));
+        JobContext::checkpoint();
+        
+        A.multiply(p.data(), q.data());
+        double curvature = dot(p, q);
+        if (curvature <= 0.0) {
+            throw std::runtime_error("Matrix is not positive definite (pᵀAp ≤ 0); use GMRES");
+        }
+        double alpha = rz / curvature;
+        for (size_t i = 0; i < n; i++) {
+            result.x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+        }
+        result.iterations++;
+        result.relativeResidual = norm2(r) / bNorm;
+        recordResidual(history, result.iterations, result.relativeResidual);
+        
+        preconditioner.apply(r, z);
+        double rzNext = dot(r, z);
+        double beta = rzNext / rz;
+        rz = rzNext;
+        for (size_t i = 0; i < n; i++) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    
+    result.converged = result.relativeResidual <= options.tolerance;
+    addResultStep(steps, history, result);
+    return result;
+}
+
+IterativeSolution IterativeSolver::gmres(const SparseMatrix& A, const std::vector<double>& b,
+                                         const IterativeSolverOptions& options,
+                                         const std::vector<double>& initialGuess) {
+    steps.clear();
+    validateSystem(A, b, initialGuess);
+    const size_t n = A.rows();
+    const size_t maxIterations = options.maxIterations > 0 ? options.maxIterations : 10 * n;
+    const size_t m = std::max<size_t>(1, std::min(options.restart, n));
+    
+    std::ostringstream summary;
+    summary << systemSummary(A, options) << ", restart = " << m;
+    steps.push_back({"=== GMRES (right preconditioned) ===", summary.str()});
+    PreconditionerOperator preconditioner(A, options.preconditioner);
+    
+    IterativeSolution result;
+    result.x = initialGuess.empty() ? std::vector<double>(n, 0.0) : initialGuess;
+    double bNorm = norm2(b);
+    if (bNorm == 0.0) {
+        result.x.assign(n, 0.0);
+        result.converged = true;
+        steps.push_back({"Result", "b = 0, so x = 0"});
+        return result;
+    }
+    
+    // Krylov basis V (m+1 vectors), Hessenberg H ((m+1)×m, column-major),
+    // Givens rotations and the rotated residual vector g
+    std::vector<std::vector<double>> basis(m + 1, std::vector<double>(n));
+    std::vector<double> hessenberg((m + 1) * m);
+    std::vector<double> cosines(m), sines(m), g(m + 1);
+    std::vector<double> r(n), w(n), z(n);
+    std::ostringstream history;
+    
+    auto residual = [&]() {
+        A.multiply(result.x.data(), w.data());
+        for (size_t i = 0; i < n; i++) r[i] = b[i] - w[i];
+        return norm2(r);
+    };
+    
+    double beta = residual();
+    result.relativeResidual = beta / bNorm;
+    
+    while (result.relativeResidual > options.tolerance && result.iterations < maxIterations) {
+        for (size_t i = 0; i < n; i++) basis[0][i] = r[i] / beta;
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+        
+        size_t k = 0;
+        while (k < m && result.iterations < maxIterations) {
+            JobContext::reportProgress(static_cast<double>(result.iterations), static_cast<double>(maxIterations));
+            JobContext::checkpoint();
+            
+            // w = A·M⁻¹·v_k, orthogonalized by modified Gram–Schmidt
+            preconditioner.apply(basis[k], z);
+            A.multiply(z.data(), w.data());
+            double* h = &hessenberg[k * (m + 1)];
+            for (size_t j = 0; j <= k; j++) {
+                h[j] = dot(w, basis[j]);
+                for (size_t i = 0; i < n; i++) w[i] -= h[j] * basis[j][i];
+            }
+            h[k + 1] = norm2(w);
+            // A zero norm means the Krylov space is invariant: the solution is exact
+            bool breakdown = h[k + 1] == 0.0;
+            if (!breakdown) {
+                for (size_t i = 0; i < n; i++) basis[k + 1][i] = w[i] / h[k + 1];
+            }
+            
+            // Reduce column k to upper triangular with the accumulated rotations
+            for (size_t j = 0; j < k; j++) {
+                double upper = cosines[j] * h[j] + sines[j] * h[j + 1];
+                h[j + 1] = -sines[j] * h[j] + cosines[j] * h[j + 1];
+                h[j] = upper;
+            }
+            double radius = std::hypot(h[k], h[k + 1]);
+            cosines[k] = radius > 0.0 ? h[k] / radius : 1.0;
+            sines[k] = radius > 0.0 ? h[k + 1] / radius : 0.0;
+            h[k] = radius;
+            h[k + 1] = 0.0;
+            g[k + 1] = -sines[k] * g[k];
+            g[k] *= cosines[k];
+            
+            k++;
+            result.iterations++;
+            result.relativeResidual = std::abs(g[k]) / bNorm;
+            recordResidual(history, result.iterations, result.relativeResidual);
+            if (result.relativeResidual <= options.tolerance || breakdown) {
+                break;
+            }
+        }
+        
+        // x += M⁻¹·V·y with H·y = g by back substitution
+        std::vector<double> y(k);
+        for (size_t i = k; i-- > 0;) {
+            double sum = g[i];
+            for (size_t j = i + 1; j < k; j++) {
+                sum -= hessenberg[j * (m + 1) + i] * y[j];
+            }
+            double diagonal = hessenberg[i * (m + 1) + i];
+            if (diagonal == 0.0) {
+                throw std::runtime_error("GMRES breakdown: matrix is singular");
+            }
+            y[i] = sum / diagonal;
+        }
+        std::fill(w.begin(), w.end(), 0.0);
+        for (size_t j = 0; j < k; j++) {
+            for (size_t i = 0; i < n; i++) w[i] += y[j] * basis[j][i];
+        }
+        preconditioner.apply(w, z);
+        for (size_t i = 0; i < n; i++) result.x[i] += z[i];
+        
+        // The rotated estimate can drift from the true residual; restart from the latter
+        beta = residual();
+        result.relativeResidual = beta / bNorm;
+    }
+    
+    result.converged = result.relativeResidual <= options.tolerance;
+    addResultStep(steps, history, result);
+    return result;
+}
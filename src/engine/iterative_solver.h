@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "matrix_operations.h"
+#include "sparse_matrix.h"
+
+enum class Preconditioner {
+    None,
+    Jacobi,     // M = diag(A)
+    ILU0        // Incomplete LU with A's sparsity pattern, no fill-in
+};
+
+struct IterativeSolverOptions {
+    double tolerance = 1e-10;       // Stop when ‖b - Ax‖ ≤ tolerance·‖b‖
+    size_t maxIterations = 0;       // 0 = 10·n
+    size_t restart = 50;            // GMRES Krylov subspace size between restarts
+    Preconditioner preconditioner = Preconditioner::Jacobi;
+};
+
+struct IterativeSolution {
+    std::vector<double> x;
+    size_t iterations = 0;
+    double relativeResidual = 0.0;  // ‖b - Ax‖ / ‖b‖
+    bool converged = false;
+};
+
+// Krylov solvers for sparse Ax = b. Each iteration costs one sparse
+// matrix-vector product and one preconditioner application plus O(n) vector
+// work, so memory and time scale with the nonzeros. Not reaching the
+// tolerance is reported through IterativeSolution::converged; a
+// preconditioner that cannot be built (zero diagonal, ILU pivot breakdown)
+// throws std::runtime_error.
+class IterativeSolver {
+private:
+    std::vector<MatrixStep> steps;
+
+public:
+    // Preconditioned conjugate gradients; A must be symmetric positive
+    // definite (throws std::runtime_error on detecting otherwise)
+    IterativeSolution conjugateGradient(const SparseMatrix& A, const std::vector<double>& b,
+                                        const IterativeSolverOptions& options = {},
+                                        const std::vector<double>& initialGuess = {});
+    
+    // Restarted GMRES(m) with right preconditioning, for general nonsingular A
+    IterativeSolution gmres(const SparseMatrix& A, const std::vector<double>& b,
+                            const IterativeSolverOptions& options = {},
+                            const std::vector<double>& initialGuess = {});
+    
+    const std::vector<MatrixStep>& getSteps() const { return steps; }
+    void clearSteps() { steps.clear(); }
+};
@@ -0,0 +1,127 @@
+#include "job_system.h"
+#include <algorithm>
+
+static thread_local JobContext* currentJob = nullptr;
+
+JobContext* JobContext::current() {
+    return currentJob;
+}
+
+void JobContext::reportProgress(double done, double total) {
+    if (!currentJob || total <= 0) return;
+    currentJob->setProgress(static_cast<float>(std::min(1.0, std::max(0.0, done / total))));
+    if (currentJob->isCancelled()) {
+        throw JobCancelled();
+    }
+}
+
+void JobContext::checkpoint() {
+    if (currentJob && currentJob->isCancelled()) {
+        throw JobCancelled();
+    }
+}
+
+JobSystem::JobSystem(unsigned int workerCount) : inFlight(0), stopping(false) {
+    if (workerCount == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+    
+    for (unsigned int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (auto& job : queue) {
+            job.context->cancel();
+        }
+        for (auto& context : running) {
+            context->cancel();
+        }
+    }
+    workAvailable.notify_all();
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::shared_ptr<JobContext> JobSystem::submit(Work work, Completion onComplete) {
+    auto context = std::make_shared<JobContext>();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back({context, std::move(work), std::move(onComplete)});
+        inFlight++;
+    }
+    workAvailable.notify_one();
+    return context;
+}
+
+void JobSystem::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping && queue.empty()) {
+                return;
+            }
+            job = std::move(queue.front());
+            queue.pop_front();
+            running.push_back(job.context);
+        }
+        
+        if (!job.context->isCancelled()) {
+            currentJob = job.context.get();
+            try {
+                job.work(*job.context);
+                job.context->setProgress(1.0f);
+            } catch (const JobCancelled&) {
+                job.context->cancel();
+            } catch (const std::exception& e) {
+                job.context->errorMessage = e.what();
+            }
+            currentJob = nullptr;
+        }
+        
+        job.context->finished = true;
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        running.erase(std::find(running.begin(), running.end(), job.context));
+        completed.push_back(std::move(job));
+    }
+}
+
+void JobSystem::pollCompleted() {
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.swap(completed);
+        inFlight -= ready.size();
+    }
+    
+    for (auto& job : ready) {
+        if (!job.context->isCancelled() && job.onComplete) {
+            job.onComplete(*job.context);
+        }
+    }
+}
+
+bool JobSystem::hasPendingJobs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return inFlight > 0;
+}
+
+void JobSystem::cancelAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& job : queue) {
+        job.context->cancel();
+    }
+    for (auto& context : running) {
+        context->cancel();
+    }
+}
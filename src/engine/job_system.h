@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Thrown from JobContext::checkpoint() when the job running on this thread was cancelled
+class JobCancelled : public std::runtime_error {
+public:
+    JobCancelled() : std::runtime_error("Computation cancelled") {}
+};
+
+class JobContext {
+private:
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> finished{false};
+    std::atomic<float> progress{0.0f};
+    std::string errorMessage;  // Written by the worker before 'finished' is set
+    
+    friend class JobSystem;
+    
+public:
+    void cancel() { cancelled = true; }
+    bool isCancelled() const { return cancelled; }
+    bool isFinished() const { return finished; }
+    float getProgress() const { return progress; }
+    void setProgress(float p) { progress = p; }
+    
+    // Only valid once isFinished() is true
+    const std::string& getError() const { return errorMessage; }
+    
+    // Engine-side hooks. They act on the job running on the calling thread
+    // and are no-ops when the engine is called directly from the UI thread.
+    static JobContext* current();
+    static void reportProgress(double done, double total);
+    static void checkpoint();  // Throws JobCancelled if the current job was cancelled
+};
+
+class JobSystem {
+public:
+    using Work = std::function<void(JobContext&)>;
+    using Completion = std::function<void(const JobContext&)>;
+    
+    // workerCount = 0 picks one less than the hardware concurrency (at least 1)
+    explicit JobSystem(unsigned int workerCount = 0);
+    ~JobSystem();
+    
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    
+    // Queue work for a worker thread. onComplete runs later on the thread that
+    // calls pollCompleted(), unless the job was cancelled in the meantime.
+    std::shared_ptr<JobContext> submit(Work work, Completion onComplete);
+    
+    // Run completion callbacks of finished jobs (call once per frame from the UI thread)
+    void pollCompleted();
+    
+    bool hasPendingJobs() const;
+    void cancelAll();
+    
+private:
+    struct Job {
+        std::shared_ptr<JobContext> context;
+        Work work;
+        Completion onComplete;
+    };
+    
+    std::vector<std::thread> workers;
+    std::deque<Job> queue;
+    std::vector<std::shared_ptr<JobContext>> running;
+    std::vector<Job> completed;
+    size_t inFlight;
+    bool stopping;
+    
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    
+    void workerLoop();
+};
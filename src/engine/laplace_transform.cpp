@@ -1,6 +1,45 @@
 #include "laplace_transform.h"
+#include "expression_program.h"
+#include "parallel.h"
+#include "parser.h"
+#include "polynomial_operations.h"
+#include "step_format.h"
+#include "taylor_series.h"
 #include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+// exp-sinh quadrature: nodes x = exp(π/2·sinh u) for u in [kMinU, kMaxU],
+// spacing halved per level
+static const double kMinU = -6.5;
+static const double kMaxU = 4.0;
+static const int kMaxQuadratureLevel = 8;
+
+// Points used as a check alongside the symbolic results
+static const double kCheckPoints[] = {0.5, 1.0, 2.0, 5.0};
+// Quadrature level difference, relative to max(1, |F(s)|), above which a
+// check value is shown as not converged
+static const double kCheckTolerance = 1e-6;
+// Highest degree of a denominator that is located as a polynomial in s
+static const int kMaxPoleDegree = 12;
+
+static ExpressionProgram compileIn(const std::string& expression, const std::string& variable) {
+    Parser parser;
+    std::unique_ptr<ASTNode> tree = parser.parse(expression);
+    return ExpressionProgram({tree.get()}, {variable});
+}
+
+static std::string inversionDescription(const NumericLaplaceOptions& options) {
+    if (options.method == InversionMethod::GaverStehfest) {
+        return "Gaver–Stehfest with N = " + std::to_string(options.stehfestTerms) + " terms";
+    }
+    return "Fixed Talbot contour with M = " + std::to_string(options.talbotNodes) + " nodes";
+}
 
 LaplaceTransform::LaplaceTransform() {
     initializeTransformTable();
@@ -48,6 +87,411 @@ std::string LaplaceTransform::lookupTransform(const std::string& function) {
     return "L{" + function + "}";
 }
 
+// Upper bounds that keep structural matching linear in the input: a product
+// expanding past kMaxTerms terms, or t^n beyond kMaxPower, falls back
+static const size_t kMaxTerms = 100000;
+static const int kMaxPower = 20;
+static const size_t kMaxCachedSubexpressions = 4096;
+static const size_t kShownTerms = 12;
+
+static bool isConstant(const std::vector<LaplaceTerm>& terms, double& value) {
+    value = 0.0;
+    for (const LaplaceTerm& term : terms) {
+        if (term.power != 0 || term.rate != 0.0 || term.oscillation != LaplaceOscillation::NONE) return false;
+        value += term.coefficient;
+    }
+    return true;
+}
+
+// α·t + β
+static bool isLinear(const std::vector<LaplaceTerm>& terms, double& alpha, double& beta) {
+    alpha = beta = 0.0;
+    for (const LaplaceTerm& term : terms) {
+        if (term.power > 1 || term.rate != 0.0 || term.oscillation != LaplaceOscillation::NONE) return false;
+        (term.power == 1 ? alpha : beta) += term.coefficient;
+    }
+    return true;
+}
+
+static LaplaceTerm constantTerm(double value) {
+    return {value, 0, 0.0, LaplaceOscillation::NONE, 0.0};
+}
+
+// sin(-bt) = -sin(bt), cos(-bt) = cos(bt), sin(0) = 0, cos(0) = 1
+static void appendNormalized(LaplaceTerm term, std::vector<LaplaceTerm>& out) {
+    if (term.oscillation != LaplaceOscillation::NONE && term.frequency < 0.0) {
+        term.frequency = -term.frequency;
+        if (term.oscillation == LaplaceOscillation::SIN) term.coefficient = -term.coefficient;
+    }
+    if (term.oscillation != LaplaceOscillation::NONE && term.frequency == 0.0) {
+        if (term.oscillation == LaplaceOscillation::SIN) return;
+        term.oscillation = LaplaceOscillation::NONE;
+    }
+    if (term.coefficient != 0.0) out.push_back(term);
+}
+
+// Product of two terms; two oscillations combine by product-to-sum
+static void multiplyTerms(const LaplaceTerm& x, const LaplaceTerm& y, std::vector<LaplaceTerm>& out) {
+    LaplaceTerm base{x.coefficient * y.coefficient, x.power + y.power, x.rate + y.rate,
+                     LaplaceOscillation::NONE, 0.0};
+    if (y.oscillation == LaplaceOscillation::NONE || x.oscillation == LaplaceOscillation::NONE) {
+        const LaplaceTerm& oscillating = x.oscillation == LaplaceOscillation::NONE ? y : x;
+        base.oscillation = oscillating.oscillation;
+        base.frequency = oscillating.frequency;
+        appendNormalized(base, out);
+        return;
+    }
+    
+    const bool xSin = x.oscillation == LaplaceOscillation::SIN;
+    const bool ySin = y.oscillation == LaplaceOscillation::SIN;
+    LaplaceTerm difference = base, sum = base;
+    difference.coefficient *= 0.5;
+    sum.coefficient *= 0.5;
+    if (xSin && ySin) {
+        // sin a·sin b = ½cos(a - b) - ½cos(a + b)
+        difference.oscillation = sum.oscillation = LaplaceOscillation::COS;
+        difference.frequency = x.frequency - y.frequency;
+        sum.frequency = x.frequency + y.frequency;
+        sum.coefficient = -sum.coefficient;
+    } else if (!xSin && !ySin) {
+        // cos a·cos b = ½cos(a - b) + ½cos(a + b)
+        difference.oscillation = sum.oscillation = LaplaceOscillation::COS;
+        difference.frequency = x.frequency - y.frequency;
+        sum.frequency = x.frequency + y.frequency;
+    } else {
+        // sin a·cos b = ½sin(a + b) + ½sin(a - b)
+        const LaplaceTerm& sine = xSin ? x : y;
+        const LaplaceTerm& cosine = xSin ? y : x;
+        difference.oscillation = sum.oscillation = LaplaceOscillation::SIN;
+        difference.frequency = sine.frequency - cosine.frequency;
+        sum.frequency = sine.frequency + cosine.frequency;
+    }
+    appendNormalized(difference, out);
+    appendNormalized(sum, out);
+}
+
+static bool multiplyLists(const std::vector<LaplaceTerm>& x, const std::vector<LaplaceTerm>& y,
+                          std::vector<LaplaceTerm>& out) {
+    out.clear();
+    if (x.size() * y.size() > kMaxTerms) return false;
+    for (const LaplaceTerm& a : x) {
+        for (const LaplaceTerm& b : y) {
+            if (a.power + b.power > kMaxPower) return false;
+            multiplyTerms(a, b, out);
+        }
+    }
+    return true;
+}
+
+// Sums terms that differ only in coefficient, keeping first-seen order
+static void combineLikeTerms(std::vector<LaplaceTerm>& terms) {
+    struct Key {
+        int power;
+        double rate;
+        LaplaceOscillation oscillation;
+        double frequency;
+        bool operator==(const Key& other) const {
+            return power == other.power && rate == other.rate && oscillation == other.oscillation &&
+                   frequency == other.frequency;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = std::hash<double>()(key.rate);
+            h = h * 31 + std::hash<double>()(key.frequency);
+            return h * 31 + static_cast<size_t>(key.power) * 3 + static_cast<size_t>(key.oscillation);
+        }
+    };
+    std::unordered_map<Key, size_t, KeyHash> index;
+    std::vector<LaplaceTerm> combined;
+    for (const LaplaceTerm& term : terms) {
+        Key key{term.power, term.rate, term.oscillation, term.frequency};
+        auto found = index.find(key);
+        if (found == index.end()) {
+            index.emplace(key, combined.size());
+            combined.push_back(term);
+        } else {
+            combined[found->second].coefficient += term.coefficient;
+        }
+    }
+    terms.clear();
+    for (const LaplaceTerm& term : combined) {
+        if (term.coefficient != 0.0) terms.push_back(term);
+    }
+}
+
+// Cache key of a subtree in prefix form. Numbers are written in hex-float
+// (%a), which is exact: the printed form rounds to 6 decimals, so distinct
+// constants would share a key.
+static void appendStructuralKey(const ASTNode* root, std::string& key) {
+    std::vector<const ASTNode*> stack{root};
+    char number[32];
+    while (!stack.empty()) {
+        const ASTNode* node = stack.back();
+        stack.pop_back();
+        switch (node->type) {
+            case NodeType::NUMBER:
+                std::snprintf(number, sizeof(number), "#%a;", static_cast<const NumberNode*>(node)->value);
+                key += number;
+                break;
+            case NodeType::VARIABLE:
+                key += '$';
+                key += static_cast<const VariableNode*>(node)->name;
+                key += ';';
+                break;
+            case NodeType::BINARY_OP: {
+                auto binOp = static_cast<const BinaryOpNode*>(node);
+                key += 'b';
+                key += static_cast<char>('0' + static_cast<int>(binOp->op));
+                stack.push_back(binOp->right.get());
+                stack.push_back(binOp->left.get());
+                break;
+            }
+            case NodeType::UNARY_FUNC: {
+                auto unary = static_cast<const UnaryFuncNode*>(node);
+                key += 'u';
+                key += static_cast<char>('0' + static_cast<int>(unary->func));
+                stack.push_back(unary->arg.get());
+                break;
+            }
+        }
+    }
+}
+
+// Takes f(t) apart into terms with an explicit stack (sums of many terms
+// parse as deep left-leaning trees). Products and function calls are looked
+// up in termCache by structural key before being decomposed.
+bool LaplaceTransform::decompose(const ASTNode* root, std::vector<LaplaceTerm>& terms) {
+    struct Task {
+        const ASTNode* node;
+        bool expanded;
+        std::string key;    // Cache key of a product or call, empty otherwise
+    };
+    std::vector<Task> tasks;
+    std::vector<std::vector<LaplaceTerm>> values;
+    
+    tasks.push_back({root, false, std::string()});
+    while (!tasks.empty()) {
+        Task task = std::move(tasks.back());
+        tasks.pop_back();
+        const ASTNode* node = task.node;
+        
+        if (node->type == NodeType::NUMBER) {
+            values.push_back({constantTerm(static_cast<const NumberNode*>(node)->value)});
+            continue;
+        }
+        if (node->type == NodeType::VARIABLE) {
+            if (static_cast<const VariableNode*>(node)->name != "t") return false;
+            values.push_back({{1.0, 1, 0.0, LaplaceOscillation::NONE, 0.0}});
+            continue;
+        }
+        
+        const bool additive = node->type == NodeType::BINARY_OP &&
+            (static_cast<const BinaryOpNode*>(node)->op == BinaryOp::ADD ||
+             static_cast<const BinaryOpNode*>(node)->op == BinaryOp::SUB);
+        if (!task.expanded) {
+            std::string key;
+            if (!additive) {
+                appendStructuralKey(node, key);
+                auto cached = termCache.find(key);
+                if (cached != termCache.end()) {
+                    values.push_back(cached->second);
+                    continue;
+                }
+            }
+            tasks.push_back({node, true, std::move(key)});
+            if (node->type == NodeType::BINARY_OP) {
+                auto binOp = static_cast<const BinaryOpNode*>(node);
+                tasks.push_back({binOp->right.get(), false, std::string()});
+                tasks.push_back({binOp->left.get(), false, std::string()});
+            } else {
+                tasks.push_back({static_cast<const UnaryFuncNode*>(node)->arg.get(), false, std::string()});
+            }
+            continue;
+        }
+        
+        std::vector<LaplaceTerm> result;
+        if (node->type == NodeType::BINARY_OP) {
+            std::vector<LaplaceTerm> right = std::move(values.back());
+            values.pop_back();
+            std::vector<LaplaceTerm>& left = values.back();
+            double constant, alpha, beta;
+            
+            switch (static_cast<const BinaryOpNode*>(node)->op) {
+                case BinaryOp::ADD:
+                case BinaryOp::SUB: {
+                    // Linearity: append in place so a long sum stays linear
+                    const double sign = static_cast<const BinaryOpNode*>(node)->op == BinaryOp::ADD ? 1.0 : -1.0;
+                    if (left.size() + right.size() > kMaxTerms) return false;
+                    for (LaplaceTerm& term : right) {
+                        term.coefficient *= sign;
+                        left.push_back(term);
+                    }
+                    continue;
+                }
+                case BinaryOp::MUL:
+                    if (!multiplyLists(left, right, result)) return false;
+                    break;
+                case BinaryOp::DIV:
+                    if (!isConstant(right, constant) || constant == 0.0) return false;
+                    result = std::move(left);
+                    for (LaplaceTerm& term : result) term.coefficient /= constant;
+                    break;
+                case BinaryOp::POW:
+                    if (isConstant(right, constant) && constant >= 0.0 && constant == std::floor(constant) &&
+                        constant <= kMaxPower) {
+                        // Integer power by repeated squaring of the term list
+                        std::vector<LaplaceTerm> power{constantTerm(1.0)}, square = std::move(left), scratch;
+                        for (int k = static_cast<int>(constant); k > 0; k >>= 1) {
+                            if (k & 1) {
+                                if (!multiplyLists(power, square, scratch)) return false;
+                                combineLikeTerms(scratch);
+                                power.swap(scratch);
+                            }
+                            if (k > 1) {
+                                if (!multiplyLists(square, square, scratch)) return false;
+                                combineLikeTerms(scratch);
+                                square.swap(scratch);
+                            }
+                        }
+                        result = std::move(power);
+                    } else if (isConstant(left, constant) && constant > 0.0 && isLinear(right, alpha, beta)) {
+                        // c^(αt + β) = c^β·e^(α ln c·t)
+                        result.push_back({std::pow(constant, beta), 0, alpha * std::log(constant),
+                                          LaplaceOscillation::NONE, 0.0});
+                    } else {
+                        return false;
+                    }
+                    break;
+            }
+            values.pop_back();
+        } else {
+            std::vector<LaplaceTerm> argument = std::move(values.back());
+            values.pop_back();
+            const UnaryFunc func = static_cast<const UnaryFuncNode*>(node)->func;
+            double constant, alpha, beta;
+            if (isConstant(argument, constant)) {
+                result.push_back(constantTerm(UnaryFuncNode::apply(func, constant)));
+            } else if (!isLinear(argument, alpha, beta)) {
+                return false;
+            } else if (func == UnaryFunc::EXP) {
+                result.push_back({std::exp(beta), 0, alpha, LaplaceOscillation::NONE, 0.0});
+            } else if (func == UnaryFunc::SIN) {
+                // sin(αt + β) = cos β·sin(αt) + sin β·cos(αt)
+                appendNormalized({std::cos(beta), 0, 0.0, LaplaceOscillation::SIN, alpha}, result);
+                appendNormalized({std::sin(beta), 0, 0.0, LaplaceOscillation::COS, alpha}, result);
+            } else if (func == UnaryFunc::COS) {
+                // cos(αt + β) = cos β·cos(αt) - sin β·sin(αt)
+                appendNormalized({std::cos(beta), 0, 0.0, LaplaceOscillation::COS, alpha}, result);
+                appendNormalized({-std::sin(beta), 0, 0.0, LaplaceOscillation::SIN, alpha}, result);
+            } else {
+                return false;
+            }
+        }
+        
+        if (termCache.size() >= kMaxCachedSubexpressions) {
+            termCache.clear();
+        }
+        termCache.emplace(std::move(task.key), result);
+        values.push_back(std::move(result));
+    }
+    
+    terms = std::move(values.back());
+    combineLikeTerms(terms);
+    return true;
+}
+
+// "s", "(s - 2)" or "(s + 2)"
+static std::string shiftedS(double rate) {
+    if (rate == 0.0) return "s";
+    return "(s " + std::string(rate > 0.0 ? "- " : "+ ") + formatNumber(std::abs(rate)) + ")";
+}
+
+static std::string withExponent(const std::string& base, int exponent) {
+    return exponent == 1 ? base : base + "^" + std::to_string(exponent);
+}
+
+// L{c·t^n·e^(at)} = c·n!/(s - a)^(n+1). With an oscillation, t^n e^(at) e^(ibt)
+// transforms to n!/(X - ib)^(n+1) with X = s - a, so the sine and cosine
+// parts are n!·Im and n!·Re of (X + ib)^(n+1) over (X² + b²)^(n+1).
+static std::string termTransform(const LaplaceTerm& term) {
+    double factorial = 1.0;
+    for (int i = 2; i <= term.power; i++) factorial *= i;
+    const std::string X = shiftedS(term.rate);
+    const int order = term.power + 1;
+    
+    if (term.oscillation == LaplaceOscillation::NONE) {
+        return formatNumber(term.coefficient * factorial) + "/" + withExponent(X, order);
+    }
+    
+    // Numerator coefficients of X^(order-k) from the binomial expansion
+    const bool sine = term.oscillation == LaplaceOscillation::SIN;
+    std::string numerator;
+    size_t numeratorTerms = 0;
+    double binomial = 1.0, bPower = 1.0;
+    for (int k = 0; k <= order; k++) {
+        bool wanted = sine ? (k % 2 == 1) : (k % 2 == 0);
+        if (wanted) {
+            double sign = ((sine ? (k - 1) / 2 : k / 2) % 2 == 0) ? 1.0 : -1.0;
+            double c = term.coefficient * factorial * binomial * bPower * sign;
+            if (c != 0.0) {
+                std::string monomial = order - k == 0 ? "" : withExponent(X, order - k);
+                std::string magnitude = formatNumber(std::abs(c));
+                std::string piece = monomial.empty() ? magnitude
+                                  : (std::abs(c) == 1.0 ? monomial : magnitude + "⋅" + monomial);
+                if (numerator.empty()) {
+                    numerator = (c < 0.0 ? "-" : "") + piece;
+                } else {
+                    numerator += (c < 0.0 ? " - " : " + ") + piece;
+                }
+                numeratorTerms++;
+            }
+        }
+        binomial = binomial * (order - k) / (k + 1);
+        bPower *= term.frequency;
+    }
+    if (numeratorTerms > 1) numerator = "(" + numerator + ")";
+    std::string denominator = "(" + withExponent(X, 2) + " + " + formatNumber(term.frequency * term.frequency) + ")";
+    return numerator + "/" + withExponent(denominator, order);
+}
+
+static std::string describeTerm(const LaplaceTerm& term) {
+    std::string factors;
+    auto scaled = [](double factor, const std::string& variable) {
+        return factor == 1.0 ? variable : formatNumber(factor) + variable;
+    };
+    if (term.power > 0) factors += "⋅" + withExponent("t", term.power);
+    if (term.rate != 0.0) factors += "⋅e^(" + scaled(term.rate, "t") + ")";
+    if (term.oscillation != LaplaceOscillation::NONE) {
+        factors += std::string(term.oscillation == LaplaceOscillation::SIN ? "⋅sin(" : "⋅cos(") +
+                   scaled(term.frequency, "t") + ")";
+    }
+    if (factors.empty()) return formatNumber(term.coefficient);
+    // Drop the leading "⋅" when the coefficient is 1
+    return term.coefficient == 1.0 ? factors.substr(std::string("⋅").size())
+                                   : formatNumber(term.coefficient) + factors;
+}
+
+std::string LaplaceTransform::transformStructural(const ASTNode* root, std::vector<LaplaceTerm>& terms) {
+    if (!decompose(root, terms)) {
+        terms.clear();
+        return "";
+    }
+    if (terms.empty()) return "0";
+    std::string result;
+    for (const LaplaceTerm& term : terms) {
+        std::string piece = termTransform(term);
+        if (result.empty()) {
+            result = piece;
+        } else if (piece[0] == '-') {
+            result += " - " + piece.substr(1);
+        } else {
+            result += " + " + piece;
+        }
+    }
+    return result;
+}
+
 std::string LaplaceTransform::computeLaplaceTransform(const std::string& function) {
     steps.clear();
     
@@ -66,14 +510,63 @@ std::string LaplaceTransform::computeLaplaceTransform(const std::string& functio
     step3.expression = "";
     steps.push_back(step3);
     
-    std::string result = lookupTransform(function);
+    // Structural match on the parsed expression; the string table is the
+    // fallback for symbolic forms such as exp(at)
+    std::vector<LaplaceTerm> terms;
+    std::string result;
+    try {
+        Parser parser;
+        std::unique_ptr<ASTNode> tree = parser.parse(function);
+        result = transformStructural(tree.get(), terms);
+    } catch (const std::exception&) {
+        result.clear();
+    }
+    
+    if (!result.empty()) {
+        LaplaceStep matchStep;
+        matchStep.description = "Decomposed into " + std::to_string(terms.size()) +
+                                " table terms c⋅tⁿ⋅e^(at)⋅{1, sin bt, cos bt}:";
+        for (size_t i = 0; i < std::min(terms.size(), kShownTerms); i++) {
+            if (i > 0) matchStep.expression += "\n";
+            matchStep.expression += "L{" + describeTerm(terms[i]) + "} = " + termTransform(terms[i]);
+        }
+        if (terms.size() > kShownTerms) {
+            matchStep.expression += "\n… " + std::to_string(terms.size() - kShownTerms) + " more";
+        }
+        steps.push_back(matchStep);
+    } else {
+        result = lookupTransform(function);
+        
+        LaplaceStep step4;
+        step4.description = "Using Laplace transform table:";
+        step4.expression = "L{" + function + "} = " + result;
+        steps.push_back(step4);
+    }
     
-    LaplaceStep step4;
-    step4.description = "Using Laplace transform table:";
-    step4.expression = "L{" + function + "} = " + result;
-    steps.push_back(step4);
+    // Numerical values when f is a concrete function of t that the
+    // structural match could not take apart
+    if (terms.empty()) {
+        try {
+            const size_t checks = sizeof(kCheckPoints) / sizeof(kCheckPoints[0]);
+            double values[checks], errors[checks];
+            evaluateTransform(function, kCheckPoints, checks, values, errors);
+            LaplaceStep numericStep;
+            numericStep.description = "Numerical check (quadrature):";
+            for (size_t i = 0; i < checks; i++) {
+                if (i > 0) numericStep.expression += "\n";
+                numericStep.expression += "F(" + formatNumber(kCheckPoints[i]) + ") ";
+                if (std::isfinite(values[i]) && errors[i] <= kCheckTolerance * std::max(1.0, std::abs(values[i]))) {
+                    numericStep.expression += "≈ " + formatNumber(values[i]);
+                } else {
+                    numericStep.expression += "not converged (the integral may diverge at this s)";
+                }
+            }
+            steps.push_back(numericStep);
+        } catch (const std::exception&) {
+            // Symbolic constants such as a or n: no numerical values
+        }
+    }
     
-    // Add properties if applicable
     LaplaceStep step5;
     step5.description = "Properties used:";
     step5.expression = "• Linearity: L{af+bg} = aL{f} + bL{g}";
@@ -95,6 +588,65 @@ std::string LaplaceTransform::computeLaplaceTransform(const std::string& functio
     return result;
 }
 
+// Largest real part of a singularity of F(s): zeros of denominators, of
+// bases raised to negative or fractional powers, and of ln and sqrt
+// arguments. Each of these must be a polynomial in s, recognized by its
+// Taylor coefficients at 0 ending by degree kMaxPoleDegree, and its roots
+// come from PolynomialOperations::polynomialRoots. 'frequency' receives the
+// largest |Im s| among them. Returns false when one is not a polynomial (or
+// for tan), as the singularities are then unknown.
+static bool rightmostSingularity(const ASTNode* root, double& abscissa, double& frequency) {
+    abscissa = -INFINITY;
+    frequency = 0.0;
+    std::vector<const ASTNode*> stack{root}, zeros;
+    while (!stack.empty()) {
+        const ASTNode* node = stack.back();
+        stack.pop_back();
+        if (node->type == NodeType::BINARY_OP) {
+            auto binOp = static_cast<const BinaryOpNode*>(node);
+            if (binOp->op == BinaryOp::DIV) {
+                zeros.push_back(binOp->right.get());
+            } else if (binOp->op == BinaryOp::POW && !ExpressionProgram::variablesOf(binOp->left.get()).empty()) {
+                if (!ExpressionProgram::variablesOf(binOp->right.get()).empty()) return false;
+                double exponent = binOp->right->evaluate(0.0);
+                if (exponent < 0.0 || exponent != std::floor(exponent)) {
+                    zeros.push_back(binOp->left.get());
+                }
+            }
+            stack.push_back(binOp->right.get());
+            stack.push_back(binOp->left.get());
+        } else if (node->type == NodeType::UNARY_FUNC) {
+            auto unary = static_cast<const UnaryFuncNode*>(node);
+            if (unary->func == UnaryFunc::TAN) return false;
+            if (unary->func == UnaryFunc::LN || unary->func == UnaryFunc::SQRT) {
+                zeros.push_back(unary->arg.get());
+            }
+            stack.push_back(unary->arg.get());
+        }
+    }
+    
+    for (const ASTNode* node : zeros) {
+        std::vector<double> coeffs = TaylorSeriesCalculator::taylorCoefficients(node, 0.0, kMaxPoleDegree + 2);
+        double scale = 0.0;
+        for (double c : coeffs) {
+            if (!std::isfinite(c)) return false;
+            scale = std::max(scale, std::abs(c));
+        }
+        if (scale == 0.0) return false;
+        size_t degree = 0;
+        for (size_t k = 0; k < coeffs.size(); k++) {
+            if (std::abs(coeffs[k]) > 1e-12 * scale) degree = k;
+        }
+        if (degree > static_cast<size_t>(kMaxPoleDegree)) return false;
+        coeffs.resize(degree + 1);
+        for (const std::complex<double>& z : PolynomialOperations::polynomialRoots(coeffs)) {
+            abscissa = std::max(abscissa, z.real());
+            frequency = std::max(frequency, std::abs(z.imag()));
+        }
+    }
+    return true;
+}
+
 std::string LaplaceTransform::computeInverseLaplace(const std::string& function) {
     steps.clear();
     
@@ -158,6 +710,39 @@ std::string LaplaceTransform::computeInverseLaplace(const std::string& function)
         steps.push_back(step4);
     }
     
+    // Numerical values when F is a concrete function of s whose
+    // singularities are known; invertNumeric shifts the contour past them
+    // and leaves NaN where it cannot reach their imaginary parts.
+    try {
+        Parser parser;
+        std::unique_ptr<ASTNode> tree = parser.parse(function);
+        double abscissa, frequency;
+        if (rightmostSingularity(tree.get(), abscissa, frequency)) {
+            const size_t checks = sizeof(kCheckPoints) / sizeof(kCheckPoints[0]);
+            double values[checks];
+            NumericLaplaceOptions options;
+            options.shift = std::max(0.0, abscissa);
+            invertNumeric(function, kCheckPoints, checks, values, options);
+            LaplaceStep numericStep;
+            numericStep.description = "Numerical check (" + inversionDescription(options) + "):";
+            if (options.shift > 0.0) {
+                numericStep.description += " shifted to Re s = " + formatNumber(options.shift);
+            }
+            for (size_t i = 0; i < checks; i++) {
+                if (i > 0) numericStep.expression += "\n";
+                numericStep.expression += "f(" + formatNumber(kCheckPoints[i]) + ") ";
+                if (!std::isfinite(values[i])) {
+                    numericStep.expression += "not converged";
+                } else {
+                    numericStep.expression += "≈ " + formatNumber(values[i]);
+                }
+            }
+            steps.push_back(numericStep);
+        }
+    } catch (const std::exception&) {
+        // Symbolic constants such as a or n: no numerical values
+    }
+    
     LaplaceStep step5;
     step5.description = "Techniques available:";
     step5.expression = "• Partial fractions for rational functions";
@@ -178,3 +763,215 @@ std::string LaplaceTransform::computeInverseLaplace(const std::string& function)
     
     return result;
 }
+
+// Node x and weight (π/2)·cosh(u)·x·e^(-x) for one refinement level: all
+// nodes at level 0, only the new odd ones after that. Nodes where e^(-x)
+// underflows are dropped.
+struct QuadratureNode {
+    double x;
+    double weight;
+};
+
+static std::vector<std::vector<QuadratureNode>> expSinhLevels() {
+    std::vector<std::vector<QuadratureNode>> levels(kMaxQuadratureLevel + 1);
+    for (int level = 0; level <= kMaxQuadratureLevel; level++) {
+        double h = std::ldexp(1.0, -level);
+        double step = level == 0 ? h : 2.0 * h;
+        double first = level == 0 ? std::ceil(kMinU / h) * h : std::floor(kMinU / step) * step + h;
+        for (double u = first; u <= kMaxU; u += step) {
+            if (u < kMinU) continue;
+            double x = std::exp(M_PI / 2.0 * std::sinh(u));
+            double weight = M_PI / 2.0 * std::cosh(u) * x * std::exp(-x);
+            if (weight > 0.0) {
+                levels[level].push_back({x, weight});
+            }
+        }
+    }
+    return levels;
+}
+
+void LaplaceTransform::evaluateTransform(const std::string& function, const double* s, size_t count,
+                                         double* values, double* errors, const NumericLaplaceOptions& options) {
+    for (size_t i = 0; i < count; i++) {
+        if (!(s[i] > 0.0)) {
+            throw std::invalid_argument("Numeric Laplace transform needs real s > 0");
+        }
+    }
+    const ExpressionProgram f = compileIn(function, "t");
+    const std::vector<std::vector<QuadratureNode>> levels = expSinhLevels();
+    
+    size_t chunks = parallelChunkCount(count, 16);
+    parallelChunks(count, chunks, [&](size_t, size_t begin, size_t end) {
+        std::vector<double> registers;
+        for (size_t i = begin; i < end; i++) {
+            // F(s) = (1/s)∫₀^∞ f(x/s)e^(-x) dx
+            const double scale = 1.0 / s[i];
+            double sum = 0.0, estimate = 0.0, previous = 0.0, difference = INFINITY;
+            for (int level = 0; level <= kMaxQuadratureLevel; level++) {
+                for (const QuadratureNode& node : levels[level]) {
+                    double t = node.x * scale, value;
+                    f.evaluate(&t, &value, registers);
+                    sum += value * node.weight;
+                }
+                estimate = sum * std::ldexp(1.0, -level) * scale;
+                if (level > 0) {
+                    difference = std::abs(estimate - previous);
+                    if (level >= 3 && difference <= options.relativeTolerance * std::abs(estimate)) break;
+                }
+                previous = estimate;
+            }
+            values[i] = estimate;
+            if (errors) errors[i] = difference;
+        }
+    });
+}
+
+// Stehfest weights V_k, k = 1..N
+static std::vector<double> stehfestWeights(int terms) {
+    auto factorial = [](int n) {
+        double result = 1.0;
+        for (int i = 2; i <= n; i++) result *= i;
+        return result;
+    };
+    const int half = terms / 2;
+    std::vector<double> weights(terms + 1, 0.0);
+    for (int k = 1; k <= terms; k++) {
+        double sum = 0.0;
+        for (int j = (k + 1) / 2; j <= std::min(k, half); j++) {
+            sum += std::pow(j, half) * factorial(2 * j) /
+                   (factorial(half - j) * factorial(j) * factorial(j - 1) * factorial(k - j) * factorial(2 * j - k));
+        }
+        weights[k] = ((k + half) % 2 == 0 ? 1.0 : -1.0) * sum;
+    }
+    return weights;
+}
+
+void LaplaceTransform::invertNumeric(const std::string& transform, const double* t, size_t count, double* values,
+                                     const NumericLaplaceOptions& options) {
+    for (size_t i = 0; i < count; i++) {
+        if (!(t[i] > 0.0)) {
+            throw std::invalid_argument("Numeric inverse Laplace transform needs t > 0");
+        }
+    }
+    Parser parser;
+    std::unique_ptr<ASTNode> tree = parser.parse(transform);
+    const ExpressionProgram F({tree.get()}, {"s"});
+    const size_t chunks = parallelChunkCount(count, 1024);
+    
+    // Shifting by the rightmost known singularity puts them all in Re s <= 0,
+    // where the contour encloses them; frequency stays 0 (nothing flagged)
+    // when they are unknown
+    double abscissa, frequency;
+    double shift = options.shift;
+    if (rightmostSingularity(tree.get(), abscissa, frequency)) {
+        shift = std::max(shift, abscissa);
+    } else {
+        frequency = 0.0;
+    }
+    
+    if (options.method == InversionMethod::GaverStehfest) {
+        const int terms = options.stehfestTerms;
+        if (terms < 2 || terms > 30 || terms % 2 != 0) {
+            throw std::invalid_argument("Stehfest needs an even number of terms between 2 and 30");
+        }
+        const std::vector<double> weights = stehfestWeights(terms);
+        parallelChunks(count, chunks, [&](size_t, size_t begin, size_t end) {
+            std::vector<double> registers;
+            for (size_t i = begin; i < end; i++) {
+                // f(t) ≈ (ln 2/t)·Σ V_k F(k ln 2/t)
+                const double a = M_LN2 / t[i];
+                double sum = 0.0;
+                for (int k = 1; k <= terms; k++) {
+                    double s = k * a + shift, value;
+                    F.evaluate(&s, &value, registers);
+                    sum += weights[k] * value;
+                }
+                values[i] = a * sum * std::exp(shift * t[i]);
+            }
+        });
+        return;
+    }
+    
+    // Fixed Talbot (Abate and Valkó): s(θ) = rθ(cot θ + i) with r = 2M/(5t),
+    // so s_k = base_k/t and e^(t·s_k) = e^(base_k) no longer depend on t
+    const int M = options.talbotNodes;
+    if (M < 2 || M > 64) {
+        throw std::invalid_argument("Talbot needs between 2 and 64 nodes");
+    }
+    using Complex = std::complex<double>;
+    const double rt = 2.0 * M / 5.0;
+    std::vector<Complex> base(M), factor(M);
+    base[0] = rt;
+    factor[0] = 0.5 * std::exp(rt);
+    for (int k = 1; k < M; k++) {
+        double theta = k * M_PI / M;
+        double cot = 1.0 / std::tan(theta);
+        double sigma = theta + (theta * cot - 1.0) * cot;
+        base[k] = rt * theta * Complex(cot, 1.0);
+        factor[k] = std::exp(base[k]) * Complex(1.0, sigma);
+    }
+    
+    parallelChunks(count, chunks, [&](size_t, size_t begin, size_t end) {
+        std::vector<Complex> registers;
+        for (size_t i = begin; i < end; i++) {
+            const double inverse = 1.0 / t[i];
+            if (rt * inverse < frequency) {
+                // The contour no longer encloses the poles at ±i·frequency
+                values[i] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+            double sum = 0.0;
+            for (int k = 0; k < M; k++) {
+                Complex s = base[k] * inverse + shift, value;
+                F.evaluate(&s, &value, registers);
+                sum += (factor[k] * value).real();
+            }
+            // r/M = 2/(5t)
+            values[i] = 0.4 * inverse * sum * std::exp(shift * t[i]);
+        }
+    });
+}
+
+std::vector<double> LaplaceTransform::computeInverseLaplaceNumeric(const std::string& transform, double tStart,
+                                                                   double tEnd, size_t points,
+                                                                   const NumericLaplaceOptions& options) {
+    steps.clear();
+    if (points < 2) {
+        throw std::invalid_argument("At least two points are needed");
+    }
+    std::vector<double> t(points), values(points);
+    for (size_t i = 0; i < points; i++) {
+        t[i] = tStart + (tEnd - tStart) * static_cast<double>(i) / (points - 1);
+    }
+    invertNumeric(transform, t.data(), points, values.data(), options);
+    
+    LaplaceStep header;
+    header.description = "=== Numerical Inverse Laplace Transform ===";
+    header.expression = "Given: F(s) = " + transform;
+    steps.push_back(header);
+    
+    LaplaceStep methodStep;
+    methodStep.description = "Method: " + inversionDescription(options);
+    if (options.method == InversionMethod::GaverStehfest) {
+        methodStep.expression = "f(t) ≈ (ln 2/t) Σ V_k F(k ln 2/t)";
+    } else {
+        methodStep.expression = "f(t) ≈ (r/M)[½F(r)e^(rt) + Σ Re(e^(t s_k) F(s_k)(1 + iσ_k))],  r = 2M/(5t)";
+    }
+    steps.push_back(methodStep);
+    
+    size_t perPoint = options.method == InversionMethod::GaverStehfest ? options.stehfestTerms : options.talbotNodes;
+    LaplaceStep workStep;
+    workStep.description = "Work:";
+    workStep.expression = std::to_string(points) + " points × " + std::to_string(perPoint) + " evaluations of F(s)";
+    steps.push_back(workStep);
+    
+    LaplaceStep tableStep;
+    tableStep.description = "Values:";
+    tableStep.expression = valueTable(points, [&](size_t i) {
+        return "f(" + formatNumber(t[i]) + ") " +
+               (std::isnan(values[i]) ? "not converged" : "≈ " + formatNumber(values[i]));
+    });
+    steps.push_back(tableStep);
+    
+    return values;
+}
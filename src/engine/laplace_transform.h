@@ -1,7 +1,34 @@
 #pragma once
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
+#include "ast.h"
+
+enum class InversionMethod {
+    FixedTalbot,        // Deformed Bromwich contour; needs F at complex s
+    GaverStehfest       // Real s only; smooth, non-oscillating f(t)
+};
+
+struct NumericLaplaceOptions {
+    InversionMethod method = InversionMethod::FixedTalbot;
+    int talbotNodes = 24;           // M; accuracy ~0.6M digits until e^(0.4M) roundoff takes over
+    int stehfestTerms = 14;         // N, even; more loses digits to cancellation in double precision
+    double shift = 0.0;             // Invert F(s + shift)·e^(shift·t); raised to F's rightmost singularity when known
+    double relativeTolerance = 1e-10;   // Forward transform quadrature
+};
+
+// One term c·t^n·e^(at)·{1, sin(bt), cos(bt)} of an expression taken apart
+// for structural table matching
+enum class LaplaceOscillation { NONE, SIN, COS };
+
+struct LaplaceTerm {
+    double coefficient;
+    int power;
+    double rate;
+    LaplaceOscillation oscillation;
+    double frequency;
+};
 
 struct LaplaceStep {
     std::string description;
@@ -13,18 +40,56 @@ private:
     std::vector<LaplaceStep> steps;
     std::map<std::string, std::string> transformTable;
     
+    // Term lists of subtrees already taken apart, keyed by exact structure, so
+    // repeated factors such as sin(3⋅t) are decomposed once across calls
+    std::unordered_map<std::string, std::vector<LaplaceTerm>> termCache;
+    
     void initializeTransformTable();
     std::string lookupTransform(const std::string& function);
-    
+    bool decompose(const ASTNode* root, std::vector<LaplaceTerm>& terms);
+
 public:
     LaplaceTransform();
     
-    // Compute Laplace transform
+    // Compute Laplace transform. Expressions in t built from constants, +, -,
+    // ·, division by constants, integer powers, exp, sin and cos of linear
+    // arguments are matched structurally and get a concrete F(s); anything
+    // else falls back to the symbolic table.
     std::string computeLaplaceTransform(const std::string& function);
     
+    // Structural match of f(t): fills 'terms' with the combined terms and
+    // returns the transform, or an empty string if f is outside that class
+    std::string transformStructural(const ASTNode* root, std::vector<LaplaceTerm>& terms);
+    
+    size_t cachedSubexpressions() const { return termCache.size(); }
+    
     // Compute inverse Laplace transform
     std::string computeInverseLaplace(const std::string& function);
     
+    // F(s) = ∫₀^∞ f(t)e^(-st) dt at each real s > 0, for f an expression in
+    // t, by exp-sinh quadrature of f(x/s)e^(-x)/s refined until successive
+    // levels agree. errors (optional) receives the last level difference.
+    static void evaluateTransform(const std::string& function, const double* s, size_t count, double* values,
+                                  double* errors = nullptr,
+                                  const NumericLaplaceOptions& options = NumericLaplaceOptions());
+    
+    // f(t) at each t > 0 from F, an expression in s. The nodes and weights
+    // depend only on the method, so they are computed once for the batch;
+    // per t only F is evaluated, and large batches are split across threads.
+    // When F's singularities can be located (polynomial denominators, no
+    // tan) the shift is raised to the real part of the rightmost one, and
+    // Talbot gives NaN at t where r = 2M/(5t) falls below their largest
+    // |Im s|, since the contour no longer encloses them. Otherwise
+    // options.shift is used as given and no value is flagged.
+    static void invertNumeric(const std::string& transform, const double* t, size_t count, double* values,
+                              const NumericLaplaceOptions& options = NumericLaplaceOptions());
+    
+    // invertNumeric on 'points' equally spaced t in [tStart, tEnd], with the
+    // method and a table of values recorded as steps
+    std::vector<double> computeInverseLaplaceNumeric(const std::string& transform, double tStart, double tEnd,
+                                                     size_t points,
+                                                     const NumericLaplaceOptions& options = NumericLaplaceOptions());
+    
     const std::vector<LaplaceStep>& getSteps() const { return steps; }
     void clearSteps() { steps.clear(); }
 };
@@ -1,16 +1,29 @@
 #include "limit_calculator.h"
-#include "differentiator.h"
+#include "extrapolation.h"
+#include "taylor_series.h"
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
 
-std::string LimitCalculator::limitTypeToString(double point, LimitType type) const {
+// Approach points: c ± h₀/2ᵏ for finite limits, ±2ᵏ at infinity
+static constexpr int kFiniteSamples = 12;
+static constexpr int kInfiniteSamples = 24;
+// Taylor order for quotients, i.e. the most L'Hôpital steps taken
+static constexpr int kQuotientOrder = 8;
+// Relative error accepted for a limit; a looser one is reported as approximate
+static constexpr double kTolerance = 1e-6;
+static constexpr double kLooseTolerance = 1e-3;
+
+std::string LimitCalculator::limitTypeToString(double point, LimitType type, LimitSide side) const {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(2);
     
     switch (type) {
         case LimitType::FINITE:
             oss << "x → " << point;
+            if (side == LimitSide::LEFT) oss << "⁻";
+            if (side == LimitSide::RIGHT) oss << "⁺";
             break;
         case LimitType::POSITIVE_INFINITY:
             oss << "x → +∞";
@@ -22,194 +35,260 @@ std::string LimitCalculator::limitTypeToString(double point, LimitType type) con
     return oss.str();
 }
 
-bool LimitCalculator::isIndeterminate(double numerator, double denominator) {
-    bool numIsNan = std::isnan(numerator);
-    bool denIsNan = std::isnan(denominator);
-    bool numIsInf = std::isinf(numerator);
-    bool denIsInf = std::isinf(denominator);
-    bool numIsZero = std::abs(numerator) < 1e-10;
-    bool denIsZero = std::abs(denominator) < 1e-10;
-    
-    // 0/0 form
-    if (numIsZero && denIsZero) return true;
-    
-    // ∞/∞ form
-    if (numIsInf && denIsInf) return true;
-    
-    // NaN cases
-    if (numIsNan || denIsNan) return true;
-    
-    return false;
+static std::string formatValue(double value) {
+    if (std::isnan(value)) return "undefined";
+    if (std::isinf(value)) return value > 0 ? "+∞" : "-∞";
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(6) << value;
+    return oss.str();
 }
 
-double LimitCalculator::applyLHopital(const ASTNode* node, double point, LimitType type, int depth) {
-    if (depth > 3) {
-        steps.push_back({"Maximum L'Hôpital iterations reached", "Limit may not exist or requires advanced techniques"});
-        return std::numeric_limits<double>::quiet_NaN();
+static std::string formatEstimate(const LimitEstimate& estimate) {
+    if (!estimate.defined) return "undefined (samples outside the domain)";
+    if (!estimate.converged) return "does not settle (oscillates or converges too slowly)";
+    if (std::isinf(estimate.value)) return formatValue(estimate.value) + " (unbounded growth)";
+    std::ostringstream oss;
+    oss << formatValue(estimate.value) << std::scientific << std::setprecision(1) << "  (± " << estimate.error << ")";
+    if (estimate.error > kTolerance * std::max(1.0, std::abs(estimate.value))) {
+        oss << ", approximate";
     }
-    
-    // Check if it's a fraction (division)
-    if (node->type != NodeType::BINARY_OP) {
-        return evaluateLimit(node, point, type);
+    return oss.str();
+}
+
+// Keeps the estimate that agrees best with its predecessor
+static void bestOf(const std::vector<double>& estimates, double& value, double& error) {
+    for (size_t i = 1; i < estimates.size(); i++) {
+        double difference = std::abs(estimates[i] - estimates[i - 1]);
+        if (std::isfinite(estimates[i]) && difference < error) {
+            value = estimates[i];
+            error = difference;
+        }
     }
+}
+
+LimitEstimate LimitCalculator::extrapolateLimit(const ASTNode* node, double point, LimitType type, int direction) {
+    const bool finite = type == LimitType::FINITE;
+    const int count = finite ? kFiniteSamples : kInfiniteSamples;
+    // A power of two keeps c ± h exact for moderate c
+    const double h0 = std::ldexp(1.0, std::max(-3, static_cast<int>(std::ceil(std::log2(std::abs(point) + 1.0))) - 3));
     
-    const BinaryOpNode* binOp = static_cast<const BinaryOpNode*>(node);
-    if (binOp->op != BinaryOp::DIV) {
-        return evaluateLimit(node, point, type);
+    LimitEstimate estimate;
+    std::vector<double> values;
+    values.reserve(count);
+    for (int k = 0; k < count; k++) {
+        double x = finite ? point + direction * std::ldexp(h0, -k) : direction * std::ldexp(1.0, k);
+        double y;
+        try {
+            y = node->evaluate(x);
+        } catch (...) {
+            y = std::numeric_limits<double>::quiet_NaN();
+        }
+        if (std::isnan(y)) return estimate;
+        values.push_back(y);
     }
+    estimate.defined = true;
     
-    // Apply L'Hôpital's rule
-    std::ostringstream oss;
-    oss << "Applying L'Hôpital's rule (iteration " << (depth + 1) << ")";
-    steps.push_back({oss.str(), "Differentiate numerator and denominator separately"});
-    
-    // Differentiate numerator and denominator
-    Differentiator diff;
-    auto numDerivative = diff.differentiate(binOp->left.get());
-    auto denDerivative = diff.differentiate(binOp->right.get());
-    
-    std::string numDerStr = numDerivative->toString();
-    std::string denDerStr = denDerivative->toString();
-    
-    steps.push_back({"After differentiation", "(" + numDerStr + ") / (" + denDerStr + ")"});
-    
-    // Evaluate the derivatives
-    double numValue, denValue;
-    
-    if (type == LimitType::FINITE) {
-        numValue = numDerivative->evaluate(point);
-        denValue = denDerivative->evaluate(point);
-    } else if (type == LimitType::POSITIVE_INFINITY) {
-        numValue = numDerivative->evaluate(1e6);
-        denValue = denDerivative->evaluate(1e6);
-    } else { // NEGATIVE_INFINITY
-        numValue = numDerivative->evaluate(-1e6);
-        denValue = denDerivative->evaluate(-1e6);
+    // Unbounded: over the second half the samples move away from zero in
+    // one direction and the steps do not shrink (a convergent sequence's
+    // steps decay along this sampling). Checked first, since Wynn ε returns
+    // the antilimit of a diverging geometric sequence.
+    const int half = count / 2;
+    const double last = values.back();
+    if (std::isinf(last)) {
+        if (values[count - 2] == last) {
+            estimate.value = last;
+            estimate.converged = true;
+        }
+        return estimate;
     }
-    
-    // Check if still indeterminate
-    if (isIndeterminate(numValue, denValue)) {
-        steps.push_back({"Still indeterminate form", "Applying L'Hôpital's rule again"});
-        
-        // Create new division node and recurse
-        auto newNode = std::make_unique<BinaryOpNode>(
-            BinaryOp::DIV,
-            std::move(numDerivative),
-            std::move(denDerivative)
-        );
-        
-        return applyLHopital(newNode.get(), point, type, depth + 1);
+    bool monotone = true;
+    for (int k = half + 1; k < count && monotone; k++) {
+        double step = values[k] - values[k - 1];
+        monotone = std::isfinite(step) && step != 0.0 && (step > 0) == (last > 0) &&
+                   std::abs(values[k]) > std::abs(values[k - 1]);
     }
-    
-    std::ostringstream resultOss;
-    resultOss << std::fixed << std::setprecision(4);
-    resultOss << numValue << " / " << denValue << " = ";
-    
-    if (std::abs(denValue) < 1e-10) {
-        if (numValue > 0) {
-            resultOss << "+∞";
-            return std::numeric_limits<double>::infinity();
-        } else if (numValue < 0) {
-            resultOss << "-∞";
-            return -std::numeric_limits<double>::infinity();
-        } else {
-            resultOss << "undefined";
-            return std::numeric_limits<double>::quiet_NaN();
-        }
+    double firstStep = std::abs(values[half + 1] - values[half]);
+    double lastStep = std::abs(values[count - 1] - values[count - 2]);
+    if (monotone && lastStep >= 0.5 * firstStep) {
+        estimate.value = last > 0 ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+        estimate.converged = true;
+        return estimate;
+    }
+    if (!std::all_of(values.begin() + half, values.end(), [](double y) { return std::isfinite(y); })) {
+        return estimate;
     }
     
-    double result = numValue / denValue;
-    resultOss << result;
-    steps.push_back({"L'Hôpital result", resultOss.str()});
-    
-    return result;
+    // Only the second half feeds the estimates, so early coincidences
+    // (e.g. ln x/x equal at x = 2 and 4) cannot pass for convergence.
+    // Extrapolation is trusted only while the raw steps are shrinking.
+    std::vector<double> tail(values.begin() + half, values.end());
+    estimate.value = last;
+    estimate.error = lastStep;
+    if (lastStep < std::abs(values[count - 4] - values[count - 5])) {
+        bestOf(extrapolateHalving(tail), estimate.value, estimate.error);
+        bestOf(wynnEpsilon(tail), estimate.value, estimate.error);
+    }
+    estimate.error = std::max(estimate.error, 4.0 * std::numeric_limits<double>::epsilon() * std::abs(estimate.value));
+    estimate.converged = estimate.error <= kLooseTolerance * std::max(1.0, std::abs(estimate.value));
+    return estimate;
 }
 
-double LimitCalculator::evaluateLimit(const ASTNode* node, double point, LimitType type) {
-    double testValue = point; // Initialize with default value
+bool LimitCalculator::quotientLimit(const BinaryOpNode* quotient, double point, LimitSide side, double& result) {
+    std::vector<double> numerator = TaylorSeriesCalculator::taylorCoefficients(quotient->left.get(), point, kQuotientOrder);
+    std::vector<double> denominator = TaylorSeriesCalculator::taylorCoefficients(quotient->right.get(), point, kQuotientOrder);
     
-    switch (type) {
-        case LimitType::FINITE:
-            testValue = point;
-            break;
-        case LimitType::POSITIVE_INFINITY:
-            testValue = 1e6; // Large positive value
-            break;
-        case LimitType::NEGATIVE_INFINITY:
-            testValue = -1e6; // Large negative value
-            break;
+    // Index of the first coefficient that is not rounding noise, or -1
+    auto leadingOrder = [](const std::vector<double>& coefficients) {
+        double scale = 1.0;
+        for (double c : coefficients) {
+            if (!std::isfinite(c)) return -2;
+            scale = std::max(scale, std::abs(c));
+        }
+        for (size_t k = 0; k < coefficients.size(); k++) {
+            if (std::abs(coefficients[k]) > 1e-10 * scale) return static_cast<int>(k);
+        }
+        return -1;
+    };
+    int p = leadingOrder(numerator);
+    int q = leadingOrder(denominator);
+    if (p < 0 || q < 0) {
+        // Not analytic at the point, or zero to every order computed
+        return false;
     }
     
-    try {
-        return node->evaluate(testValue);
-    } catch (...) {
-        return std::numeric_limits<double>::quiet_NaN();
+    std::ostringstream form;
+    form << std::setprecision(6) << "f ~ " << numerator[p] << "·(x - c)^" << p
+         << ",  g ~ " << denominator[q] << "·(x - c)^" << q;
+    steps.push_back({"L'Hôpital's rule via Taylor coefficients (forward-mode AD)", form.str()});
+    
+    double ratio = numerator[p] / denominator[q];
+    if (p == q) {
+        if (p > 0) {
+            std::ostringstream oss;
+            oss << "f⁽" << p << "⁾(c) / g⁽" << p << "⁾(c) = " << formatValue(ratio);
+            steps.push_back({"Applying L'Hôpital's rule " + std::to_string(p) + " time(s)", oss.str()});
+        }
+        result = ratio;
+    } else if (p > q) {
+        steps.push_back({"Numerator vanishes to higher order", "Limit is 0"});
+        result = 0.0;
+    } else {
+        // Pole of order q - p: the sign flips across c when the order is odd
+        double right = ratio > 0 ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+        double left = (q - p) % 2 == 0 ? right : -right;
+        steps.push_back({"Pole of order " + std::to_string(q - p),
+                         "Left: " + formatValue(left) + ",  Right: " + formatValue(right)});
+        if (side == LimitSide::LEFT) {
+            result = left;
+        } else if (side == LimitSide::RIGHT || left == right) {
+            result = right;
+        } else {
+            steps.push_back({"Result", "One-sided limits differ: limit does not exist"});
+            result = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
     }
+    
+    steps.push_back({"Result", formatValue(result)});
+    return true;
 }
 
-double LimitCalculator::calculateLimit(const ASTNode* root, double point, LimitType type) {
+double LimitCalculator::calculateLimit(const ASTNode* root, double point, LimitType type, LimitSide side) {
     steps.clear();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
     
     if (!root) {
         steps.push_back({"Error", "Invalid expression"});
-        return std::numeric_limits<double>::quiet_NaN();
+        return nan;
     }
     
     // Step 1: Show the limit expression
     std::ostringstream oss;
-    oss << "lim [" << limitTypeToString(point, type) << "] (" << root->toString() << ")";
+    oss << "lim [" << limitTypeToString(point, type, side) << "] (" << root->toString() << ")";
     steps.push_back({"Evaluating limit", oss.str()});
     
-    // Step 2: Try direct substitution
-    double directResult;
-    
+    // Step 2: Direct substitution, then the quotient expansion, at finite points
     if (type == LimitType::FINITE) {
         steps.push_back({"Direct substitution", "Substitute x = " + std::to_string(point)});
-        directResult = root->evaluate(point);
-    } else if (type == LimitType::POSITIVE_INFINITY) {
-        steps.push_back({"Approaching infinity", "Evaluate as x → +∞"});
-        directResult = root->evaluate(1e6);
+        double directResult;
+        try {
+            directResult = root->evaluate(point);
+        } catch (...) {
+            directResult = nan;
+        }
+        // A one-sided limit also needs f defined on that side: sqrt(x) is 0
+        // at 0 but has no left-hand limit there
+        if (std::isfinite(directResult) && side != LimitSide::BOTH &&
+            !extrapolateLimit(root, point, type, side == LimitSide::LEFT ? -1 : 1).defined) {
+            steps.push_back({"Domain", std::string("Not defined for x ") + (side == LimitSide::LEFT ? "< c" : "> c")});
+            steps.push_back({"Result", "Function is undefined near the point"});
+            return nan;
+        }
+        if (std::isfinite(directResult)) {
+            steps.push_back({"Result", formatValue(directResult)});
+            return directResult;
+        }
+        steps.push_back({"Result", std::isnan(directResult) ? "Indeterminate form (NaN)" : "Not finite at the point"});
+        
+        if (root->type == NodeType::BINARY_OP && static_cast<const BinaryOpNode*>(root)->op == BinaryOp::DIV) {
+            double result;
+            if (quotientLimit(static_cast<const BinaryOpNode*>(root), point, side, result)) {
+                return result;
+            }
+        }
+    }
+    
+    // Step 3: Extrapolate samples along each requested side
+    std::vector<int> directions;
+    if (type == LimitType::FINITE) {
+        if (side != LimitSide::RIGHT) directions.push_back(-1);
+        if (side != LimitSide::LEFT) directions.push_back(1);
+        steps.push_back({"Numerical limit", "Sample f(c ± h) for h = h₀/2ᵏ, k = 0.." + std::to_string(kFiniteSamples - 1) +
+                                            "; extrapolate with Richardson and Wynn ε"});
     } else {
-        steps.push_back({"Approaching negative infinity", "Evaluate as x → -∞"});
-        directResult = root->evaluate(-1e6);
+        directions.push_back(type == LimitType::POSITIVE_INFINITY ? 1 : -1);
+        steps.push_back({"Numerical limit", "Sample f(±2ᵏ) for k = 0.." + std::to_string(kInfiniteSamples - 1) +
+                                            "; extrapolate in 1/x with Richardson and Wynn ε"});
     }
     
-    // Step 3: Check if result is valid
-    if (std::isnan(directResult)) {
-        steps.push_back({"Result", "Indeterminate form (NaN)"});
-        
-        // Try L'Hôpital's rule if it's a division
-        if (root->type == NodeType::BINARY_OP) {
-            const BinaryOpNode* binOp = static_cast<const BinaryOpNode*>(root);
-            if (binOp->op == BinaryOp::DIV) {
-                double numValue, denValue;
-                
-                if (type == LimitType::FINITE) {
-                    numValue = binOp->left->evaluate(point);
-                    denValue = binOp->right->evaluate(point);
-                } else if (type == LimitType::POSITIVE_INFINITY) {
-                    numValue = binOp->left->evaluate(1e6);
-                    denValue = binOp->right->evaluate(1e6);
-                } else {
-                    numValue = binOp->left->evaluate(-1e6);
-                    denValue = binOp->right->evaluate(-1e6);
-                }
-                
-                if (isIndeterminate(numValue, denValue)) {
-                    steps.push_back({"Indeterminate form detected", "0/0 or ∞/∞ - applying L'Hôpital's rule"});
-                    return applyLHopital(root, point, type, 0);
-                }
+    std::vector<LimitEstimate> estimates;
+    for (int direction : directions) {
+        LimitEstimate estimate = extrapolateLimit(root, point, type, direction);
+        std::string label = type != LimitType::FINITE ? "Limit" : direction < 0 ? "Left-hand limit" : "Right-hand limit";
+        steps.push_back({label, formatEstimate(estimate)});
+        estimates.push_back(estimate);
+    }
+    
+    const LimitEstimate* chosen = &estimates[0];
+    if (estimates.size() == 2) {
+        const LimitEstimate& left = estimates[0];
+        const LimitEstimate& right = estimates[1];
+        if (left.defined != right.defined) {
+            chosen = left.defined ? &left : &right;
+            steps.push_back({"Domain", std::string("Defined only for x ") + (left.defined ? "< c" : "> c")});
+        } else if (left.converged && right.converged) {
+            bool agree = std::isinf(left.value) || std::isinf(right.value)
+                ? left.value == right.value
+                : std::abs(left.value - right.value) <= 10.0 * (left.error + right.error) +
+                  kTolerance * std::max(1.0, std::abs(left.value));
+            if (!agree) {
+                steps.push_back({"Result", "One-sided limits differ: limit does not exist"});
+                return nan;
             }
+            chosen = left.error <= right.error ? &left : &right;
+        } else if (!right.converged) {
+            chosen = &right;
         }
-        
-        return std::numeric_limits<double>::quiet_NaN();
-    } else if (std::isinf(directResult)) {
-        steps.push_back({"Result", directResult > 0 ? "+∞" : "-∞"});
-        return directResult;
-    } else {
-        std::ostringstream resultOss;
-        resultOss << std::fixed << std::setprecision(6) << directResult;
-        steps.push_back({"Result", resultOss.str()});
-        return directResult;
     }
+    
+    if (!chosen->defined) {
+        steps.push_back({"Result", "Function is undefined near the point"});
+        return nan;
+    }
+    if (!chosen->converged) {
+        steps.push_back({"Result", "Limit does not exist or could not be determined"});
+        return nan;
+    }
+    steps.push_back({"Result", formatValue(chosen->value)});
+    return chosen->value;
 }
@@ -15,19 +15,38 @@ enum class LimitType {
     NEGATIVE_INFINITY  // lim x->-∞
 };
 
+// Direction of approach for finite limits; BOTH requires the one-sided
+// limits to agree
+enum class LimitSide {
+    BOTH,
+    LEFT,   // x → c⁻
+    RIGHT   // x → c⁺
+};
+
+// One-sided limit from samples along a geometric sequence of approach points
+struct LimitEstimate {
+    double value = std::numeric_limits<double>::quiet_NaN();
+    double error = std::numeric_limits<double>::infinity();
+    bool defined = false;   // Every sample was a number (±∞ allowed)
+    bool converged = false; // Estimate settled to within tolerance
+};
+
 class LimitCalculator {
 private:
     std::vector<LimitStep> steps;
     
-    double evaluateLimit(const ASTNode* node, double point, LimitType type);
-    bool isIndeterminate(double numerator, double denominator);
-    double applyLHopital(const ASTNode* node, double point, LimitType type, int depth);
-    
+    // direction is -1 or +1: the side of a finite point, or the sign of ∞
+    LimitEstimate extrapolateLimit(const ASTNode* node, double point, LimitType type, int direction);
+    // 0/0 and c/0 quotients at a finite point, from the leading Taylor
+    // coefficients of numerator and denominator (L'Hôpital by forward AD,
+    // no derivative trees). Returns false when the expansion does not apply.
+    bool quotientLimit(const BinaryOpNode* quotient, double point, LimitSide side, double& result);
+
 public:
-    double calculateLimit(const ASTNode* root, double point, LimitType type);
+    double calculateLimit(const ASTNode* root, double point, LimitType type, LimitSide side = LimitSide::BOTH);
     const std::vector<LimitStep>& getSteps() const { return steps; }
     void clearSteps() { steps.clear(); }
     
     // Helper to format limit type as string
-    std::string limitTypeToString(double point, LimitType type) const;
+    std::string limitTypeToString(double point, LimitType type, LimitSide side = LimitSide::BOTH) const;
 };
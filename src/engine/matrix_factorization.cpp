@@ -0,0 +1,446 @@
+#include "matrix_factorization.h"
+#include "job_system.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Columns per LU panel: a panel's rows of U stay in cache across the trailing update
+static const size_t kPanelWidth = 64;
+
+// Trailing updates smaller than this many elements stay on the calling thread
+static const size_t kParallelUpdateElements = size_t(1) << 16;
+
+static size_t squareSize(const Matrix& A) {
+    if (A.rows != A.cols) {
+        throw std::invalid_argument("Factorization needs a square matrix");
+    }
+    return static_cast<size_t>(A.rows);
+}
+
+static double columnNorm1(const Matrix& A) {
+    double norm = 0.0;
+    for (int j = 0; j < A.cols; j++) {
+        double sum = 0.0;
+        for (int i = 0; i < A.rows; i++) {
+            sum += std::abs(A.data[i][j]);
+        }
+        norm = std::max(norm, sum);
+    }
+    return norm;
+}
+
+static Matrix fromRowMajor(const std::vector<double>& values, size_t rows, size_t cols) {
+    Matrix result(static_cast<int>(rows), static_cast<int>(cols));
+    for (size_t i = 0; i < rows; i++) {
+        std::copy(values.begin() + i * cols, values.begin() + (i + 1) * cols, result.data[i].begin());
+    }
+    return result;
+}
+
+static Matrix identity(size_t n) {
+    Matrix result(static_cast<int>(n), static_cast<int>(n));
+    for (size_t i = 0; i < n; i++) {
+        result.data[i][i] = 1.0;
+    }
+    return result;
+}
+
+// Estimates ‖A⁻¹‖₁ from solves with A and Aᵀ (Hager's method with Higham's
+// alternating test vector as a safeguard against its known failure cases)
+template <typename Solve, typename SolveTransposed>
+static double inverseNorm1Estimate(size_t n, Solve solve, SolveTransposed solveTransposed) {
+    auto norm1 = [](const std::vector<double>& v) {
+        double sum = 0.0;
+        for (double x : v) sum += std::abs(x);
+        return sum;
+    };
+    
+    std::vector<double> x(n, 1.0 / n);
+    double estimate = 0.0;
+    size_t lastIndex = n;
+    for (int iteration = 0; iteration < 5; iteration++) {
+        std::vector<double> y = solve(x);
+        estimate = std::max(estimate, norm1(y));
+        
+        std::vector<double> signs(n);
+        for (size_t i = 0; i < n; i++) {
+            signs[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+        }
+        std::vector<double> z = solveTransposed(signs);
+        
+        size_t index = 0;
+        double zx = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            if (std::abs(z[i]) > std::abs(z[index])) index = i;
+            zx += z[i] * x[i];
+        }
+        if (std::abs(z[index]) <= zx || index == lastIndex) break;
+        
+        std::fill(x.begin(), x.end(), 0.0);
+        x[index] = 1.0;
+        lastIndex = index;
+    }
+    
+    std::vector<double> alternating(n);
+    for (size_t i = 0; i < n; i++) {
+        double magnitude = 1.0 + (n > 1 ? static_cast<double>(i) / (n - 1) : 0.0);
+        alternating[i] = (i % 2 == 0) ? magnitude : -magnitude;
+    }
+    double alternate = 2.0 * norm1(solve(alternating)) / (3.0 * n);
+    return std::max(estimate, alternate);
+}
+
+LUFactorization::LUFactorization(const Matrix& A) : n(squareSize(A)), lu(n * n), pivots(n) {
+    for (size_t i = 0; i < n; i++) {
+        std::copy(A.data[i].begin(), A.data[i].end(), lu.begin() + i * n);
+        pivots[i] = i;
+    }
+    norm1 = columnNorm1(A);
+    
+    double* a = lu.data();
+    for (size_t k0 = 0; k0 < n; k0 += kPanelWidth) {
+        JobContext::reportProgress(static_cast<double>(k0), static_cast<double>(n));
+        const size_t kEnd = std::min(n, k0 + kPanelWidth);
+        
+        // Factor the panel (columns k0..kEnd-1); row swaps are applied to whole rows
+        for (size_t k = k0; k < kEnd; k++) {
+            size_t pivot = k;
+            double largest = std::abs(a[k * n + k]);
+            for (size_t i = k + 1; i < n; i++) {
+                double magnitude = std::abs(a[i * n + k]);
+                if (magnitude > largest) {
+                    largest = magnitude;
+                    pivot = i;
+                }
+            }
+            if (pivot != k) {
+                std::swap_ranges(a + k * n, a + (k + 1) * n, a + pivot * n);
+                std::swap(pivots[k], pivots[pivot]);
+                pivotSign = -pivotSign;
+            }
+            
+            double diagonal = a[k * n + k];
+            if (diagonal == 0.0) {
+                singular = true;
+                continue;
+            }
+            const double* pivotRow = a + k * n;
+            for (size_t i = k + 1; i < n; i++) {
+                double* row = a + i * n;
+                double multiplier = row[k] / diagonal;
+                row[k] = multiplier;
+                for (size_t j = k + 1; j < kEnd; j++) {
+                    row[j] -= multiplier * pivotRow[j];
+                }
+            }
+        }
+        if (kEnd == n) break;
+        
+        // U12 = L11⁻¹·A12
+        for (size_t k = k0; k < kEnd; k++) {
+            const double* pivotRow = a + k * n;
+            for (size_t i = k + 1; i < kEnd; i++) {
+                double* row = a + i * n;
+                double multiplier = row[k];
+                for (size_t j = kEnd; j < n; j++) {
+                    row[j] -= multiplier * pivotRow[j];
+                }
+            }
+        }
+        
+        // A22 -= L21·U12, independently per row
+        const size_t trailing = n - kEnd;
+        size_t chunks = trailing * trailing >= kParallelUpdateElements ? parallelChunkCount(trailing, 16) : 1;
+        parallelChunks(trailing, chunks, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = kEnd + begin; i < kEnd + end; i++) {
+                double* row = a + i * n;
+                for (size_t k = k0; k < kEnd; k++) {
+                    double multiplier = row[k];
+                    if (multiplier == 0.0) continue;
+                    const double* pivotRow = a + k * n;
+                    for (size_t j = kEnd; j < n; j++) {
+                        row[j] -= multiplier * pivotRow[j];
+                    }
+                }
+            }
+        });
+        JobContext::checkpoint();
+    }
+}
+
+void LUFactorization::requireNonsingular() const {
+    if (singular) {
+        throw std::runtime_error("Matrix is singular");
+    }
+}
+
+int LUFactorization::rowSwaps() const {
+    // Count transpositions in the permutation by following its cycles
+    std::vector<bool> visited(n, false);
+    int swaps = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (visited[i]) continue;
+        size_t length = 0;
+        for (size_t j = i; !visited[j]; j = pivots[j]) {
+            visited[j] = true;
+            length++;
+        }
+        swaps += static_cast<int>(length) - 1;
+    }
+    return swaps;
+}
+
+std::vector<double> LUFactorization::solve(const std::vector<double>& b) const {
+    if (b.size() != n) {
+        throw std::invalid_argument("Right-hand side length must match the matrix size");
+    }
+    requireNonsingular();
+    
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = b[pivots[i]];
+    }
+    for (size_t i = 0; i < n; i++) {
+        const double* row = &lu[i * n];
+        double sum = x[i];
+        for (size_t k = 0; k < i; k++) {
+            sum -= row[k] * x[k];
+        }
+        x[i] = sum;
+    }
+    for (size_t i = n; i-- > 0;) {
+        const double* row = &lu[i * n];
+        double sum = x[i];
+        for (size_t k = i + 1; k < n; k++) {
+            sum -= row[k] * x[k];
+        }
+        x[i] = sum / row[i];
+    }
+    return x;
+}
+
+std::vector<double> LUFactorization::solveTransposed(const std::vector<double>& b) const {
+    if (b.size() != n) {
+        throw std::invalid_argument("Right-hand side length must match the matrix size");
+    }
+    requireNonsingular();
+    
+    // Aᵀ = UᵀLᵀP: solve Uᵀz = b, then Lᵀw = z, then x = Pᵀw. Both triangular
+    // solves run along rows of the stored factors.
+    std::vector<double> w(b);
+    for (size_t k = 0; k < n; k++) {
+        const double* row = &lu[k * n];
+        w[k] /= row[k];
+        for (size_t j = k + 1; j < n; j++) {
+            w[j] -= row[j] * w[k];
+        }
+    }
+    for (size_t k = n; k-- > 0;) {
+        const double* row = &lu[k * n];
+        for (size_t j = 0; j < k; j++) {
+            w[j] -= row[j] * w[k];
+        }
+    }
+    
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; i++) {
+        x[pivots[i]] = w[i];
+    }
+    return x;
+}
+
+Matrix LUFactorization::solve(const Matrix& B) const {
+    if (static_cast<size_t>(B.rows) != n) {
+        throw std::invalid_argument("Right-hand side rows must match the matrix size");
+    }
+    requireNonsingular();
+    
+    // Row operations on the whole right-hand side block keep the inner loops contiguous
+    const size_t m = B.cols;
+    std::vector<double> x(n * m);
+    for (size_t i = 0; i < n; i++) {
+        std::copy(B.data[pivots[i]].begin(), B.data[pivots[i]].end(), x.begin() + i * m);
+    }
+    for (size_t i = 0; i < n; i++) {
+        double* xi = &x[i * m];
+        for (size_t k = 0; k < i; k++) {
+            double factor = lu[i * n + k];
+            if (factor == 0.0) continue;
+            const double* xk = &x[k * m];
+            for (size_t j = 0; j < m; j++) xi[j] -= factor * xk[j];
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        double* xi = &x[i * m];
+        for (size_t k = i + 1; k < n; k++) {
+            double factor = lu[i * n + k];
+            if (factor == 0.0) continue;
+            const double* xk = &x[k * m];
+            for (size_t j = 0; j < m; j++) xi[j] -= factor * xk[j];
+        }
+        double diagonal = lu[i * n + i];
+        for (size_t j = 0; j < m; j++) xi[j] /= diagonal;
+    }
+    return fromRowMajor(x, n, m);
+}
+
+Matrix LUFactorization::inverse() const {
+    return solve(identity(n));
+}
+
+double LUFactorization::determinant() const {
+    double det = pivotSign;
+    for (size_t i = 0; i < n; i++) {
+        det *= lu[i * n + i];
+    }
+    return det;
+}
+
+double LUFactorization::logAbsDeterminant() const {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += std::log(std::abs(lu[i * n + i]));
+    }
+    return sum;
+}
+
+double LUFactorization::conditionEstimate() const {
+    if (singular) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double inverseNorm = inverseNorm1Estimate(n,
+        [this](const std::vector<double>& v) { return solve(v); },
+        [this](const std::vector<double>& v) { return solveTransposed(v); });
+    return norm1 * inverseNorm;
+}
+
+CholeskyFactorization::CholeskyFactorization(const Matrix& A) : n(squareSize(A)), l(n * n, 0.0) {
+    // ‖A‖₁ of the symmetric matrix implied by the lower triangle
+    for (size_t j = 0; j < n; j++) {
+        double sum = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            sum += std::abs(i >= j ? A.data[i][j] : A.data[j][i]);
+        }
+        norm1 = std::max(norm1, sum);
+    }
+    
+    // Row-by-row (Cholesky–Crout): every inner product runs along two stored rows
+    for (size_t i = 0; i < n; i++) {
+        if (i % 64 == 0) JobContext::checkpoint();
+        double* rowI = &l[i * n];
+        for (size_t j = 0; j <= i; j++) {
+            const double* rowJ = &l[j * n];
+            double sum = A.data[i][j];
+            for (size_t k = 0; k < j; k++) {
+                sum -= rowI[k] * rowJ[k];
+            }
+            if (j < i) {
+                rowI[j] = sum / rowJ[j];
+            } else if (sum > 0.0) {
+                rowI[i] = std::sqrt(sum);
+            } else {
+                positiveDefinite = false;
+                return;
+            }
+        }
+    }
+}
+
+void CholeskyFactorization::requirePositiveDefinite() const {
+    if (!positiveDefinite) {
+        throw std::runtime_error("Matrix is not positive definite");
+    }
+}
+
+std::vector<double> CholeskyFactorization::solve(const std::vector<double>& b) const {
+    if (b.size() != n) {
+        throw std::invalid_argument("Right-hand side length must match the matrix size");
+    }
+    requirePositiveDefinite();
+    
+    std::vector<double> x(b);
+    for (size_t i = 0; i < n; i++) {
+        const double* row = &l[i * n];
+        double sum = x[i];
+        for (size_t k = 0; k < i; k++) {
+            sum -= row[k] * x[k];
+        }
+        x[i] = sum / row[i];
+    }
+    // Lᵀx = y, eliminating along rows of L
+    for (size_t i = n; i-- > 0;) {
+        const double* row = &l[i * n];
+        x[i] /= row[i];
+        for (size_t k = 0; k < i; k++) {
+            x[k] -= row[k] * x[i];
+        }
+    }
+    return x;
+}
+
+Matrix CholeskyFactorization::solve(const Matrix& B) const {
+    if (static_cast<size_t>(B.rows) != n) {
+        throw std::invalid_argument("Right-hand side rows must match the matrix size");
+    }
+    requirePositiveDefinite();
+    
+    const size_t m = B.cols;
+    std::vector<double> x(n * m);
+    for (size_t i = 0; i < n; i++) {
+        std::copy(B.data[i].begin(), B.data[i].end(), x.begin() + i * m);
+    }
+    for (size_t i = 0; i < n; i++) {
+        double* xi = &x[i * m];
+        for (size_t k = 0; k < i; k++) {
+            double factor = l[i * n + k];
+            const double* xk = &x[k * m];
+            for (size_t j = 0; j < m; j++) xi[j] -= factor * xk[j];
+        }
+        double diagonal = l[i * n + i];
+        for (size_t j = 0; j < m; j++) xi[j] /= diagonal;
+    }
+    for (size_t i = n; i-- > 0;) {
+        double* xi = &x[i * m];
+        double diagonal = l[i * n + i];
+        for (size_t j = 0; j < m; j++) xi[j] /= diagonal;
+        for (size_t k = 0; k < i; k++) {
+            double factor = l[i * n + k];
+            double* xk = &x[k * m];
+            for (size_t j = 0; j < m; j++) xk[j] -= factor * xi[j];
+        }
+    }
+    return fromRowMajor(x, n, m);
+}
+
+Matrix CholeskyFactorization::inverse() const {
+    return solve(identity(n));
+}
+
+double CholeskyFactorization::determinant() const {
+    requirePositiveDefinite();
+    double det = 1.0;
+    for (size_t i = 0; i < n; i++) {
+        det *= l[i * n + i] * l[i * n + i];
+    }
+    return det;
+}
+
+double CholeskyFactorization::logDeterminant() const {
+    requirePositiveDefinite();
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += 2.0 * std::log(l[i * n + i]);
+    }
+    return sum;
+}
+
+double CholeskyFactorization::conditionEstimate() const {
+    if (!positiveDefinite) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // A is symmetric, so Aᵀ solves are A solves
+    auto solver = [this](const std::vector<double>& v) { return solve(v); };
+    return norm1 * inverseNorm1Estimate(n, solver, solver);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "matrix_operations.h"
+
+// Factorizations of a square Matrix that are computed once and then reused:
+// each solve against a new right-hand side costs O(n²), not another O(n³)
+// factorization. Both keep their factors in one contiguous row-major buffer.
+
+// PA = LU with partial (row) pivoting. The factorization is blocked: panels of
+// columns are factored, then the trailing submatrix gets one rank-k update per
+// panel, split across threads by rows. A singular A still factors (a zero
+// pivot is recorded); solving with it throws std::runtime_error.
+class LUFactorization {
+private:
+    size_t n;
+    std::vector<double> lu;        // Unit-lower L below the diagonal, U on and above
+    std::vector<size_t> pivots;    // Row i of PA is row pivots[i] of A
+    int pivotSign = 1;
+    double norm1 = 0.0;            // ‖A‖₁, for the condition estimate
+    bool singular = false;
+    
+    void requireNonsingular() const;
+
+public:
+    // Throws std::invalid_argument for a non-square matrix
+    explicit LUFactorization(const Matrix& A);
+    
+    size_t size() const { return n; }
+    bool isSingular() const { return singular; }
+    int rowSwaps() const;
+    
+    std::vector<double> solve(const std::vector<double>& b) const;
+    std::vector<double> solveTransposed(const std::vector<double>& b) const;  // Aᵀx = b
+    Matrix solve(const Matrix& B) const;
+    Matrix inverse() const;
+    
+    double determinant() const;
+    double logAbsDeterminant() const;   // ln|det A|, finite where det over/underflows
+    
+    // Estimate of κ₁(A) = ‖A‖₁·‖A⁻¹‖₁ (Hager/Higham, a few O(n²) solves);
+    // infinity when A is singular
+    double conditionEstimate() const;
+};
+
+// A = LLᵀ for symmetric positive definite A; only the lower triangle of A is
+// read. Half the work of LU and no pivoting. Whether A was positive definite
+// is reported by isPositiveDefinite(); solving otherwise throws
+// std::runtime_error.
+class CholeskyFactorization {
+private:
+    size_t n;
+    std::vector<double> l;         // Lower triangle of L, row-major
+    double norm1 = 0.0;
+    bool positiveDefinite = true;
+    
+    void requirePositiveDefinite() const;
+
+public:
+    // Throws std::invalid_argument for a non-square matrix
+    explicit CholeskyFactorization(const Matrix& A);
+    
+    size_t size() const { return n; }
+    bool isPositiveDefinite() const { return positiveDefinite; }
+    
+    std::vector<double> solve(const std::vector<double>& b) const;
+    Matrix solve(const Matrix& B) const;
+    Matrix inverse() const;
+    
+    double determinant() const;
+    double logDeterminant() const;
+    double conditionEstimate() const;
+};
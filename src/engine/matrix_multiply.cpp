@@ -0,0 +1,268 @@
+#include "matrix_multiply.h"
+#include "job_system.h"
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+// Tile sizes for blocked(): a kTileK × kTileN panel of B (256 KB) stays in L2
+// while every row of A passes over it
+static const size_t kTileK = 128;
+static const size_t kTileN = 256;
+// Rows of C between progress reports in blockedParallel()
+static const size_t kProgressRows = 64;
+
+namespace matrix_multiply {
+
+// Share of one product done so far, reported to the job that started it:
+// the threads of parallelChunks have no current job of their own
+struct ProductProgress {
+    JobContext* job = JobContext::current();
+    std::atomic<size_t> done{0};
+    size_t total;
+    
+    explicit ProductProgress(size_t total) : total(std::max<size_t>(1, total)) {}
+    
+    void advance(size_t units) {
+        size_t now = done.fetch_add(units, std::memory_order_relaxed) + units;
+        if (!job) return;
+        job->setProgress(static_cast<float>(std::min(1.0, static_cast<double>(now) / total)));
+        if (job->isCancelled()) {
+            throw JobCancelled();
+        }
+    }
+};
+
+static void axpyRow(double a, const double* __restrict b, double* __restrict c, size_t n) {
+    for (size_t j = 0; j < n; j++) {
+        c[j] += a * b[j];
+    }
+}
+
+void blocked(size_t m, size_t k, size_t n, const double* A, size_t lda,
+             const double* B, size_t ldb, double* C, size_t ldc, bool accumulate) {
+    if (!accumulate) {
+        for (size_t i = 0; i < m; i++) {
+            std::fill(C + i * ldc, C + i * ldc + n, 0.0);
+        }
+    }
+    for (size_t j0 = 0; j0 < n; j0 += kTileN) {
+        size_t width = std::min(kTileN, n - j0);
+        for (size_t p0 = 0; p0 < k; p0 += kTileK) {
+            size_t depth = std::min(kTileK, k - p0);
+            for (size_t i = 0; i < m; i++) {
+                const double* a = A + i * lda + p0;
+                double* c = C + i * ldc + j0;
+                for (size_t p = 0; p < depth; p++) {
+                    axpyRow(a[p], B + (p0 + p) * ldb + j0, c, width);
+                }
+            }
+        }
+    }
+}
+
+void blockedParallel(size_t m, size_t k, size_t n, const double* A, size_t lda,
+                     const double* B, size_t ldb, double* C, size_t ldc) {
+    // At least ~2M multiply-adds per thread
+    size_t rowsPerChunk = std::max<size_t>(8, (size_t(1) << 21) / std::max<size_t>(1, k * n));
+    size_t chunks = parallelChunkCount(m, rowsPerChunk);
+    ProductProgress progress(m);
+    parallelChunks(m, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t row = begin; row < end; row += kProgressRows) {
+            size_t rows = std::min(kProgressRows, end - row);
+            blocked(rows, k, n, A + row * lda, lda, B, ldb, C + row * ldc, ldc);
+            progress.advance(rows);
+        }
+    });
+}
+
+// Z = X + Y and Z = X - Y on h×h strided blocks
+static void addBlocks(size_t h, const double* X, size_t ldx, const double* Y, size_t ldy, double* Z, size_t ldz) {
+    for (size_t i = 0; i < h; i++) {
+        const double* x = X + i * ldx;
+        const double* y = Y + i * ldy;
+        double* z = Z + i * ldz;
+        for (size_t j = 0; j < h; j++) z[j] = x[j] + y[j];
+    }
+}
+
+static void subtractBlocks(size_t h, const double* X, size_t ldx, const double* Y, size_t ldy, double* Z, size_t ldz) {
+    for (size_t i = 0; i < h; i++) {
+        const double* x = X + i * ldx;
+        const double* y = Y + i * ldy;
+        double* z = Z + i * ldz;
+        for (size_t j = 0; j < h; j++) z[j] = x[j] - y[j];
+    }
+}
+
+size_t strassenLevels(size_t n, size_t cutoff) {
+    size_t levels = 0;
+    cutoff = std::max<size_t>(cutoff, 1);
+    while (n > cutoff) {
+        n = (n + 1) / 2;
+        levels++;
+    }
+    return levels;
+}
+
+// Workspace needed below a block of size n: two h×h temporaries at each level
+static size_t workspaceSize(size_t n, size_t levels) {
+    size_t total = 0;
+    for (size_t level = 0; level < levels; level++) {
+        n /= 2;
+        total += 2 * n * n;
+    }
+    return total;
+}
+
+// n is divisible by 2^levels. Each level takes two h×h temporaries X (A-side)
+// and Y (B-side) from the front of the workspace and hands the rest to the
+// seven sub-products, which run one after another and so share it. The
+// schedule (Boyer, Dumas, Pernet and Zhou) writes the products straight into
+// the quadrants of C, which is why two temporaries suffice. Progress
+// advances by one per leaf product, 7^levels in all.
+static void strassenRecursive(size_t n, size_t levels, const double* A, size_t lda,
+                              const double* B, size_t ldb, double* C, size_t ldc, double* workspace,
+                              ProductProgress& progress) {
+    if (levels == 0) {
+        blocked(n, n, n, A, lda, B, ldb, C, ldc);
+        progress.advance(1);
+        return;
+    }
+    JobContext::checkpoint();
+    
+    const size_t h = n / 2;
+    const double* A11 = A;
+    const double* A12 = A + h;
+    const double* A21 = A + h * lda;
+    const double* A22 = A + h * lda + h;
+    const double* B11 = B;
+    const double* B12 = B + h;
+    const double* B21 = B + h * ldb;
+    const double* B22 = B + h * ldb + h;
+    double* C11 = C;
+    double* C12 = C + h;
+    double* C21 = C + h * ldc;
+    double* C22 = C + h * ldc + h;
+    double* X = workspace;
+    double* Y = workspace + h * h;
+    double* rest = workspace + 2 * h * h;
+    const size_t next = levels - 1;
+    
+    subtractBlocks(h, A11, lda, A21, lda, X, h);                               // S3 = A11 - A21
+    subtractBlocks(h, B22, ldb, B12, ldb, Y, h);                               // T3 = B22 - B12
+    strassenRecursive(h, next, X, h, Y, h, C21, ldc, rest, progress);          // P7 = S3·T3
+    addBlocks(h, A21, lda, A22, lda, X, h);                                    // S1 = A21 + A22
+    subtractBlocks(h, B12, ldb, B11, ldb, Y, h);                               // T1 = B12 - B11
+    strassenRecursive(h, next, X, h, Y, h, C22, ldc, rest, progress);          // P5 = S1·T1
+    subtractBlocks(h, X, h, A11, lda, X, h);                                   // S2 = S1 - A11
+    subtractBlocks(h, B22, ldb, Y, h, Y, h);                                   // T2 = B22 - T1
+    strassenRecursive(h, next, X, h, Y, h, C12, ldc, rest, progress);          // P6 = S2·T2
+    subtractBlocks(h, A12, lda, X, h, X, h);                                   // S4 = A12 - S2
+    strassenRecursive(h, next, X, h, B22, ldb, C11, ldc, rest, progress);      // P3 = S4·B22
+    strassenRecursive(h, next, A11, lda, B11, ldb, X, h, rest, progress);      // P1 = A11·B11
+    addBlocks(h, X, h, C12, ldc, C12, ldc);                                    // U2 = P1 + P6
+    addBlocks(h, C12, ldc, C21, ldc, C21, ldc);                                // U3 = U2 + P7
+    addBlocks(h, C12, ldc, C22, ldc, C12, ldc);                                // U4 = U2 + P5
+    addBlocks(h, C21, ldc, C22, ldc, C22, ldc);                                // U7 = U3 + P5 = C22
+    addBlocks(h, C12, ldc, C11, ldc, C12, ldc);                                // U5 = U4 + P3 = C12
+    subtractBlocks(h, Y, h, B21, ldb, Y, h);                                   // T4 = T2 - B21
+    strassenRecursive(h, next, A22, lda, Y, h, C11, ldc, rest, progress);      // P4 = A22·T4
+    subtractBlocks(h, C21, ldc, C11, ldc, C21, ldc);                           // U6 = U3 - P4 = C21
+    strassenRecursive(h, next, A12, lda, B21, ldb, C11, ldc, rest, progress);  // P2 = A12·B21
+    addBlocks(h, X, h, C11, ldc, C11, ldc);                                    // U1 = P1 + P2 = C11
+}
+
+void strassen(size_t n, const double* A, size_t lda, const double* B, size_t ldb,
+              double* C, size_t ldc, size_t cutoff) {
+    const size_t levels = strassenLevels(n, cutoff);
+    const size_t unit = size_t(1) << levels;
+    const size_t padded = (n + unit - 1) / unit * unit;
+    std::vector<double> workspace(workspaceSize(padded, levels));
+    size_t leaves = 1;
+    for (size_t level = 0; level < levels; level++) leaves *= 7;
+    ProductProgress progress(leaves);
+    
+    if (padded == n) {
+        strassenRecursive(n, levels, A, lda, B, ldb, C, ldc, workspace.data(), progress);
+        return;
+    }
+    
+    // Zero-pad to the next multiple of 2^levels; the extra rows and columns
+    // contribute nothing to the top-left n×n block
+    std::vector<double> a(padded * padded, 0.0), b(padded * padded, 0.0), c(padded * padded);
+    for (size_t i = 0; i < n; i++) {
+        std::copy(A + i * lda, A + i * lda + n, a.begin() + i * padded);
+        std::copy(B + i * ldb, B + i * ldb + n, b.begin() + i * padded);
+    }
+    strassenRecursive(padded, levels, a.data(), padded, b.data(), padded, c.data(), padded, workspace.data(), progress);
+    for (size_t i = 0; i < n; i++) {
+        std::copy(c.begin() + i * padded, c.begin() + i * padded + n, C + i * ldc);
+    }
+}
+
+static std::vector<double> toRowMajor(const Matrix& M) {
+    std::vector<double> values(static_cast<size_t>(M.rows) * M.cols);
+    for (int i = 0; i < M.rows; i++) {
+        std::copy(M.data[i].begin(), M.data[i].end(), values.begin() + static_cast<size_t>(i) * M.cols);
+    }
+    return values;
+}
+
+Matrix multiply(const Matrix& A, const Matrix& B, const MultiplyOptions& options) {
+    if (A.cols != B.rows) {
+        throw std::invalid_argument("Cannot multiply: columns of A must equal rows of B");
+    }
+    const size_t m = A.rows, k = A.cols, n = B.cols;
+    std::vector<double> a = toRowMajor(A);
+    std::vector<double> b = toRowMajor(B);
+    std::vector<double> c(m * n);
+    
+    bool square = (m == k && k == n);
+    if (options.allowStrassen && square && n > options.strassenCutoff) {
+        strassen(n, a.data(), n, b.data(), n, c.data(), n, options.strassenCutoff);
+    } else {
+        blockedParallel(m, k, n, a.data(), k, b.data(), n, c.data(), n);
+    }
+    
+    Matrix result(static_cast<int>(m), static_cast<int>(n));
+    for (size_t i = 0; i < m; i++) {
+        std::copy(c.begin() + i * n, c.begin() + (i + 1) * n, result.data[i].begin());
+    }
+    return result;
+}
+
+std::vector<CrossoverTiming> benchmarkCrossover(const std::vector<size_t>& sizes, size_t cutoff) {
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    std::vector<CrossoverTiming> timings;
+    
+    for (size_t n : sizes) {
+        std::vector<double> a(n * n), b(n * n), blockedResult(n * n), strassenResult(n * n);
+        for (double& value : a) value = distribution(generator);
+        for (double& value : b) value = distribution(generator);
+        
+        auto start = std::chrono::steady_clock::now();
+        blocked(n, n, n, a.data(), n, b.data(), n, blockedResult.data(), n);
+        auto middle = std::chrono::steady_clock::now();
+        strassen(n, a.data(), n, b.data(), n, strassenResult.data(), n, cutoff);
+        auto end = std::chrono::steady_clock::now();
+        
+        CrossoverTiming timing;
+        timing.n = n;
+        timing.levels = strassenLevels(n, cutoff);
+        timing.blockedSeconds = std::chrono::duration<double>(middle - start).count();
+        timing.strassenSeconds = std::chrono::duration<double>(end - middle).count();
+        timing.maxDifference = 0.0;
+        for (size_t i = 0; i < n * n; i++) {
+            timing.maxDifference = std::max(timing.maxDifference, std::abs(blockedResult[i] - strassenResult[i]));
+        }
+        timings.push_back(timing);
+    }
+    return timings;
+}
+
+} // namespace matrix_multiply
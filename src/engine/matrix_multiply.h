@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "matrix_operations.h"
+
+struct MultiplyOptions {
+    bool allowStrassen = true;
+    // Square products larger than this recurse with Strassen–Winograd; tiles
+    // at or below it use the blocked kernel. The best value depends on the
+    // machine: see matrix_multiply::benchmarkCrossover.
+    size_t strassenCutoff = 256;
+};
+
+// Dense matrix products on contiguous row-major buffers (leading dimension =
+// row stride), used by MatrixOperations::multiply once matrices are too big
+// to show every element.
+namespace matrix_multiply {
+
+// C = A·B (or C += A·B when accumulate) for A m×k and B k×n. Tiled so a
+// panel of B stays in cache while rows of A stream past it; the innermost
+// loop is a unit-stride axpy the compiler vectorizes.
+void blocked(size_t m, size_t k, size_t n, const double* A, size_t lda,
+             const double* B, size_t ldb, double* C, size_t ldc, bool accumulate = false);
+
+// Same product with the rows of C split across threads
+void blockedParallel(size_t m, size_t k, size_t n, const double* A, size_t lda,
+                     const double* B, size_t ldb, double* C, size_t ldc);
+
+// Square C = A·B by Strassen–Winograd (7 half-size products, 15 additions)
+// down to tiles of at most cutoff, which go to blocked(). n is padded with
+// zeros to a multiple of 2^levels when needed. All temporaries come from one
+// workspace allocated up front, about (2/3)·n² doubles, rather than per level.
+void strassen(size_t n, const double* A, size_t lda, const double* B, size_t ldb,
+              double* C, size_t ldc, size_t cutoff);
+
+// Number of halvings strassen() performs for size n
+size_t strassenLevels(size_t n, size_t cutoff);
+
+// Picks strassen() for square products above the cutoff, blockedParallel()
+// otherwise. Throws std::invalid_argument when A.cols != B.rows.
+Matrix multiply(const Matrix& A, const Matrix& B, const MultiplyOptions& options = {});
+
+struct CrossoverTiming {
+    size_t n;
+    size_t levels;              // Strassen recursion depth at this size
+    double blockedSeconds;
+    double strassenSeconds;
+    double maxDifference;       // max |C_blocked - C_strassen|, to show the accuracy cost
+};
+
+// Times blocked (serial, so the comparison is like for like) against
+// strassen() on random n×n matrices for each size
+std::vector<CrossoverTiming> benchmarkCrossover(const std::vector<size_t>& sizes, size_t cutoff);
+
+} // namespace matrix_multiply
@@ -1,4 +1,8 @@
 #include "matrix_operations.h"
+#include "job_system.h"
+#include "matrix_factorization.h"
+#include "matrix_multiply.h"
+#include <cmath>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
@@ -58,6 +62,9 @@ std::string Matrix::toString() const {
     return oss.str();
 }
 
+// Products with at least this many multiply-adds (about 64³) use matrix_multiply
+static const double kKernelMultiplyWork = 262144.0;
+
 bool MatrixOperations::canMultiply(const Matrix& A, const Matrix& B) const {
     return A.cols == B.rows;
 }
@@ -102,10 +109,26 @@ Matrix MatrixOperations::multiply(const Matrix& A, const Matrix& B) {
     steps.push_back({"Formula", "C[i][j] = Σ(k=0 to n-1) A[i][k] × B[k][j]"});
     
     // Step 6: Perform multiplication with detailed steps (show first few calculations)
-    int stepCount = 0;
+    long long stepCount = 0;
     int maxStepsToShow = 6; // Limit detailed steps for large matrices
     
+    // Large products go through the blocked/Strassen kernels, which report
+    // progress themselves; only the shown elements are recomputed here for
+    // their steps
+    double work = static_cast<double>(A.rows) * A.cols * B.cols;
+    bool useKernels = work >= kKernelMultiplyWork;
+    if (useKernels) {
+        result = matrix_multiply::multiply(A, B);
+    }
+    
     for (int i = 0; i < A.rows; i++) {
+        if (useKernels && stepCount >= maxStepsToShow) {
+            stepCount = static_cast<long long>(A.rows) * B.cols;
+            break;
+        }
+        if (!useKernels) {
+            JobContext::reportProgress(i, A.rows);
+        }
         for (int j = 0; j < B.cols; j++) {
             double sum = 0.0;
             std::ostringstream calcOss;
@@ -125,14 +148,16 @@ Matrix MatrixOperations::multiply(const Matrix& A, const Matrix& B) {
                 
                 calcOss << " = " << std::fixed << std::setprecision(2) << sum;
                 steps.push_back({"Computing element [" + std::to_string(i) + "][" + std::to_string(j) + "]", calcOss.str()});
-            } else {
+            } else if (!useKernels) {
                 // Just compute without showing steps for large matrices
                 for (int k = 0; k < A.cols; k++) {
                     sum += A.get(i, k) * B.get(k, j);
                 }
             }
             
-            result.set(i, j, sum);
+            if (!useKernels) {
+                result.set(i, j, sum);
+            }
             stepCount++;
         }
     }
@@ -146,3 +171,103 @@ Matrix MatrixOperations::multiply(const Matrix& A, const Matrix& B) {
     
     return result;
 }
+
+// Shared steps for the LU-based operations: factorization summary and conditioning
+static void addFactorizationSteps(std::vector<MatrixStep>& steps, const LUFactorization& lu) {
+    std::ostringstream factorOss;
+    factorOss << "PA = LU with partial pivoting (" << lu.size() << "×" << lu.size() << ", "
+              << lu.rowSwaps() << " row swap" << (lu.rowSwaps() == 1 ? "" : "s") << ")";
+    steps.push_back({"LU Factorization", factorOss.str()});
+    
+    if (lu.isSingular()) {
+        steps.push_back({"Singular Matrix", "A zero pivot appeared: det(A) = 0 and A has no inverse"});
+        return;
+    }
+    
+    double condition = lu.conditionEstimate();
+    std::ostringstream conditionOss;
+    conditionOss << std::scientific << std::setprecision(3) << "κ₁(A) ≈ " << condition;
+    if (condition > 1e12) {
+        conditionOss << "\nWarning: A is ill-conditioned; results may have few correct digits";
+    }
+    steps.push_back({"Condition Estimate", conditionOss.str()});
+}
+
+Matrix MatrixOperations::solve(const Matrix& A, const Matrix& B) {
+    steps.clear();
+    
+    std::ostringstream dimOss;
+    dimOss << "Solve A·X = B with A: " << A.rows << "×" << A.cols << ", B: " << B.rows << "×" << B.cols;
+    steps.push_back({"Matrix Dimensions", dimOss.str()});
+    
+    if (A.rows != A.cols || B.rows != A.rows) {
+        std::string error = "A must be square and B must have as many rows as A";
+        steps.push_back({"Error - Invalid Dimensions", error});
+        throw std::invalid_argument(error);
+    }
+    
+    LUFactorization lu(A);
+    addFactorizationSteps(steps, lu);
+    if (lu.isSingular()) {
+        throw std::runtime_error("Matrix is singular");
+    }
+    
+    steps.push_back({"Substitution", "Ly = PB (forward), then UX = y (backward), O(n²) per column"});
+    Matrix result = lu.solve(B);
+    steps.push_back({"Solution X", result.toString()});
+    return result;
+}
+
+Matrix MatrixOperations::inverse(const Matrix& A) {
+    steps.clear();
+    
+    std::ostringstream dimOss;
+    dimOss << "Matrix A: " << A.rows << "×" << A.cols;
+    steps.push_back({"Matrix Dimensions", dimOss.str()});
+    
+    if (A.rows != A.cols) {
+        std::string error = "Only square matrices have an inverse";
+        steps.push_back({"Error - Invalid Dimensions", error});
+        throw std::invalid_argument(error);
+    }
+    
+    LUFactorization lu(A);
+    addFactorizationSteps(steps, lu);
+    if (lu.isSingular()) {
+        throw std::runtime_error("Matrix is singular");
+    }
+    
+    steps.push_back({"Inverse", "Solve A·X = I, one substitution pair per column of I"});
+    Matrix result = lu.inverse();
+    steps.push_back({"Inverse Matrix", result.toString()});
+    return result;
+}
+
+double MatrixOperations::determinant(const Matrix& A) {
+    steps.clear();
+    
+    std::ostringstream dimOss;
+    dimOss << "Matrix A: " << A.rows << "×" << A.cols;
+    steps.push_back({"Matrix Dimensions", dimOss.str()});
+    
+    if (A.rows != A.cols) {
+        std::string error = "Only square matrices have a determinant";
+        steps.push_back({"Error - Invalid Dimensions", error});
+        throw std::invalid_argument(error);
+    }
+    
+    LUFactorization lu(A);
+    addFactorizationSteps(steps, lu);
+    
+    double det = lu.determinant();
+    std::ostringstream detOss;
+    detOss << "det(A) = (-1)^" << lu.rowSwaps() << " × Π uᵢᵢ = ";
+    if (lu.isSingular() || (std::isfinite(det) && std::abs(det) >= 1e-300)) {
+        detOss << std::setprecision(10) << det;
+    } else {
+        // Over/underflowed product: report it through its logarithm
+        detOss << (std::signbit(det) ? "-" : "") << "exp(" << std::setprecision(10) << lu.logAbsDeterminant() << ")";
+    }
+    steps.push_back({"Determinant", detOss.str()});
+    return det;
+}
@@ -27,6 +27,13 @@ private:
     
 public:
     Matrix multiply(const Matrix& A, const Matrix& B);
+    
+    // Via LUFactorization (matrix_factorization.h); construct one directly to
+    // reuse the factors across many right-hand sides
+    Matrix solve(const Matrix& A, const Matrix& B);
+    Matrix inverse(const Matrix& A);
+    double determinant(const Matrix& A);
+    
     const std::vector<MatrixStep>& getSteps() const { return steps; }
     void clearSteps() { steps.clear(); }
     
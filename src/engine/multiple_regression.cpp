@@ -0,0 +1,284 @@
+#include "multiple_regression.h"
+#include "job_system.h"
+#include "matrix_factorization.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+// Rows per block: the centered block tile (rows × variables) stays in cache
+// while its cross products are taken
+static const size_t kBlockRows = 256;
+
+// Means and centered cross-product matrix of m variables over n rows
+struct CoMoments {
+    size_t n = 0;
+    size_t m;
+    std::vector<double> mean;
+    std::vector<double> cross;  // m×m row-major, upper triangle only
+    
+    explicit CoMoments(size_t m) : m(m), mean(m, 0.0), cross(m * m, 0.0) {}
+    
+    // Pairwise update: C = Ca + Cb + (na·nb/n)·δδᵀ with δ = mean_b - mean_a
+    void merge(const CoMoments& other) {
+        if (other.n == 0) return;
+        if (n == 0) {
+            *this = other;
+            return;
+        }
+        
+        double na = static_cast<double>(n);
+        double nb = static_cast<double>(other.n);
+        double nt = na + nb;
+        double factor = na * nb / nt;
+        
+        std::vector<double> delta(m);
+        for (size_t j = 0; j < m; j++) {
+            delta[j] = other.mean[j] - mean[j];
+        }
+        for (size_t j = 0; j < m; j++) {
+            for (size_t k = j; k < m; k++) {
+                cross[j * m + k] += other.cross[j * m + k] + factor * delta[j] * delta[k];
+            }
+        }
+        for (size_t j = 0; j < m; j++) {
+            mean[j] += delta[j] * nb / nt;
+        }
+        n += other.n;
+    }
+};
+
+// Centers rows [begin, end) of the columns around their block mean and
+// accumulates the block's cross products into 'block' (overwritten)
+static void blockCoMoments(const std::vector<DoubleSpan>& columns, size_t begin, size_t end,
+                           std::vector<double>& tile, CoMoments& block) {
+    const size_t m = columns.size();
+    const size_t rows = end - begin;
+    tile.resize(rows * m);
+    block.n = rows;
+    std::fill(block.cross.begin(), block.cross.end(), 0.0);
+    
+    for (size_t j = 0; j < m; j++) {
+        const double* column = columns[j].data() + begin;
+        double sum = 0.0;
+        for (size_t r = 0; r < rows; r++) {
+            sum += column[r];
+        }
+        double blockMean = sum / rows;
+        block.mean[j] = blockMean;
+        for (size_t r = 0; r < rows; r++) {
+            tile[r * m + j] = column[r] - blockMean;
+        }
+    }
+    
+    // Rank-1 update per row over the upper triangle; the inner loop is contiguous
+    for (size_t r = 0; r < rows; r++) {
+        const double* row = &tile[r * m];
+        for (size_t j = 0; j < m; j++) {
+            double rj = row[j];
+            double* crossRow = &block.cross[j * m];
+            for (size_t k = j; k < m; k++) {
+                crossRow[k] += rj * row[k];
+            }
+        }
+    }
+}
+
+void MultipleRegression::fit(const std::vector<DoubleSpan>& features, DoubleSpan response,
+                             const std::vector<std::string>& names) {
+    steps.clear();
+    coefficients.clear();
+    standardErrors.clear();
+    
+    const size_t p = features.size();
+    const size_t n = response.size();
+    if (p == 0) {
+        throw std::invalid_argument("Regression needs at least one feature column");
+    }
+    for (const DoubleSpan& feature : features) {
+        if (feature.size() != n) {
+            throw std::invalid_argument("All feature columns must have the same length as the response");
+        }
+    }
+    if (n <= p + 1) {
+        throw std::invalid_argument("Need more observations than coefficients (n > p + 1)");
+    }
+    
+    featureNames.clear();
+    for (size_t j = 0; j < p; j++) {
+        featureNames.push_back(j < names.size() && !names[j].empty() ? names[j] : "x" + std::to_string(j + 1));
+    }
+    observations = n;
+    
+    // Response is the last variable so its moments come out of the same pass
+    std::vector<DoubleSpan> columns(features);
+    columns.push_back(response);
+    const size_t m = p + 1;
+    
+    JobContext* job = JobContext::current();
+    size_t chunks = parallelChunkCount(n, size_t(1) << 15);
+    std::vector<CoMoments> partials(chunks, CoMoments(m));
+    
+    parallelChunks(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        std::vector<double> tile;
+        CoMoments block(m);
+        for (size_t start = begin; start < end; start += kBlockRows) {
+            if (job && job->isCancelled()) {
+                throw JobCancelled();
+            }
+            blockCoMoments(columns, start, std::min(end, start + kBlockRows), tile, block);
+            partials[chunk].merge(block);
+            if (job && chunk == 0) {
+                job->setProgress(static_cast<float>(start - begin) / (end - begin));
+            }
+        }
+    });
+    
+    CoMoments total = partials[0];
+    for (size_t c = 1; c < chunks; c++) {
+        total.merge(partials[c]);
+    }
+    
+    StatisticsStep header;
+    header.description = "=== Multiple Linear Regression ===";
+    std::ostringstream ossHeader;
+    ossHeader << "Observations: n = " << n << ", features: p = " << p;
+    header.expression = ossHeader.str();
+    steps.push_back(header);
+    
+    StatisticsStep model;
+    model.description = "Model:";
+    std::ostringstream ossModel;
+    ossModel << "y = b0";
+    for (size_t j = 0; j < p; j++) {
+        ossModel << " + b" << (j + 1) << "·" << featureNames[j];
+    }
+    model.expression = ossModel.str();
+    steps.push_back(model);
+    
+    StatisticsStep method;
+    method.description = "Centered normal equations:";
+    std::ostringstream ossMethod;
+    ossMethod << "Sxx·b = Sxy  (" << p << "×" << p << ", " << chunks << " chunk"
+              << (chunks == 1 ? "" : "s") << " of " << kBlockRows << "-row blocks), solved by Cholesky\n";
+    ossMethod << "b0 = ȳ - Σ bj·x̄j";
+    method.expression = ossMethod.str();
+    steps.push_back(method);
+    
+    // Split [X y]ᵀ[X y] into Sxx, Sxy and Syy. Sxx is factored in correlation
+    // form R = D⁻¹·Sxx·D⁻¹ (D = diag √Sxx_jj) so collinearity is judged
+    // independently of the features' units.
+    std::vector<double> scale(p);
+    for (size_t j = 0; j < p; j++) {
+        scale[j] = std::sqrt(total.cross[j * m + j]);
+        if (!(scale[j] > 0.0)) {
+            throw std::runtime_error("Feature '" + featureNames[j] + "' is constant; XᵀX is singular");
+        }
+    }
+    Matrix correlation(static_cast<int>(p), static_cast<int>(p));
+    std::vector<double> scaledSxy(p);
+    for (size_t j = 0; j < p; j++) {
+        for (size_t k = j; k < p; k++) {
+            double r = total.cross[j * m + k] / (scale[j] * scale[k]);
+            correlation.data[j][k] = r;
+            correlation.data[k][j] = r;
+        }
+        scaledSxy[j] = total.cross[j * m + p] / scale[j];
+    }
+    double syy = total.cross[p * m + p];
+    
+    CholeskyFactorization cholesky(correlation);
+    if (!cholesky.isPositiveDefinite() || cholesky.conditionEstimate() > 1e12) {
+        throw std::runtime_error("Features are collinear (or constant); XᵀX is singular");
+    }
+    
+    // Sxx⁻¹ = D⁻¹·R⁻¹·D⁻¹
+    std::vector<double> slopes = cholesky.solve(scaledSxy);
+    for (size_t j = 0; j < p; j++) {
+        slopes[j] /= scale[j];
+    }
+    double intercept = total.mean[p];
+    for (size_t j = 0; j < p; j++) {
+        intercept -= slopes[j] * total.mean[j];
+    }
+    coefficients.push_back(intercept);
+    coefficients.insert(coefficients.end(), slopes.begin(), slopes.end());
+    
+    // SSE = Syy - bᵀSxy for the least-squares b
+    double explained = 0.0;
+    for (size_t j = 0; j < p; j++) {
+        explained += slopes[j] * total.cross[j * m + p];
+    }
+    double sse = std::max(0.0, syy - explained);
+    double degreesOfFreedom = static_cast<double>(n - p - 1);
+    double sigma2 = sse / degreesOfFreedom;
+    residualStdError = std::sqrt(sigma2);
+    rSquared = syy > 0.0 ? 1.0 - sse / syy : 1.0;
+    adjustedRSquared = 1.0 - (1.0 - rSquared) * (n - 1) / degreesOfFreedom;
+    
+    // Var(b) = σ²·Sxx⁻¹; Var(b0) = σ²·(1/n + x̄ᵀSxx⁻¹x̄)
+    Matrix correlationInverse = cholesky.inverse();
+    std::vector<double> scaledMeans(p);
+    for (size_t j = 0; j < p; j++) {
+        scaledMeans[j] = total.mean[j] / scale[j];
+    }
+    double interceptVariance = 1.0 / n;
+    for (size_t j = 0; j < p; j++) {
+        for (size_t k = 0; k < p; k++) {
+            interceptVariance += scaledMeans[j] * correlationInverse.data[j][k] * scaledMeans[k];
+        }
+    }
+    standardErrors.push_back(std::sqrt(sigma2 * interceptVariance));
+    
+    for (size_t j = 0; j < p; j++) {
+        standardErrors.push_back(std::sqrt(sigma2 * correlationInverse.data[j][j]) / scale[j]);
+    }
+    
+    StatisticsStep coefficientStep;
+    coefficientStep.description = "--- Coefficients (estimate, standard error, t) ---";
+    std::ostringstream ossCoefficients;
+    ossCoefficients << std::fixed << std::setprecision(4);
+    for (size_t j = 0; j <= p; j++) {
+        if (j > 0) ossCoefficients << "\n";
+        ossCoefficients << "b" << j << " (" << (j == 0 ? "intercept" : featureNames[j - 1]) << ") = "
+                        << coefficients[j] << ", SE = " << standardErrors[j];
+        if (standardErrors[j] > 0.0) {
+            ossCoefficients << ", t = " << coefficients[j] / standardErrors[j];
+        }
+    }
+    coefficientStep.expression = ossCoefficients.str();
+    steps.push_back(coefficientStep);
+    
+    StatisticsStep fitStep;
+    fitStep.description = "--- Goodness of Fit ---";
+    std::ostringstream ossFit;
+    ossFit << std::fixed << std::setprecision(4);
+    ossFit << "R² = 1 - SSE/SST = " << rSquared << ", adjusted R² = " << adjustedRSquared << "\n";
+    ossFit << "Residual standard error = " << residualStdError << " on " << (n - p - 1) << " degrees of freedom";
+    fitStep.expression = ossFit.str();
+    steps.push_back(fitStep);
+    
+    StatisticsStep finalStep;
+    finalStep.description = "=== Fitted Model ===";
+    std::ostringstream ossFinal;
+    ossFinal << std::fixed << std::setprecision(4);
+    ossFinal << "y = " << coefficients[0];
+    for (size_t j = 0; j < p; j++) {
+        ossFinal << (coefficients[j + 1] < 0 ? " - " : " + ") << std::abs(coefficients[j + 1]) << "·" << featureNames[j];
+    }
+    finalStep.expression = ossFinal.str();
+    steps.push_back(finalStep);
+}
+
+double MultipleRegression::predict(const std::vector<double>& x) const {
+    if (coefficients.empty() || x.size() + 1 != coefficients.size()) {
+        throw std::invalid_argument("Prediction needs one value per fitted feature");
+    }
+    double y = coefficients[0];
+    for (size_t j = 0; j < x.size(); j++) {
+        y += coefficients[j + 1] * x[j];
+    }
+    return y;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "double_span.h"
+#include "matrix_operations.h"
+#include "statistics.h"
+
+// Ordinary least squares y = b0 + b1·x1 + ... + bp·xp over column spans.
+//
+// X is never materialized: row blocks of the columns are centered and folded
+// into a mean-centered cross-product matrix [X y]ᵀ[X y], accumulated per
+// thread and merged with the pairwise co-moment update. The centered normal
+// equations Sxx·b = Sxy are then solved by Cholesky, which avoids the
+// cancellation of forming raw XᵀX with an intercept column.
+class MultipleRegression {
+private:
+    std::vector<StatisticsStep> steps;
+    std::vector<std::string> featureNames;
+    std::vector<double> coefficients;     // Intercept first
+    std::vector<double> standardErrors;
+    double rSquared = 0.0;
+    double adjustedRSquared = 0.0;
+    double residualStdError = 0.0;
+    size_t observations = 0;
+
+public:
+    // Throws std::invalid_argument on mismatched lengths or too few rows and
+    // std::runtime_error when the features are collinear
+    void fit(const std::vector<DoubleSpan>& features, DoubleSpan response,
+             const std::vector<std::string>& names = {});
+    
+    double predict(const std::vector<double>& x) const;
+    
+    const std::vector<double>& getCoefficients() const { return coefficients; }
+    const std::vector<double>& getStandardErrors() const { return standardErrors; }
+    double getRSquared() const { return rSquared; }
+    double getAdjustedRSquared() const { return adjustedRSquared; }
+    double getResidualStdError() const { return residualStdError; }
+    size_t getObservations() const { return observations; }
+    
+    const std::vector<StatisticsStep>& getSteps() const { return steps; }
+    void clearSteps() { steps.clear(); }
+};
@@ -1,4 +1,5 @@
 #include "multivariate_integrator.h"
+#include "job_system.h"
 #include <cmath>
 
 std::unique_ptr<ASTNode> MultivariateIntegrator::integrate(const ASTNode* root, IntegrationVariable var) {
@@ -360,6 +361,7 @@ double MultivariateIntegrator::doubleIntegrate(const ASTNode* root,
     
     double sum = 0.0;
     for (int i = 0; i < n_steps; i++) {
+        JobContext::reportProgress(i, n_steps);
         double x = x_lower + (i + 0.5) * dx;
         for (int j = 0; j < n_steps; j++) {
             double y = y_lower + (j + 0.5) * dy;
@@ -1,8 +1,10 @@
 #include "numerical_methods.h"
-#include "differentiator.h"
+#include "root_finder.h"
 #include <cmath>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <stdexcept>
 
 void NumericalMethods::newtonRaphson(const ASTNode* func, double x0, int maxIter, double tolerance) {
     steps.clear();
@@ -22,20 +24,18 @@ void NumericalMethods::newtonRaphson(const ASTNode* func, double x0, int maxIter
     step3.expression = "";
     steps.push_back(step3);
     
-    // Compute derivative
-    Differentiator diff;
-    auto fprime = diff.differentiate(func);
+    // f and f' from one compiled pass (forward-mode AD), no derivative tree
+    RootFinder finder(func);
     
     NumericalStep step4;
     step4.description = "Derivative:";
-    step4.expression = "f'(x) = " + fprime->toString();
+    step4.expression = "f'(x) by automatic differentiation alongside f(x)";
     steps.push_back(step4);
     
     double x = x0;
+    double fpx;
+    double fx = finder.value(x, fpx);
     for (int i = 0; i < maxIter; i++) {
-        double fx = func->evaluate(x);
-        double fpx = fprime->evaluate(x);
-        
         if (std::abs(fpx) < 1e-10) {
             NumericalStep errorStep;
             errorStep.description = "Error:";
@@ -45,12 +45,13 @@ void NumericalMethods::newtonRaphson(const ASTNode* func, double x0, int maxIter
         }
         
         double xnew = x - fx / fpx;
+        double fxnew = finder.value(xnew, fpx);
         
         NumericalStep stepI;
         stepI.description = "Iteration " + std::to_string(i+1) + ":";
         std::ostringstream oss;
         oss << std::fixed << std::setprecision(8);
-        oss << "x" << (i+1) << " = " << xnew << ", f(x" << (i+1) << ") = " << func->evaluate(xnew);
+        oss << "x" << (i+1) << " = " << xnew << ", f(x" << (i+1) << ") = " << fxnew;
         stepI.expression = oss.str();
         steps.push_back(stepI);
         
@@ -66,6 +67,7 @@ void NumericalMethods::newtonRaphson(const ASTNode* func, double x0, int maxIter
         }
         
         x = xnew;
+        fx = fxnew;
     }
 }
 
@@ -105,6 +107,7 @@ void NumericalMethods::bisectionMethod(const ASTNode* func, double a, double b,
     }
     
     double aOld = a, bOld = b;
+    double faOld = fa;
     for (int i = 0; i < maxIter; i++) {
         double c = (aOld + bOld) / 2.0;
         double fc = func->evaluate(c);
@@ -128,15 +131,96 @@ void NumericalMethods::bisectionMethod(const ASTNode* func, double a, double b,
             break;
         }
         
-        double faOld = func->evaluate(aOld);
         if (fc * faOld < 0) {
             bOld = c;
         } else {
             aOld = c;
+            faOld = fc;
         }
     }
 }
 
+void NumericalMethods::brentMethod(const ASTNode* func, double a, double b, int maxIter, double tolerance) {
+    steps.clear();
+    
+    NumericalStep step1;
+    step1.description = "=== Brent's Method ===";
+    step1.expression = "Finding root of f(x) = " + func->toString();
+    steps.push_back(step1);
+    
+    NumericalStep step2;
+    step2.description = "Initial interval:";
+    std::ostringstream oss2;
+    oss2 << std::fixed << std::setprecision(4);
+    oss2 << "[" << a << ", " << b << "]";
+    step2.expression = oss2.str();
+    steps.push_back(step2);
+    
+    NumericalStep step3;
+    step3.description = "Strategy:";
+    step3.expression = "Inverse quadratic interpolation or secant when it stays in the bracket, bisection otherwise";
+    steps.push_back(step3);
+    
+    RootFinder finder(func);
+    RootOptions options;
+    options.absoluteTolerance = tolerance;
+    options.maxIterations = maxIter;
+    RootResult result;
+    try {
+        result = finder.brent(a, b, options);
+    } catch (const std::invalid_argument& e) {
+        NumericalStep errorStep;
+        errorStep.description = "Error:";
+        errorStep.expression = "f(a) and f(b) must have opposite signs!";
+        steps.push_back(errorStep);
+        return;
+    }
+    
+    NumericalStep finalStep;
+    finalStep.description = result.converged ? "=== Converged ===" : "=== Not converged ===";
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(12);
+    oss << "Root: x = " << result.root << " (in " << result.iterations << " iterations, "
+        << finder.getEvaluations() << " evaluations), f(x) = " << std::scientific << std::setprecision(2) << result.value;
+    finalStep.expression = oss.str();
+    steps.push_back(finalStep);
+}
+
+void NumericalMethods::findAllRoots(const ASTNode* func, double a, double b, int samples) {
+    steps.clear();
+    
+    NumericalStep step1;
+    step1.description = "=== All Roots in an Interval ===";
+    std::ostringstream oss1;
+    oss1 << std::fixed << std::setprecision(4);
+    oss1 << "f(x) = " << func->toString() << " on [" << a << ", " << b << "]";
+    step1.expression = oss1.str();
+    steps.push_back(step1);
+    
+    NumericalStep step2;
+    step2.description = "Strategy:";
+    step2.expression = "Sample " + std::to_string(samples) + " subintervals; Brent on sign changes, Newton on dips of |f|";
+    steps.push_back(step2);
+    
+    RootFinder finder(func);
+    std::vector<double> roots = finder.findAll(a, b, static_cast<size_t>(std::max(samples, 2)));
+    
+    for (size_t i = 0; i < roots.size(); i++) {
+        NumericalStep stepI;
+        stepI.description = "Root " + std::to_string(i + 1) + ":";
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(12) << "x = " << roots[i];
+        stepI.expression = oss.str();
+        steps.push_back(stepI);
+    }
+    
+    NumericalStep finalStep;
+    finalStep.description = "=== Result ===";
+    finalStep.expression = std::to_string(roots.size()) + " root(s) found with " +
+                           std::to_string(finder.getEvaluations()) + " function evaluations";
+    steps.push_back(finalStep);
+}
+
 void NumericalMethods::trapezoidalRule(const ASTNode* func, double a, double b, int n) {
     steps.clear();
     
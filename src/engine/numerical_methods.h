@@ -11,12 +11,15 @@ struct NumericalStep {
 class NumericalMethods {
 private:
     std::vector<NumericalStep> steps;
-    
+
 public:
     // Root finding methods
     void newtonRaphson(const ASTNode* func, double x0, int maxIter, double tolerance);
     void bisectionMethod(const ASTNode* func, double a, double b, int maxIter, double tolerance);
     void secantMethod(const ASTNode* func, double x0, double x1, int maxIter, double tolerance);
+    void brentMethod(const ASTNode* func, double a, double b, int maxIter, double tolerance);
+    // Every root in [a, b] from a scan of 'samples' intervals (RootFinder::findAll)
+    void findAllRoots(const ASTNode* func, double a, double b, int samples);
     
     // Numerical integration
     void trapezoidalRule(const ASTNode* func, double a, double b, int n);
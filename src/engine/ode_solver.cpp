@@ -0,0 +1,389 @@
+#include "ode_solver.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+// Dormand–Prince 5(4) tableau
+static const double c2 = 1.0 / 5, c3 = 3.0 / 10, c4 = 4.0 / 5, c5 = 8.0 / 9;
+static const double a21 = 1.0 / 5;
+static const double a31 = 3.0 / 40, a32 = 9.0 / 40;
+static const double a41 = 44.0 / 45, a42 = -56.0 / 15, a43 = 32.0 / 9;
+static const double a51 = 19372.0 / 6561, a52 = -25360.0 / 2187, a53 = 64448.0 / 6561, a54 = -212.0 / 729;
+static const double a61 = 9017.0 / 3168, a62 = -355.0 / 33, a63 = 46732.0 / 5247, a64 = 49.0 / 176,
+                    a65 = -5103.0 / 18656;
+static const double a71 = 35.0 / 384, a73 = 500.0 / 1113, a74 = 125.0 / 192, a75 = -2187.0 / 6784,
+                    a76 = 11.0 / 84;
+// Error estimate: fifth- minus fourth-order weights
+static const double e1 = 71.0 / 57600, e3 = -71.0 / 16695, e4 = 71.0 / 1920, e5 = -17253.0 / 339200,
+                    e6 = 22.0 / 525, e7 = -1.0 / 40;
+// Fourth-order continuous extension (Hairer, Nørsett and Wanner)
+static const double d1 = -12715105075.0 / 11282082432, d3 = 87487479700.0 / 32700410799,
+                    d4 = -10690763975.0 / 1880347072, d5 = 701980252875.0 / 199316789632,
+                    d6 = -1453857185.0 / 822651844, d7 = 69997945.0 / 29380423;
+
+// Rosenbrock 2(3) of Shampine and Reichelt (MATLAB ode23s)
+static const double rosenbrockD = 1.0 / (2.0 + std::sqrt(2.0));
+static const double rosenbrockE32 = 6.0 + std::sqrt(2.0);
+
+// Step size controller
+static const double kSafety = 0.9;
+static const double kMinShrink = 0.2;
+static const double kMaxGrowth = 5.0;
+
+const char* odeMethodName(OdeMethod method) {
+    return method == OdeMethod::Rosenbrock23 ? "Rosenbrock 2(3)" : "Dormand–Prince 5(4)";
+}
+
+OdeIntegrator::OdeIntegrator(OdeSystem system, OdeOptions options)
+    : system(std::move(system)), options(options), n(this->system.dimension) {
+    if (n == 0 || !this->system.rhs) {
+        throw std::invalid_argument("An ODE system needs a right-hand side and at least one component");
+    }
+    for (std::vector<double>* v : {&k1, &k2, &k3, &k4, &k5, &k6, &k7, &y, &yStage, &yNew, &scratch,
+                                   &dense0, &dense1, &dense2, &dense3, &dense4, &timeDerivative}) {
+        v->assign(n, 0.0);
+    }
+    if (options.method == OdeMethod::Rosenbrock23) {
+        jacobian.assign(n * n, 0.0);
+        w.assign(n * n, 0.0);
+        pivots.assign(n, 0);
+    }
+}
+
+void OdeIntegrator::evaluate(double t, const double* state, double* dydt) {
+    system.rhs(t, state, dydt);
+    stats.rhsEvaluations++;
+}
+
+// RMS of the error scaled by atol + rtol·max(|y|, |yNew|)
+double OdeIntegrator::errorNorm(const std::vector<double>& error) const {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double scale = options.absoluteTolerance +
+                       options.relativeTolerance * std::max(std::abs(y[i]), std::abs(yNew[i]));
+        double ratio = error[i] / scale;
+        sum += ratio * ratio;
+    }
+    return std::sqrt(sum / n);
+}
+
+// Starting step from the size of y, y' and an estimate of y'' (Hairer's HINIT);
+// expects k1 = F(t0, y)
+double OdeIntegrator::initialStep(double t0, double direction, double tEnd, int order) {
+    double span = std::abs(tEnd - t0);
+    double d0 = 0.0, d1 = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double scale = options.absoluteTolerance + options.relativeTolerance * std::abs(y[i]);
+        d0 += (y[i] / scale) * (y[i] / scale);
+        d1 += (k1[i] / scale) * (k1[i] / scale);
+    }
+    d0 = std::sqrt(d0 / n);
+    d1 = std::sqrt(d1 / n);
+    double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+    h0 = std::min(h0, span);
+    
+    for (size_t i = 0; i < n; i++) {
+        yStage[i] = y[i] + direction * h0 * k1[i];
+    }
+    evaluate(t0 + direction * h0, yStage.data(), scratch.data());
+    double d2 = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double scale = options.absoluteTolerance + options.relativeTolerance * std::abs(y[i]);
+        double difference = (scratch[i] - k1[i]) / scale;
+        d2 += difference * difference;
+    }
+    d2 = std::sqrt(d2 / n) / h0;
+    
+    double largest = std::max(d1, d2);
+    double h1 = largest <= 1e-15 ? std::max(1e-6, h0 * 1e-3)
+                                 : std::pow(0.01 / largest, 1.0 / (order + 1));
+    return std::min({100.0 * h0, h1, span});
+}
+
+// One Dormand–Prince step of size h from (t, y) with k1 = F(t, y). On
+// acceptance yNew and k7 = F(t + h, yNew) are set and the dense output
+// coefficients prepared.
+bool OdeIntegrator::stepDormandPrince(double t, double h, double& errorRatio) {
+    for (size_t i = 0; i < n; i++) yStage[i] = y[i] + h * a21 * k1[i];
+    evaluate(t + c2 * h, yStage.data(), k2.data());
+    for (size_t i = 0; i < n; i++) yStage[i] = y[i] + h * (a31 * k1[i] + a32 * k2[i]);
+    evaluate(t + c3 * h, yStage.data(), k3.data());
+    for (size_t i = 0; i < n; i++) yStage[i] = y[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
+    evaluate(t + c4 * h, yStage.data(), k4.data());
+    for (size_t i = 0; i < n; i++) {
+        yStage[i] = y[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] + a54 * k4[i]);
+    }
+    evaluate(t + c5 * h, yStage.data(), k5.data());
+    for (size_t i = 0; i < n; i++) {
+        yStage[i] = y[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] + a64 * k4[i] + a65 * k5[i]);
+    }
+    evaluate(t + h, yStage.data(), k6.data());
+    for (size_t i = 0; i < n; i++) {
+        yNew[i] = y[i] + h * (a71 * k1[i] + a73 * k3[i] + a74 * k4[i] + a75 * k5[i] + a76 * k6[i]);
+    }
+    evaluate(t + h, yNew.data(), k7.data());
+    
+    for (size_t i = 0; i < n; i++) {
+        scratch[i] = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+    }
+    errorRatio = errorNorm(scratch);
+    if (!(errorRatio <= 1.0)) {
+        return false;
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        double delta = yNew[i] - y[i];
+        double slope0 = h * k1[i] - delta;
+        dense0[i] = y[i];
+        dense1[i] = delta;
+        dense2[i] = slope0;
+        dense3[i] = delta - h * k7[i] - slope0;
+        dense4[i] = h * (d1 * k1[i] + d3 * k3[i] + d4 * k4[i] + d5 * k5[i] + d6 * k6[i] + d7 * k7[i]);
+    }
+    return true;
+}
+
+// In-place LU with partial pivoting of the n×n row-major w; false if singular
+static bool factorInPlace(std::vector<double>& w, std::vector<size_t>& pivots, size_t n) {
+    for (size_t k = 0; k < n; k++) {
+        size_t pivot = k;
+        for (size_t i = k + 1; i < n; i++) {
+            if (std::abs(w[i * n + k]) > std::abs(w[pivot * n + k])) pivot = i;
+        }
+        pivots[k] = pivot;
+        if (w[pivot * n + k] == 0.0) return false;
+        if (pivot != k) {
+            std::swap_ranges(w.begin() + k * n, w.begin() + (k + 1) * n, w.begin() + pivot * n);
+        }
+        double inverse = 1.0 / w[k * n + k];
+        for (size_t i = k + 1; i < n; i++) {
+            double multiplier = w[i * n + k] * inverse;
+            w[i * n + k] = multiplier;
+            if (multiplier == 0.0) continue;
+            for (size_t j = k + 1; j < n; j++) {
+                w[i * n + j] -= multiplier * w[k * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+static void solveInPlace(const std::vector<double>& w, const std::vector<size_t>& pivots, size_t n, double* b) {
+    for (size_t k = 0; k < n; k++) {
+        std::swap(b[k], b[pivots[k]]);
+    }
+    for (size_t i = 0; i < n; i++) {
+        double sum = b[i];
+        for (size_t k = 0; k < i; k++) sum -= w[i * n + k] * b[k];
+        b[i] = sum;
+    }
+    for (size_t i = n; i-- > 0;) {
+        double sum = b[i];
+        for (size_t k = i + 1; k < n; k++) sum -= w[i * n + k] * b[k];
+        b[i] = sum / w[i * n + i];
+    }
+}
+
+// One Rosenbrock 2(3) step with k4 = F(t, y) (the FSAL slot). W = I - h·d·J
+// is factored once and reused for all three stages. On acceptance
+// k7 = F(t + h, yNew) and the dense output is prepared.
+bool OdeIntegrator::stepRosenbrock(double t, double h, double& errorRatio) {
+    const double hd = h * rosenbrockD;
+    const double* f0 = k4.data();
+    
+    for (size_t i = 0; i < n * n; i++) w[i] = -hd * jacobian[i];
+    for (size_t i = 0; i < n; i++) w[i * n + i] += 1.0;
+    stats.factorizations++;
+    if (!factorInPlace(w, pivots, n)) {
+        errorRatio = INFINITY;
+        return false;
+    }
+    
+    for (size_t i = 0; i < n; i++) k1[i] = f0[i] + hd * timeDerivative[i];
+    solveInPlace(w, pivots, n, k1.data());
+    
+    for (size_t i = 0; i < n; i++) yStage[i] = y[i] + 0.5 * h * k1[i];
+    evaluate(t + 0.5 * h, yStage.data(), k5.data());               // F1
+    for (size_t i = 0; i < n; i++) k2[i] = k5[i] - k1[i];
+    solveInPlace(w, pivots, n, k2.data());
+    for (size_t i = 0; i < n; i++) {
+        k2[i] += k1[i];
+        yNew[i] = y[i] + h * k2[i];
+    }
+    
+    evaluate(t + h, yNew.data(), k7.data());                       // F2
+    for (size_t i = 0; i < n; i++) {
+        k3[i] = k7[i] - rosenbrockE32 * (k2[i] - k5[i]) - 2.0 * (k1[i] - f0[i]) + hd * timeDerivative[i];
+    }
+    solveInPlace(w, pivots, n, k3.data());
+    
+    for (size_t i = 0; i < n; i++) {
+        scratch[i] = h / 6.0 * (k1[i] - 2.0 * k2[i] + k3[i]);
+    }
+    errorRatio = errorNorm(scratch);
+    if (!(errorRatio <= 1.0)) {
+        return false;
+    }
+    
+    // y(t + s·h) = y + h·(s(1-s)/(1-2d)·k1 + s(s-2d)/(1-2d)·k2)
+    for (size_t i = 0; i < n; i++) {
+        dense0[i] = y[i];
+        dense1[i] = h * k1[i];
+        dense2[i] = h * k2[i];
+    }
+    return true;
+}
+
+// Solution at 'at' within the last accepted step [t, t + h]
+void OdeIntegrator::interpolate(double t, double h, double at, double* out) const {
+    double s = (at - t) / h;
+    if (options.method == OdeMethod::Rosenbrock23) {
+        double denominator = 1.0 - 2.0 * rosenbrockD;
+        double w1 = s * (1.0 - s) / denominator;
+        double w2 = s * (s - 2.0 * rosenbrockD) / denominator;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = dense0[i] + w1 * dense1[i] + w2 * dense2[i];
+        }
+    } else {
+        double s1 = 1.0 - s;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = dense0[i] + s * (dense1[i] + s1 * (dense2[i] + s * (dense3[i] + s1 * dense4[i])));
+        }
+    }
+}
+
+const OdeStats& OdeIntegrator::solve(double t0, const double* y0, const double* outputTimes,
+                                     size_t outputCount, double* out) {
+    stats = OdeStats();
+    if (outputCount == 0) return stats;
+    
+    const double tEnd = outputTimes[outputCount - 1];
+    const double direction = tEnd >= t0 ? 1.0 : -1.0;
+    double previous = t0;
+    for (size_t j = 0; j < outputCount; j++) {
+        if (!std::isfinite(outputTimes[j]) || direction * (outputTimes[j] - previous) < 0.0) {
+            throw std::invalid_argument("Output times must be finite and run monotonically away from t0");
+        }
+        previous = outputTimes[j];
+    }
+    
+    std::copy(y0, y0 + n, y.begin());
+    size_t nextOutput = 0;
+    while (nextOutput < outputCount && outputTimes[nextOutput] == t0) {
+        std::copy(y.begin(), y.end(), out + nextOutput * n);
+        nextOutput++;
+    }
+    if (nextOutput == outputCount) return stats;
+    
+    const bool stiff = options.method == OdeMethod::Rosenbrock23;
+    const int order = stiff ? 2 : 4;
+    // The FSAL slot holds F(t, y) at the start of every step
+    std::vector<double>& fsal = stiff ? k4 : k1;
+    double t = t0;
+    evaluate(t, y.data(), k1.data());
+    double h = options.initialStep > 0.0 ? options.initialStep : initialStep(t, direction, tEnd, order);
+    if (stiff) {
+        std::copy(k1.begin(), k1.end(), k4.begin());
+    }
+    double maxStep = options.maxStep > 0.0 ? options.maxStep : std::abs(tEnd - t0);
+    h = std::min(h, maxStep);
+    bool rejectedLast = false;
+    
+    while (nextOutput < outputCount) {
+        if ((stats.acceptedSteps + stats.rejectedSteps) % 256 == 255) {
+            JobContext::checkpoint();
+        }
+        if (stats.acceptedSteps + stats.rejectedSteps >= options.maxSteps) {
+            std::ostringstream oss;
+            oss << "ODE step limit (" << options.maxSteps << ") reached at t = " << t
+                << "; the problem may be stiff or the tolerance too tight";
+            throw std::runtime_error(oss.str());
+        }
+        if (h < 16.0 * DBL_EPSILON * std::max(1.0, std::abs(t))) {
+            std::ostringstream oss;
+            oss << "ODE step size underflow at t = " << t << " (singularity or non-finite solution)";
+            throw std::runtime_error(oss.str());
+        }
+        
+        // Land exactly on the final time instead of stepping past it
+        double remaining = std::abs(tEnd - t);
+        if (h >= remaining * (1.0 - 1e-12)) h = remaining;
+        const double signedH = direction * h;
+        
+        if (stiff) {
+            // Jacobian and ∂F/∂t at the step start, by forward differences when not supplied
+            if (system.jacobian) {
+                system.jacobian(t, y.data(), jacobian.data());
+            } else {
+                for (size_t j = 0; j < n; j++) {
+                    double saved = y[j];
+                    double delta = std::sqrt(DBL_EPSILON) * std::max(std::abs(saved), 1e-5);
+                    y[j] = saved + delta;
+                    evaluate(t, y.data(), scratch.data());
+                    y[j] = saved;
+                    for (size_t i = 0; i < n; i++) {
+                        jacobian[i * n + j] = (scratch[i] - fsal[i]) / delta;
+                    }
+                }
+            }
+            stats.jacobianEvaluations++;
+            double delta = std::sqrt(DBL_EPSILON) * std::max(std::abs(t), 1e-5) * direction;
+            evaluate(t + delta, y.data(), scratch.data());
+            for (size_t i = 0; i < n; i++) {
+                timeDerivative[i] = (scratch[i] - fsal[i]) / delta;
+            }
+        }
+        
+        double errorRatio = 0.0;
+        bool accepted = stiff ? stepRosenbrock(t, signedH, errorRatio) : stepDormandPrince(t, signedH, errorRatio);
+        
+        if (!accepted) {
+            stats.rejectedSteps++;
+            double shrink = std::isfinite(errorRatio)
+                ? std::max(kMinShrink, kSafety * std::pow(errorRatio, -1.0 / (order + 1)))
+                : kMinShrink;
+            h *= std::min(shrink, 0.9);
+            rejectedLast = true;
+            continue;
+        }
+        
+        stats.acceptedSteps++;
+        double tNew = (h == remaining) ? tEnd : t + signedH;
+        while (nextOutput < outputCount && direction * (outputTimes[nextOutput] - tNew) <= 0.0) {
+            double* target = out + nextOutput * n;
+            if (outputTimes[nextOutput] == tNew) {
+                std::copy(yNew.begin(), yNew.end(), target);
+            } else {
+                interpolate(t, signedH, outputTimes[nextOutput], target);
+            }
+            nextOutput++;
+        }
+        
+        t = tNew;
+        y.swap(yNew);
+        std::copy(k7.begin(), k7.end(), fsal.begin());
+        
+        double growth = errorRatio > 0.0 ? kSafety * std::pow(errorRatio, -1.0 / (order + 1)) : kMaxGrowth;
+        growth = std::min(kMaxGrowth, std::max(kMinShrink, growth));
+        if (rejectedLast) growth = std::min(growth, 1.0);
+        h = std::min(h * growth, maxStep);
+        rejectedLast = false;
+    }
+    return stats;
+}
+
+const OdeStats& OdeIntegrator::solve(double t0, const std::vector<double>& y0, double tEnd, size_t count,
+                                     std::vector<double>& times, std::vector<double>& out) {
+    if (y0.size() != n) {
+        throw std::invalid_argument("Initial state must have one value per component");
+    }
+    times.resize(count);
+    for (size_t j = 0; j < count; j++) {
+        times[j] = count == 1 ? tEnd : t0 + (tEnd - t0) * static_cast<double>(j) / (count - 1);
+    }
+    out.resize(count * n);
+    return solve(t0, y0.data(), times.data(), count, out.data());
+}
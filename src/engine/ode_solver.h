@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+enum class OdeMethod {
+    DormandPrince45,    // Explicit adaptive RK 5(4); non-stiff problems
+    Rosenbrock23        // Linearly implicit, L-stable 2(3); stiff problems
+};
+
+// First-order system y' = F(t, y) with y of 'dimension' components. A scalar
+// equation dy/dx = f(x, y) is dimension 1.
+struct OdeSystem {
+    size_t dimension = 1;
+    std::function<void(double t, const double* y, double* dydt)> rhs;
+    
+    // Optional ∂F_i/∂y_j, row-major dimension × dimension. When empty the
+    // stiff solver uses forward differences (dimension extra rhs calls).
+    std::function<void(double t, const double* y, double* jacobian)> jacobian;
+};
+
+struct OdeOptions {
+    OdeMethod method = OdeMethod::DormandPrince45;
+    double relativeTolerance = 1e-6;
+    double absoluteTolerance = 1e-9;
+    double initialStep = 0.0;       // 0 = chosen from the problem
+    double maxStep = 0.0;           // 0 = unbounded
+    size_t maxSteps = 100000;
+};
+
+struct OdeStats {
+    size_t acceptedSteps = 0;
+    size_t rejectedSteps = 0;
+    size_t rhsEvaluations = 0;
+    size_t jacobianEvaluations = 0;
+    size_t factorizations = 0;
+};
+
+// Adaptive initial value problem integrator. All stage, interpolation and
+// Jacobian storage is allocated once in the constructor, so one integrator
+// can run many solves (e.g. a parameter sweep) without allocating. Output
+// points are produced by each method's dense output, so they do not shorten
+// the steps.
+class OdeIntegrator {
+private:
+    OdeSystem system;
+    OdeOptions options;
+    size_t n;
+    OdeStats stats;
+    
+    // Stage vectors (Dormand–Prince uses all seven; Rosenbrock k1..k3 and f0..f2)
+    std::vector<double> k1, k2, k3, k4, k5, k6, k7;
+    std::vector<double> y, yStage, yNew, scratch;
+    // Dense output of the last accepted step
+    std::vector<double> dense0, dense1, dense2, dense3, dense4;
+    // Rosenbrock: W = I - h·d·J, its LU factors and pivots, and ∂F/∂t
+    std::vector<double> jacobian, w, timeDerivative;
+    std::vector<size_t> pivots;
+    
+    void evaluate(double t, const double* state, double* dydt);
+    double errorNorm(const std::vector<double>& error) const;
+    double initialStep(double t0, double direction, double tEnd, int order);
+    
+    bool stepDormandPrince(double t, double h, double& errorRatio);
+    bool stepRosenbrock(double t, double h, double& errorRatio);
+    void interpolate(double t, double h, double at, double* out) const;
+
+public:
+    // Throws std::invalid_argument for a zero dimension or missing rhs
+    OdeIntegrator(OdeSystem system, OdeOptions options = {});
+    
+    // Integrates from (t0, y0) and writes the solution at each of the
+    // outputCount times into out (outputCount × dimension, row-major). The
+    // times must run monotonically away from t0, in either direction. Throws
+    // std::invalid_argument for bad times and std::runtime_error if the step
+    // size underflows, the step limit is hit or the solution stops being finite.
+    const OdeStats& solve(double t0, const double* y0, const double* outputTimes,
+                          size_t outputCount, double* out);
+    
+    // Convenience form: 'count' equally spaced times from t0 to tEnd inclusive
+    const OdeStats& solve(double t0, const std::vector<double>& y0, double tEnd, size_t count,
+                          std::vector<double>& times, std::vector<double>& out);
+    
+    const OdeStats& getStats() const { return stats; }
+    size_t dimension() const { return n; }
+};
+
+const char* odeMethodName(OdeMethod method);
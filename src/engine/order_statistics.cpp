@@ -0,0 +1,213 @@
+#include "order_statistics.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace order_statistics {
+
+// Below this size a private copy plus in-place selection is cheaper than
+// sampling and bracketing
+static const size_t kParallelThreshold = size_t(1) << 20;
+
+void selectInPlace(std::vector<double>& data, std::vector<size_t> ranks) {
+    const size_t n = data.size();
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    while (!ranks.empty() && ranks.back() >= n) {
+        ranks.pop_back();
+    }
+    
+    // Each frame is a sub-range of data plus the ranks that fall inside it
+    struct Frame {
+        size_t lo, hi;
+        size_t firstRank, lastRank;
+    };
+    std::vector<Frame> frames;
+    if (!ranks.empty()) {
+        frames.push_back({0, n, 0, ranks.size()});
+    }
+    
+    while (!frames.empty()) {
+        Frame frame = frames.back();
+        frames.pop_back();
+        
+        size_t middle = frame.firstRank + (frame.lastRank - frame.firstRank) / 2;
+        size_t k = ranks[middle];
+        std::nth_element(data.begin() + frame.lo, data.begin() + k, data.begin() + frame.hi);
+        
+        // Everything left of k is <= data[k], everything right is >= data[k]
+        if (frame.firstRank < middle) {
+            frames.push_back({frame.lo, k, frame.firstRank, middle});
+        }
+        if (middle + 1 < frame.lastRank) {
+            frames.push_back({k + 1, frame.hi, middle + 1, frame.lastRank});
+        }
+    }
+}
+
+// Ranks past the end are clamped to n - 1 before selecting, so they read
+// the selected maximum rather than an unpartitioned element
+static std::vector<double> selectFromCopy(const double* data, size_t n, const std::vector<size_t>& ranks) {
+    std::vector<size_t> clamped(ranks);
+    for (size_t& rank : clamped) {
+        rank = std::min(rank, n - 1);
+    }
+    std::vector<double> copy(data, data + n);
+    selectInPlace(copy, clamped);
+    
+    std::vector<double> result;
+    result.reserve(clamped.size());
+    for (size_t rank : clamped) {
+        result.push_back(copy[rank]);
+    }
+    return result;
+}
+
+std::vector<double> selectRanks(const double* data, size_t n, const std::vector<size_t>& ranks) {
+    if (n == 0) {
+        return std::vector<double>(ranks.size(), std::numeric_limits<double>::quiet_NaN());
+    }
+    if (n < kParallelThreshold || ranks.empty()) {
+        return selectFromCopy(data, n, ranks);
+    }
+    
+    // Floyd–Rivest style bracketing: a sorted sample of ~n^(2/3) values
+    // gives, for each rank, a value interval that contains it with high
+    // probability (±4 standard deviations of the sample rank).
+    size_t sampleSize = std::min(n / 4, static_cast<size_t>(std::pow(static_cast<double>(n), 2.0 / 3.0)));
+    size_t margin = static_cast<size_t>(2 * std::sqrt(static_cast<double>(sampleSize))) + 1;
+    
+    std::vector<double> sample(sampleSize);
+    std::mt19937_64 rng(0x9e3779b97f4a7c15ULL);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    for (double& value : sample) {
+        value = data[pick(rng)];
+    }
+    std::sort(sample.begin(), sample.end());
+    
+    std::vector<size_t> sortedRanks(ranks);
+    for (size_t& rank : sortedRanks) {
+        rank = std::min(rank, n - 1);
+    }
+    std::sort(sortedRanks.begin(), sortedRanks.end());
+    sortedRanks.erase(std::unique(sortedRanks.begin(), sortedRanks.end()), sortedRanks.end());
+    
+    // Overlapping brackets are merged so each element lands in at most one
+    const double lowest = -std::numeric_limits<double>::infinity();
+    const double highest = std::numeric_limits<double>::infinity();
+    std::vector<double> bracketLo, bracketHi;
+    std::vector<size_t> bracketOfRank(sortedRanks.size());
+    
+    for (size_t i = 0; i < sortedRanks.size(); i++) {
+        size_t position = static_cast<size_t>(static_cast<double>(sortedRanks[i]) / n * sampleSize);
+        double lo = position >= margin ? sample[position - margin] : lowest;
+        double hi = position + margin < sampleSize ? sample[position + margin] : highest;
+        
+        if (!bracketHi.empty() && lo <= bracketHi.back()) {
+            bracketHi.back() = std::max(bracketHi.back(), hi);
+        } else {
+            bracketLo.push_back(lo);
+            bracketHi.push_back(hi);
+        }
+        bracketOfRank[i] = bracketLo.size() - 1;
+    }
+    
+    // One parallel pass: count the elements in each gap between brackets and
+    // gather the elements inside each bracket
+    const size_t bracketCount = bracketLo.size();
+    struct ChunkResult {
+        std::vector<size_t> gapCounts;
+        std::vector<std::vector<double>> inside;
+    };
+    size_t chunks = parallelChunkCount(n, size_t(1) << 18);
+    std::vector<ChunkResult> partials(chunks);
+    
+    parallelChunks(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        ChunkResult& local = partials[chunk];
+        local.gapCounts.assign(bracketCount + 1, 0);
+        local.inside.resize(bracketCount);
+        
+        for (size_t i = begin; i < end; i++) {
+            double x = data[i];
+            size_t j = std::lower_bound(bracketHi.begin(), bracketHi.end(), x) - bracketHi.begin();
+            if (j < bracketCount && x >= bracketLo[j]) {
+                local.inside[j].push_back(x);
+            } else {
+                local.gapCounts[j]++;
+            }
+        }
+    });
+    
+    std::vector<double> values(sortedRanks.size());
+    size_t below = 0;
+    size_t nextRank = 0;
+    
+    for (size_t j = 0; j < bracketCount; j++) {
+        std::vector<double> candidates;
+        for (ChunkResult& local : partials) {
+            below += local.gapCounts[j];
+            candidates.insert(candidates.end(), local.inside[j].begin(), local.inside[j].end());
+            std::vector<double>().swap(local.inside[j]);
+        }
+        
+        std::vector<size_t> localRanks;
+        size_t firstRank = nextRank;
+        for (; nextRank < sortedRanks.size() && bracketOfRank[nextRank] == j; nextRank++) {
+            if (sortedRanks[nextRank] < below || sortedRanks[nextRank] - below >= candidates.size()) {
+                // The sample missed this rank (vanishingly rare); fall back to a full selection
+                return selectFromCopy(data, n, ranks);
+            }
+            localRanks.push_back(sortedRanks[nextRank] - below);
+        }
+        
+        selectInPlace(candidates, localRanks);
+        for (size_t r = firstRank; r < nextRank; r++) {
+            values[r] = candidates[sortedRanks[r] - below];
+        }
+        below += candidates.size();
+    }
+    
+    // Back to the caller's order (ranks may be unsorted or repeated)
+    std::vector<double> result;
+    result.reserve(ranks.size());
+    for (size_t rank : ranks) {
+        size_t index = std::lower_bound(sortedRanks.begin(), sortedRanks.end(), std::min(rank, n - 1)) - sortedRanks.begin();
+        result.push_back(values[index]);
+    }
+    return result;
+}
+
+std::vector<double> quantiles(const double* data, size_t n, const std::vector<double>& probabilities) {
+    if (n == 0) {
+        return std::vector<double>(probabilities.size(), std::numeric_limits<double>::quiet_NaN());
+    }
+    
+    // Each quantile needs the two order statistics around q·(n-1)
+    std::vector<size_t> ranks;
+    std::vector<double> fractions;
+    for (double q : probabilities) {
+        double h = std::max(0.0, std::min(1.0, q)) * (n - 1);
+        size_t k = static_cast<size_t>(std::floor(h));
+        ranks.push_back(k);
+        ranks.push_back(std::min(k + 1, n - 1));
+        fractions.push_back(h - k);
+    }
+    
+    std::vector<double> selected = selectRanks(data, n, ranks);
+    std::vector<double> result;
+    result.reserve(probabilities.size());
+    for (size_t i = 0; i < probabilities.size(); i++) {
+        double lower = selected[2 * i];
+        double upper = selected[2 * i + 1];
+        result.push_back(lower + fractions[i] * (upper - lower));
+    }
+    return result;
+}
+
+double median(const double* data, size_t n) {
+    return quantiles(data, n, {0.5})[0];
+}
+
+} // namespace order_statistics
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Exact order statistics by selection (std::nth_element is introselect:
+// expected O(n), O(n log n) worst case) instead of sorting.
+namespace order_statistics {
+
+// Places the values of rank ranks[i] (0-based) at data[ranks[i]], in place.
+// Several ranks share one partitioning: each selection splits the range and
+// the remaining ranks only recurse into their own side, O(n log m) overall.
+void selectInPlace(std::vector<double>& data, std::vector<size_t> ranks);
+
+// Values of the given ranks without modifying or copying the input. Large
+// inputs are bracketed with a sample, counted and gathered in parallel, and
+// only the few elements inside each bracket are selected from.
+std::vector<double> selectRanks(const double* data, size_t n, const std::vector<size_t>& ranks);
+
+// Quantiles with linear interpolation between order statistics (rank
+// q·(n-1), the R/NumPy default). probabilities are clamped to [0, 1].
+std::vector<double> quantiles(const double* data, size_t n, const std::vector<double>& probabilities);
+double median(const double* data, size_t n);
+
+} // namespace order_statistics
@@ -0,0 +1,102 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Number of contiguous chunks [0, count) is split into: one per hardware
+// thread, but never chunks smaller than minChunk (small inputs stay serial).
+inline size_t parallelChunkCount(size_t count, size_t minChunk) {
+    size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    size_t byGrain = std::max<size_t>(1, count / std::max<size_t>(1, minChunk));
+    return std::max<size_t>(1, std::min(hw, byGrain));
+}
+
+// Calls fn(chunkIndex, begin, end) for each chunk, running chunks 1..n-1 on
+// worker threads and chunk 0 on the calling thread. Chunk boundaries depend
+// only on count and chunks, so per-chunk results combined in index order are
+// reproducible. An exception thrown by any chunk (e.g. JobCancelled) is
+// rethrown on the calling thread once every worker has finished.
+template <typename Fn>
+void parallelChunks(size_t count, size_t chunks, Fn fn) {
+    if (chunks <= 1 || count == 0) {
+        fn(size_t(0), size_t(0), count);
+        return;
+    }
+    
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(chunks);
+    workers.reserve(chunks - 1);
+    
+    for (size_t c = 1; c < chunks; c++) {
+        size_t begin = std::min(count, c * chunkSize);
+        size_t end = std::min(count, begin + chunkSize);
+        workers.emplace_back([&fn, &errors, c, begin, end]() {
+            try {
+                fn(c, begin, end);
+            } catch (...) {
+                errors[c] = std::current_exception();
+            }
+        });
+    }
+    try {
+        fn(size_t(0), size_t(0), std::min(count, chunkSize));
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+// Calls fn(worker, index) for every index in [0, count) on up to 'workers'
+// threads (worker 0 is the calling thread). Indices are claimed 'grain' at a
+// time from a shared counter, so when items differ widely in cost a thread
+// that finishes early keeps taking work instead of idling behind a slow
+// fixed chunk. Which worker handles an index is not deterministic; results
+// should be written per index. After an exception no further batches are
+// claimed, and the first error (by worker) is rethrown once all have stopped.
+template <typename Fn>
+void parallelDynamic(size_t count, size_t workers, size_t grain, Fn fn) {
+    grain = std::max<size_t>(1, grain);
+    workers = std::max<size_t>(1, std::min(workers, (count + grain - 1) / grain));
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::vector<std::exception_ptr> errors(workers);
+    
+    auto run = [&](size_t worker) {
+        try {
+            while (!failed.load(std::memory_order_relaxed)) {
+                size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= count) break;
+                size_t end = std::min(count, begin + grain);
+                for (size_t i = begin; i < end; i++) {
+                    fn(worker, i);
+                }
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            failed = true;
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t w = 1; w < workers; w++) {
+        threads.emplace_back(run, w);
+    }
+    run(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
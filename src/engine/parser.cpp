@@ -1,8 +1,85 @@
 #include "parser.h"
 
+const ASTNode* ParseCache::find(const std::string& source) {
+    auto it = entries.find(source);
+    if (it == entries.end()) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    it->second.lastUsed = generation;
+    return it->second.node.get();
+}
+
+void ParseCache::store(const std::string& source, const ASTNode* node) {
+    entries[source] = {node->clone(), generation};
+}
+
+void ParseCache::beginParse() {
+    generation++;
+}
+
+void ParseCache::evictUnused() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.lastUsed != generation) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::unique_ptr<ASTNode> Parser::parse(const std::string& expr, ParseCache& subtreeCache) {
+    subtreeCache.beginParse();
+    cache = &subtreeCache;
+    try {
+        auto result = parse(expr);
+        cache = nullptr;
+        subtreeCache.evictUnused();
+        return result;
+    } catch (...) {
+        cache = nullptr;
+        throw;
+    }
+}
+
+void Parser::matchParentheses() {
+    matchingParen.assign(input.length(), std::string::npos);
+    std::vector<size_t> open;
+    for (size_t i = 0; i < input.length(); i++) {
+        if (input[i] == '(') {
+            open.push_back(i);
+        } else if (input[i] == ')' && !open.empty()) {
+            matchingParen[open.back()] = i;
+            open.pop_back();
+        }
+    }
+}
+
+std::unique_ptr<ASTNode> Parser::reuseGroup(size_t start, size_t open) {
+    size_t close = matchingParen[open];
+    if (close == std::string::npos) {
+        return nullptr;
+    }
+    const ASTNode* cached = cache->find(input.substr(start, close - start + 1));
+    if (!cached) {
+        return nullptr;
+    }
+    pos = close + 1;
+    return cached->clone();
+}
+
+void Parser::storeGroup(size_t start, const ASTNode* node) {
+    // pos is just past the closing parenthesis of the group
+    cache->store(input.substr(start, pos - start), node);
+}
+
 std::unique_ptr<ASTNode> Parser::parse(const std::string& expr) {
     input = expr;
     pos = 0;
+    if (cache) {
+        matchParentheses();
+    }
     skipWhitespace();
     auto result = parseExpression();
     skipWhitespace();
@@ -106,6 +183,13 @@ std::unique_ptr<ASTNode> Parser::parsePrimary() {
     
     // Parentheses
     if (c == '(') {
+        size_t start = pos;
+        if (cache) {
+            if (auto reused = reuseGroup(start, start)) {
+                return reused;
+            }
+        }
+        
         consume();
         auto expr = parseExpression();
         skipWhitespace();
@@ -113,11 +197,16 @@ std::unique_ptr<ASTNode> Parser::parsePrimary() {
             throw std::runtime_error("Expected closing parenthesis");
         }
         consume();
+        
+        if (cache) {
+            storeGroup(start, expr.get());
+        }
         return expr;
     }
     
     // Function or variable
     if (std::isalpha(c)) {
+        size_t start = pos;
         std::string name;
         while (std::isalpha(peek())) {
             name += consume();
@@ -125,6 +214,12 @@ std::unique_ptr<ASTNode> Parser::parsePrimary() {
         
         skipWhitespace();
         if (peek() == '(') {
+            if (cache) {
+                if (auto reused = reuseGroup(start, pos)) {
+                    return reused;
+                }
+            }
+            
             consume();
             auto arg = parseExpression();
             skipWhitespace();
@@ -134,14 +229,19 @@ std::unique_ptr<ASTNode> Parser::parsePrimary() {
             consume();
             
             // Match function name
-            if (name == "sin") return std::make_unique<UnaryFuncNode>(UnaryFunc::SIN, std::move(arg));
-            if (name == "cos") return std::make_unique<UnaryFuncNode>(UnaryFunc::COS, std::move(arg));
-            if (name == "tan") return std::make_unique<UnaryFuncNode>(UnaryFunc::TAN, std::move(arg));
-            if (name == "exp") return std::make_unique<UnaryFuncNode>(UnaryFunc::EXP, std::move(arg));
-            if (name == "ln") return std::make_unique<UnaryFuncNode>(UnaryFunc::LN, std::move(arg));
-            if (name == "sqrt") return std::make_unique<UnaryFuncNode>(UnaryFunc::SQRT, std::move(arg));
+            std::unique_ptr<ASTNode> call;
+            if (name == "sin") call = std::make_unique<UnaryFuncNode>(UnaryFunc::SIN, std::move(arg));
+            else if (name == "cos") call = std::make_unique<UnaryFuncNode>(UnaryFunc::COS, std::move(arg));
+            else if (name == "tan") call = std::make_unique<UnaryFuncNode>(UnaryFunc::TAN, std::move(arg));
+            else if (name == "exp") call = std::make_unique<UnaryFuncNode>(UnaryFunc::EXP, std::move(arg));
+            else if (name == "ln") call = std::make_unique<UnaryFuncNode>(UnaryFunc::LN, std::move(arg));
+            else if (name == "sqrt") call = std::make_unique<UnaryFuncNode>(UnaryFunc::SQRT, std::move(arg));
+            else throw std::runtime_error("Unknown function: " + name);
             
-            throw std::runtime_error("Unknown function: " + name);
+            if (cache) {
+                storeGroup(start, call.get());
+            }
+            return call;
         }
         
         return std::make_unique<VariableNode>(name);
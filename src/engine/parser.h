@@ -2,11 +2,41 @@
 #include "ast.h"
 #include <cctype>
 #include <stdexcept>
+#include <unordered_map>
+
+// Parsed subtrees of parenthesized groups and function calls, keyed by their
+// exact source text. Handing the same cache to consecutive parses of an edited
+// expression lets groups the edit did not touch be cloned instead of re-parsed.
+class ParseCache {
+private:
+    struct Entry {
+        std::unique_ptr<ASTNode> node;
+        unsigned int lastUsed;
+    };
+    std::unordered_map<std::string, Entry> entries;
+    unsigned int generation = 0;
+    
+public:
+    size_t hits = 0;
+    size_t misses = 0;
+    
+    const ASTNode* find(const std::string& source);
+    void store(const std::string& source, const ASTNode* node);
+    
+    // Start a parse; after it succeeds, entries it did not touch are dropped.
+    // A failed parse (half-typed input) keeps the previous entries alive.
+    void beginParse();
+    void evictUnused();
+    void clear() { entries.clear(); }
+    size_t size() const { return entries.size(); }
+};
 
 class Parser {
 private:
     std::string input;
     size_t pos;
+    ParseCache* cache = nullptr;
+    std::vector<size_t> matchingParen;  // Index of the ')' closing each '(' (npos if unmatched)
     
     char peek() {
         if (pos >= input.length()) return '\0';
@@ -29,6 +59,13 @@ private:
     std::unique_ptr<ASTNode> parsePower();
     std::unique_ptr<ASTNode> parsePrimary();
     
+    void matchParentheses();
+    std::unique_ptr<ASTNode> reuseGroup(size_t start, size_t open);
+    void storeGroup(size_t start, const ASTNode* node);
+    
 public:
     std::unique_ptr<ASTNode> parse(const std::string& expr);
+    
+    // Parse reusing (and refreshing) subtrees from a previous parse
+    std::unique_ptr<ASTNode> parse(const std::string& expr, ParseCache& subtreeCache);
 };
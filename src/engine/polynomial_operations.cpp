@@ -1,7 +1,18 @@
 #include "polynomial_operations.h"
+#include "eigen_solver.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
+
+// Sweeps before Aberth iteration stops; simple roots need far fewer, and
+// multiple roots converge only linearly to rounding level
+static constexpr int kAberthSweeps = 200;
+// Degrees up to which findPolynomialRoots cross-checks against the
+// companion matrix eigenvalues (an O(n³) solve)
+static constexpr size_t kCompanionCheckDegree = 200;
 
 void PolynomialOperations::solveQuadratic(double a, double b, double c) {
     steps.clear();
@@ -165,6 +176,183 @@ void PolynomialOperations::findRoots(double a, double b, double c) {
     solveQuadratic(a, b, c);
 }
 
+// p'(z)/p(z) by Horner's rule. For |z| > 1 the reversed polynomial is
+// evaluated at 1/z instead, so high degrees do not overflow.
+static std::complex<double> logDerivative(const std::vector<double>& c, std::complex<double> z) {
+    const size_t n = c.size() - 1;
+    std::complex<double> p, dp;
+    if (std::abs(z) <= 1.0) {
+        p = c[n];
+        dp = 0.0;
+        for (size_t i = n; i-- > 0;) {
+            dp = dp * z + p;
+            p = p * z + c[i];
+        }
+        if (p == 0.0) return std::numeric_limits<double>::infinity();
+        return dp / p;
+    }
+    // p(z) = zⁿ q(y), p'(z) = zⁿ⁻¹ (n q(y) - y q'(y)) with y = 1/z
+    std::complex<double> y = 1.0 / z;
+    p = c[0];
+    dp = 0.0;
+    for (size_t i = 1; i <= n; i++) {
+        dp = dp * y + p;
+        p = p * y + c[i];
+    }
+    if (p == 0.0) return std::numeric_limits<double>::infinity();
+    return (static_cast<double>(n) * p - y * dp) / (z * p);
+}
+
+std::vector<std::complex<double>> PolynomialOperations::polynomialRoots(const std::vector<double>& coeffs) {
+    std::vector<double> c = coeffs;
+    while (!c.empty() && c.back() == 0.0) {
+        c.pop_back();
+    }
+    if (c.empty()) {
+        throw std::invalid_argument("The zero polynomial has no isolated roots");
+    }
+    
+    size_t zeros = 0;
+    while (zeros + 1 < c.size() && c[zeros] == 0.0) {
+        zeros++;
+    }
+    std::vector<std::complex<double>> roots(zeros, 0.0);
+    c.erase(c.begin(), c.begin() + zeros);
+    const size_t n = c.size() - 1;
+    if (n == 0) {
+        return roots;
+    }
+    
+    // Start on a circle whose radius is the geometric mean of the root
+    // moduli, |c₀/cₙ|^(1/n), rotated off the real axis so conjugate pairs
+    // can separate
+    const double radius = std::pow(std::abs(c[0] / c[n]), 1.0 / static_cast<double>(n));
+    std::vector<std::complex<double>> z(n);
+    for (size_t k = 0; k < n; k++) {
+        z[k] = std::polar(radius, 2.0 * M_PI * k / n + 0.4);
+    }
+    
+    std::vector<bool> settled(n, false);
+    const double eps = std::numeric_limits<double>::epsilon();
+    for (int sweep = 0; sweep < kAberthSweeps; sweep++) {
+        bool done = true;
+        for (size_t k = 0; k < n; k++) {
+            if (settled[k]) continue;
+            std::complex<double> repulsion = 0.0;
+            for (size_t j = 0; j < n; j++) {
+                if (j != k) repulsion += 1.0 / (z[k] - z[j]);
+            }
+            // Newton correction p/p' deflated by the other estimates
+            std::complex<double> w = 1.0 / (logDerivative(c, z[k]) - repulsion);
+            if (!std::isfinite(w.real()) || !std::isfinite(w.imag())) {
+                w = 0.0;
+            }
+            z[k] -= w;
+            if (std::abs(w) <= 4.0 * eps * std::abs(z[k])) {
+                settled[k] = true;
+            } else {
+                done = false;
+            }
+        }
+        if (done) break;
+    }
+    
+    for (std::complex<double>& root : z) {
+        if (std::abs(root.imag()) <= std::sqrt(eps) * std::max(1.0, std::abs(root))) {
+            root = root.real();
+        }
+        roots.push_back(root);
+    }
+    std::sort(roots.begin(), roots.end(), [](const std::complex<double>& a, const std::complex<double>& b) {
+        return a.real() != b.real() ? a.real() < b.real() : a.imag() < b.imag();
+    });
+    return roots;
+}
+
+void PolynomialOperations::findPolynomialRoots(const std::vector<double>& coeffs) {
+    steps.clear();
+    
+    PolynomialStep step1;
+    step1.description = "=== Polynomial Roots ===";
+    std::ostringstream oss;
+    oss << "P(x) = ";
+    for (int i = coeffs.size() - 1; i >= 0; i--) {
+        if (i == static_cast<int>(coeffs.size()) - 1) {
+            oss << coeffs[i];
+        } else {
+            if (coeffs[i] >= 0) oss << " + ";
+            else oss << " ";
+            oss << coeffs[i];
+        }
+        if (i > 0) oss << "x";
+        if (i > 1) oss << "^" << i;
+    }
+    step1.expression = oss.str();
+    steps.push_back(step1);
+    
+    std::vector<std::complex<double>> roots = polynomialRoots(coeffs);
+    
+    PolynomialStep step2;
+    step2.description = "Method:";
+    step2.expression = "Aberth–Ehrlich iteration on all " + std::to_string(roots.size()) + " roots at once";
+    steps.push_back(step2);
+    
+    for (size_t i = 0; i < roots.size(); i++) {
+        // Residual |P(x)| by Horner's rule
+        std::complex<double> p = 0.0;
+        for (size_t j = coeffs.size(); j-- > 0;) {
+            p = p * roots[i] + coeffs[j];
+        }
+        
+        PolynomialStep stepI;
+        stepI.description = "Root " + std::to_string(i + 1) + ":";
+        std::ostringstream rootOss;
+        rootOss << std::fixed << std::setprecision(8) << "x" << (i + 1) << " = " << roots[i].real();
+        if (roots[i].imag() != 0.0) {
+            rootOss << (roots[i].imag() > 0 ? " + " : " - ") << std::abs(roots[i].imag()) << "i";
+        }
+        rootOss << std::scientific << std::setprecision(1) << "   |P(x)| = " << std::abs(p);
+        stepI.expression = rootOss.str();
+        steps.push_back(stepI);
+    }
+    
+    // Independent check: the roots are the eigenvalues of the companion
+    // matrix of the monic polynomial
+    size_t degree = coeffs.size() - 1;
+    while (degree > 0 && coeffs[degree] == 0.0) {
+        degree--;
+    }
+    if (degree == 0 || degree > kCompanionCheckDegree) {
+        return;
+    }
+    Matrix companion(static_cast<int>(degree), static_cast<int>(degree));
+    for (size_t i = 0; i < degree; i++) {
+        if (i > 0) companion.set(static_cast<int>(i), static_cast<int>(i - 1), 1.0);
+        companion.set(static_cast<int>(i), static_cast<int>(degree - 1), -coeffs[i] / coeffs[degree]);
+    }
+    try {
+        EigenSolver solver;
+        EigenDecomposition eigen = solver.computeGeneral(companion);
+        double deviation = 0.0;
+        for (const std::complex<double>& root : roots) {
+            double nearest = std::numeric_limits<double>::infinity();
+            for (const std::complex<double>& value : eigen.values) {
+                nearest = std::min(nearest, std::abs(root - value));
+            }
+            deviation = std::max(deviation, nearest);
+        }
+        
+        PolynomialStep checkStep;
+        checkStep.description = "Check (companion matrix eigenvalues, Francis QR):";
+        std::ostringstream checkOss;
+        checkOss << std::scientific << std::setprecision(1) << "max |root - nearest eigenvalue| = " << deviation;
+        checkStep.expression = checkOss.str();
+        steps.push_back(checkStep);
+    } catch (const std::runtime_error&) {
+        // QR did not converge: no check
+    }
+}
+
 void PolynomialOperations::polynomialDivision(const std::vector<double>& dividend, const std::vector<double>& divisor) {
     steps.clear();
     
@@ -1,4 +1,5 @@
 #pragma once
+#include <complex>
 #include <vector>
 #include <string>
 
@@ -10,7 +11,7 @@ struct PolynomialStep {
 class PolynomialOperations {
 private:
     std::vector<PolynomialStep> steps;
-    
+
 public:
     // Solve quadratic equation ax^2 + bx + c = 0
     void solveQuadratic(double a, double b, double c);
@@ -21,6 +22,17 @@ public:
     // Find polynomial roots for quadratic
     void findRoots(double a, double b, double c);
     
+    // All complex roots of Σ coeffs[i]·xⁱ (constant term first), by the
+    // Aberth–Ehrlich simultaneous iteration: every sweep moves each estimate
+    // by a Newton step corrected for the pull of the others, converging
+    // cubically to simple roots. Zero roots are split off first, and
+    // imaginary parts at rounding level are dropped. Throws
+    // std::invalid_argument for the zero polynomial.
+    static std::vector<std::complex<double>> polynomialRoots(const std::vector<double>& coeffs);
+    
+    // Same, with steps
+    void findPolynomialRoots(const std::vector<double>& coeffs);
+    
     // Polynomial long division
     void polynomialDivision(const std::vector<double>& dividend, const std::vector<double>& divisor);
     
@@ -0,0 +1,272 @@
+#include "root_finder.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Halvings tried before an unbracketed Newton step is given up on
+static constexpr int kMaxHalvings = 40;
+// f at an accepted root, relative to the largest |f| seen while scanning;
+// a sign change with a larger residual is a pole
+static constexpr double kResidualScale = 1e-8;
+
+RootFinder::RootFinder(const ASTNode* function)
+    : program({function}, ExpressionProgram::variablesOf(function)) {
+    inputs.assign(std::max<size_t>(1, program.inputCount()), 0.0);
+    jacobian.assign(program.inputCount(), 0.0);
+}
+
+double RootFinder::value(double x) {
+    std::fill(inputs.begin(), inputs.end(), x);
+    double y;
+    program.evaluate(inputs.data(), &y, registers);
+    evaluations++;
+    return y;
+}
+
+double RootFinder::value(double x, double& derivative) {
+    std::fill(inputs.begin(), inputs.end(), x);
+    double y;
+    program.evaluateWithJacobian(inputs.data(), &y, jacobian.data(), registers, gradients);
+    evaluations++;
+    // Every variable is x, so df/dx sums the partials
+    derivative = 0.0;
+    for (double partial : jacobian) {
+        derivative += partial;
+    }
+    return y;
+}
+
+static double tolerance(double x, const RootOptions& options) {
+    return options.absoluteTolerance + options.relativeTolerance * std::abs(x);
+}
+
+RootResult RootFinder::brent(double a, double b, const RootOptions& options) {
+    double fa = value(a);
+    double fb = value(b);
+    RootResult result;
+    if (fa == 0.0 || fb == 0.0) {
+        result.root = fa == 0.0 ? a : b;
+        result.value = 0.0;
+        result.converged = true;
+        return result;
+    }
+    if (!((fa < 0) != (fb < 0))) {
+        throw std::invalid_argument("f(a) and f(b) must have opposite signs");
+    }
+    
+    // b is the best estimate, c the contrapoint (f(b), f(c) of opposite sign)
+    double c = a, fc = fa;
+    double d = b - a, e = d;
+    for (int i = 0; i < options.maxIterations; i++) {
+        result.iterations = i + 1;
+        if ((fb > 0) == (fc > 0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (std::abs(fc) < std::abs(fb)) {
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+        
+        const double tol = 0.5 * tolerance(b, options);
+        const double m = 0.5 * (c - b);
+        if (std::abs(m) <= tol || fb == 0.0) {
+            result.converged = true;
+            break;
+        }
+        
+        if (std::abs(e) >= tol && std::abs(fa) > std::abs(fb)) {
+            double s = fb / fa, p, q;
+            if (a == c) {
+                // Secant
+                p = 2.0 * m * s;
+                q = 1.0 - s;
+            } else {
+                // Inverse quadratic interpolation through a, b, c
+                double qa = fa / fc, r = fb / fc;
+                p = s * (2.0 * m * qa * (qa - r) - (b - a) * (r - 1.0));
+                q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0) q = -q; else p = -p;
+            // Accept the interpolation only if it lands well inside the
+            // bracket and shrinks faster than the step before last
+            if (2.0 * p < std::min(3.0 * m * q - std::abs(tol * q), std::abs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = e = m;
+            }
+        } else {
+            d = e = m;
+        }
+        
+        a = b;
+        fa = fb;
+        b += std::abs(d) > tol ? d : (m > 0 ? tol : -tol);
+        fb = value(b);
+    }
+    
+    result.root = b;
+    result.value = fb;
+    return result;
+}
+
+RootResult RootFinder::newton(double x0, const RootOptions& options) {
+    RootResult result;
+    double derivative;
+    double x = x0;
+    double fx = value(x, derivative);
+    
+    for (int i = 0; i < options.maxIterations; i++) {
+        result.iterations = i + 1;
+        if (fx == 0.0) {
+            result.converged = true;
+            break;
+        }
+        if (derivative == 0.0 || !std::isfinite(fx) || !std::isfinite(derivative)) {
+            break;
+        }
+        
+        double step = fx / derivative;
+        if (std::abs(step) <= tolerance(x, options)) {
+            x -= step;
+            fx = value(x, derivative);
+            result.converged = true;
+            break;
+        }
+        
+        double nextDerivative;
+        double next = x - step;
+        double fNext = value(next, nextDerivative);
+        int halvings = 0;
+        while (!(std::abs(fNext) < std::abs(fx)) && halvings < kMaxHalvings) {
+            step *= 0.5;
+            next = x - step;
+            fNext = value(next, nextDerivative);
+            halvings++;
+        }
+        if (halvings == kMaxHalvings) {
+            // No step along -f/f' reduces |f|: a local minimum of |f|
+            break;
+        }
+        x = next;
+        fx = fNext;
+        derivative = nextDerivative;
+    }
+    
+    result.root = x;
+    result.value = fx;
+    return result;
+}
+
+RootResult RootFinder::newton(double x0, double a, double b, const RootOptions& options) {
+    double fa = value(a);
+    double fb = value(b);
+    RootResult result;
+    if (fa == 0.0 || fb == 0.0) {
+        result.root = fa == 0.0 ? a : b;
+        result.value = 0.0;
+        result.converged = true;
+        return result;
+    }
+    if (!((fa < 0) != (fb < 0))) {
+        throw std::invalid_argument("f(a) and f(b) must have opposite signs");
+    }
+    
+    // Keep f(low) < 0 < f(high)
+    double low = fa < 0 ? a : b;
+    double high = fa < 0 ? b : a;
+    double x = std::min(std::max(x0, std::min(a, b)), std::max(a, b));
+    double step = std::abs(b - a), previousStep = step;
+    double derivative;
+    double fx = value(x, derivative);
+    
+    for (int i = 0; i < options.maxIterations; i++) {
+        result.iterations = i + 1;
+        bool leavesBracket = ((x - high) * derivative - fx) * ((x - low) * derivative - fx) > 0.0;
+        bool tooSlow = std::abs(2.0 * fx) > std::abs(previousStep * derivative);
+        previousStep = step;
+        if (leavesBracket || tooSlow || !std::isfinite(derivative)) {
+            step = 0.5 * (high - low);
+            x = low + step;
+        } else {
+            step = fx / derivative;
+            x -= step;
+        }
+        fx = value(x, derivative);
+        if (std::abs(step) <= tolerance(x, options) || fx == 0.0) {
+            result.converged = true;
+            break;
+        }
+        if (fx < 0) low = x; else high = x;
+    }
+    
+    result.root = x;
+    result.value = fx;
+    return result;
+}
+
+std::vector<double> RootFinder::findAll(double a, double b, size_t samples, const RootOptions& options) {
+    if (!(b > a)) {
+        throw std::invalid_argument("Root scan needs an interval with a < b");
+    }
+    if (program.inputCount() == 0) {
+        // A constant has no isolated roots
+        return {};
+    }
+    samples = std::max<size_t>(samples, 2);
+    const size_t count = samples + 1;
+    const double width = (b - a) / samples;
+    
+    // All samples in one batch, every variable row holding the grid
+    std::vector<double> grid(count * program.inputCount());
+    for (size_t i = 0; i < count; i++) {
+        grid[i] = i == samples ? b : a + width * static_cast<double>(i);
+    }
+    for (size_t v = 1; v < program.inputCount(); v++) {
+        std::copy(grid.begin(), grid.begin() + count, grid.begin() + v * count);
+    }
+    std::vector<double> f(count), blockRegisters;
+    program.evaluateBlock(grid.data(), count, f.data(), blockRegisters);
+    evaluations += count;
+    
+    double scale = 1.0;
+    for (double y : f) {
+        if (std::isfinite(y)) scale = std::max(scale, std::abs(y));
+    }
+    const double residual = kResidualScale * scale;
+    
+    std::vector<double> roots;
+    for (size_t i = 0; i < samples; i++) {
+        const double x0 = grid[i], x1 = grid[i + 1];
+        const double f0 = f[i], f1 = f[i + 1];
+        if (!std::isfinite(f0) || !std::isfinite(f1)) continue;
+        
+        if (f0 == 0.0) {
+            roots.push_back(x0);
+        } else if (f1 != 0.0 && (f0 < 0) != (f1 < 0)) {
+            RootResult r = brent(x0, x1, options);
+            if (r.converged && std::abs(r.value) <= residual) {
+                roots.push_back(r.root);
+            }
+        } else if (i > 0 && f1 != 0.0 && std::isfinite(f[i - 1]) &&
+                   std::abs(f0) < std::abs(f[i - 1]) && std::abs(f0) <= std::abs(f1)) {
+            // |f| dips without changing sign: a double root or a near miss
+            RootResult r = newton(x0, options);
+            if (r.converged && std::abs(r.value) <= residual && r.root >= grid[i - 1] && r.root <= x1) {
+                roots.push_back(r.root);
+            }
+        }
+    }
+    if (f[samples] == 0.0) {
+        roots.push_back(b);
+    }
+    
+    std::sort(roots.begin(), roots.end());
+    const double separation = std::max(options.absoluteTolerance, 1e-9 * (b - a));
+    roots.erase(std::unique(roots.begin(), roots.end(),
+                            [separation](double p, double q) { return q - p <= separation; }),
+                roots.end());
+    return roots;
+}
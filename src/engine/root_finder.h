@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "ast.h"
+#include "expression_program.h"
+
+struct RootOptions {
+    double absoluteTolerance = 1e-12;   // On x
+    double relativeTolerance = 4e-16;   // On x, times |x|
+    int maxIterations = 100;
+};
+
+struct RootResult {
+    double root = std::numeric_limits<double>::quiet_NaN();
+    double value = std::numeric_limits<double>::quiet_NaN();   // f(root)
+    int iterations = 0;
+    bool converged = false;
+};
+
+// Root finding for a function of one variable. The expression is compiled
+// once into an ExpressionProgram (every variable stands for x), so each
+// evaluation is a flat pass over registers, and f' comes from the same pass
+// by forward-mode AD rather than from a derivative tree. Holds evaluation
+// workspace, so use one RootFinder per thread.
+class RootFinder {
+private:
+    ExpressionProgram program;
+    std::vector<double> inputs;
+    std::vector<double> registers;
+    std::vector<double> gradients;
+    std::vector<double> jacobian;
+    size_t evaluations = 0;
+
+public:
+    explicit RootFinder(const ASTNode* function);
+    
+    double value(double x);
+    double value(double x, double& derivative);
+    
+    // Brent's method: inverse quadratic interpolation and secant steps,
+    // falling back to bisection, with every f value reused. Throws
+    // std::invalid_argument unless f(a) and f(b) differ in sign.
+    RootResult brent(double a, double b, const RootOptions& options = RootOptions());
+    
+    // Newton's method from x0. Steps are halved until |f| decreases, so it
+    // cannot run off on a bad step; it may still fail to converge.
+    RootResult newton(double x0, const RootOptions& options = RootOptions());
+    
+    // Newton's method kept inside a sign-change bracket [a, b]: a step that
+    // would leave the bracket or is not halving |f| fast enough becomes a
+    // bisection. Always converges. Throws like brent for a bad bracket.
+    RootResult newton(double x0, double a, double b, const RootOptions& options = RootOptions());
+    
+    // Every root in [a, b]. f is sampled at samples + 1 points in one batch;
+    // sign changes are refined with Brent (poles, where |f| blows up instead,
+    // are rejected) and dips of |f| without a sign change, i.e. roots of even
+    // multiplicity, with Newton. Roots closer than the sample spacing may be
+    // missed, as with any scan. Sorted ascending.
+    std::vector<double> findAll(double a, double b, size_t samples = 1000, const RootOptions& options = RootOptions());
+    
+    size_t getEvaluations() const { return evaluations; }
+};
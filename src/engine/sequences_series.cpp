@@ -1,13 +1,413 @@
 #include "sequences_series.h"
+#include "expression_program.h"
+#include "extrapolation.h"
+#include "job_system.h"
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <limits>
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
+
+// Leading partial sums handed to the Aitken, Wynn and Levin transforms;
+// beyond this their tables lose more to rounding than they gain
+static constexpr size_t kTransformTerms = 40;
+// Terms collected for acceleration by computeSeriesSum; longer sums go
+// through sumTerms
+static constexpr int kAccelerationTerms = 1024;
+// Terms per block in sumTerms. Fixed, so the block sums and the order they
+// are combined in do not depend on the machine.
+static constexpr uint64_t kSumBlock = uint64_t(1) << 16;
+// Terms evaluated per ExpressionProgram::evaluateBlock call
+static constexpr size_t kSumBatch = 4096;
+// Terms decaying like n^-p converge for p > 1, but below this exponent too
+// slowly for the leading terms to pin down the sum
+static constexpr double kSummableExponent = 1.1;
+
+const char* seriesAccelerationName(SeriesAcceleration method) {
+    switch (method) {
+        case SeriesAcceleration::NONE: return "Partial sum";
+        case SeriesAcceleration::RICHARDSON: return "Richardson";
+        case SeriesAcceleration::AITKEN: return "Aitken Δ²";
+        case SeriesAcceleration::WYNN_EPSILON: return "Wynn ε";
+        case SeriesAcceleration::LEVIN_U: return "Levin u";
+    }
+    return "Unknown";
+}
 
 double SequencesSeriesCalculator::evaluateNthTerm(const ASTNode* formula, int n) {
     // For now, assumes formula is in terms of x, replace with n
     return formula->evaluate(static_cast<double>(n));
 }
 
+static std::vector<double> partialSums(const std::vector<double>& terms, size_t count) {
+    std::vector<double> sums;
+    sums.reserve(count);
+    CompensatedSum sum;
+    for (size_t i = 0; i < count; i++) {
+        sum.add(terms[i]);
+        sums.push_back(sum.value());
+    }
+    return sums;
+}
+
+// From a sequence of successive estimates (value, terms used), keeps the one
+// that agrees best with its predecessor; that difference is the error estimate
+static SeriesEstimate bestEstimate(const std::vector<std::pair<double, int>>& estimates, SeriesAcceleration method) {
+    SeriesEstimate best;
+    best.method = method;
+    best.error = std::numeric_limits<double>::infinity();
+    if (estimates.empty()) {
+        best.value = std::numeric_limits<double>::quiet_NaN();
+        return best;
+    }
+    best.value = estimates[0].first;
+    best.termsUsed = estimates[0].second;
+    for (size_t i = 1; i < estimates.size(); i++) {
+        double error = std::max(std::abs(estimates[i].first - estimates[i - 1].first),
+                                4.0 * std::numeric_limits<double>::epsilon() * std::abs(estimates[i].first));
+        if (std::isfinite(estimates[i].first) && error < best.error) {
+            best.value = estimates[i].first;
+            best.error = error;
+            best.termsUsed = estimates[i].second;
+        }
+    }
+    return best;
+}
+
+// Bound on the tail Σ_{n>N} aₙ that the last terms actually support: |a_N|
+// when they alternate in sign and shrink (Leibniz), |a_N|·r/(1-r) when
+// their ratios stay below some r < 1, and infinity otherwise
+static double tailBound(const std::vector<double>& terms) {
+    const size_t N = terms.size();
+    const size_t window = std::min<size_t>(N - 1, 8);
+    if (window == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    bool alternating = true, shrinking = true;
+    double ratio = 0.0;
+    for (size_t i = N - window; i < N; i++) {
+        const double previous = terms[i - 1], current = terms[i];
+        if (current == 0.0 && previous == 0.0) continue;
+        if (previous == 0.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        if ((previous < 0) == (current < 0)) alternating = false;
+        if (std::abs(current) > std::abs(previous)) shrinking = false;
+        ratio = std::max(ratio, std::abs(current / previous));
+    }
+    if (alternating && shrinking) {
+        return std::abs(terms.back());
+    }
+    if (ratio < 1.0) {
+        return std::abs(terms.back()) * ratio / (1.0 - ratio);
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
+// Pairwise (cascade) sum, in place: error grows with log n rather than n
+static double pairwiseSum(double* values, size_t count) {
+    if (count == 0) return 0.0;
+    for (size_t width = 1; width < count; width *= 2) {
+        for (size_t i = 0; i + width < count; i += 2 * width) {
+            values[i] += values[i + width];
+        }
+    }
+    return values[0];
+}
+
+CompensatedSum SequencesSeriesCalculator::sumTerms(const ASTNode* formula, uint64_t numTerms) {
+    std::vector<std::string> variables = ExpressionProgram::variablesOf(formula);
+    const ExpressionProgram program({formula}, variables);
+    const size_t variableCount = variables.size();
+    
+    const size_t blocks = static_cast<size_t>((numTerms + kSumBlock - 1) / kSumBlock);
+    std::vector<CompensatedSum> blockSums(blocks);
+    
+    struct Worker {
+        std::vector<double> inputs;
+        std::vector<double> values;
+        std::vector<double> registers;
+    };
+    const size_t threadCount = parallelChunkCount(blocks, 1);
+    std::vector<Worker> workers(threadCount);
+    for (Worker& worker : workers) {
+        worker.inputs.resize(std::max<size_t>(1, variableCount) * kSumBatch);
+        worker.values.resize(kSumBatch);
+    }
+    
+    JobContext* job = JobContext::current();
+    std::atomic<size_t> completed{0};
+    
+    parallelDynamic(blocks, threadCount, 1, [&](size_t w, size_t block) {
+        if (job && job->isCancelled()) {
+            throw JobCancelled();
+        }
+        Worker& worker = workers[w];
+        const uint64_t first = block * kSumBlock + 1;
+        const uint64_t last = std::min(numTerms, first + kSumBlock - 1);
+        
+        CompensatedSum sum;
+        for (uint64_t start = first; start <= last; start += kSumBatch) {
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(kSumBatch, last - start + 1));
+            for (size_t p = 0; p < count; p++) {
+                worker.inputs[p] = static_cast<double>(start + p);
+            }
+            for (size_t v = 1; v < variableCount; v++) {
+                std::copy(worker.inputs.begin(), worker.inputs.begin() + count, worker.inputs.begin() + v * count);
+            }
+            program.evaluateBlock(worker.inputs.data(), count, worker.values.data(), worker.registers);
+            sum.add(pairwiseSum(worker.values.data(), count));
+        }
+        blockSums[block] = sum;
+        
+        size_t done = completed.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (job && w == 0) {
+            job->setProgress(static_cast<float>(done) / blocks);
+        }
+    });
+    
+    CompensatedSum total;
+    for (const CompensatedSum& blockSum : blockSums) {
+        total.add(blockSum);
+    }
+    return total;
+}
+
+SeriesEstimate SequencesSeriesCalculator::accelerateSeries(const std::vector<double>& terms, SeriesAcceleration method) {
+    const size_t N = terms.size();
+    if (N == 0) {
+        throw std::invalid_argument("Series acceleration needs at least one term");
+    }
+    std::vector<std::pair<double, int>> estimates;
+    
+    switch (method) {
+        case SeriesAcceleration::NONE: {
+            SeriesEstimate estimate;
+            estimate.value = partialSums(terms, N).back();
+            estimate.error = std::max(tailBound(terms),
+                                      4.0 * std::numeric_limits<double>::epsilon() * std::abs(estimate.value));
+            estimate.termsUsed = static_cast<int>(N);
+            return estimate;
+        }
+        
+        case SeriesAcceleration::RICHARDSON: {
+            // S_n ≈ S + c₁/n + c₂/n² + ... sampled at n = 2, 4, 8, ... (even n
+            // keeps alternating series on one branch)
+            std::vector<double> sums = partialSums(terms, N);
+            std::vector<double> samples;
+            std::vector<int> counts;
+            for (size_t n = 2; n <= N; n *= 2) {
+                samples.push_back(sums[n - 1]);
+                counts.push_back(static_cast<int>(n));
+            }
+            std::vector<double> diagonal = extrapolateHalving(samples);
+            for (size_t i = 0; i < diagonal.size(); i++) {
+                estimates.push_back({diagonal[i], counts[i]});
+            }
+            break;
+        }
+        
+        case SeriesAcceleration::AITKEN: {
+            // Repeated Δ² on each prefix of the partial sums
+            std::vector<double> sums = partialSums(terms, std::min(N, kTransformTerms));
+            std::vector<double> column;
+            for (size_t m = 3; m <= sums.size(); m++) {
+                column.assign(sums.begin(), sums.begin() + m);
+                while (column.size() >= 3) {
+                    for (size_t i = 0; i + 2 < column.size(); i++) {
+                        double d1 = column[i + 1] - column[i];
+                        double d2 = column[i + 2] - column[i + 1];
+                        double denominator = d2 - d1;
+                        column[i] = denominator != 0.0 ? column[i + 2] - d2 * d2 / denominator : column[i + 2];
+                    }
+                    column.resize(column.size() - 2);
+                }
+                estimates.push_back({column.back(), static_cast<int>(m)});
+            }
+            break;
+        }
+        
+        case SeriesAcceleration::WYNN_EPSILON: {
+            // One ascending ε diagonal per partial sum
+            std::vector<double> sums = partialSums(terms, std::min(N, kTransformTerms));
+            std::vector<double> diagonal = wynnEpsilon(sums);
+            for (size_t m = 0; m < diagonal.size(); m++) {
+                estimates.push_back({diagonal[m], static_cast<int>(m + 1)});
+            }
+            break;
+        }
+        
+        case SeriesAcceleration::LEVIN_U: {
+            // L_k = Σ (-1)ʲ C(k,j) ((1+j)/(1+k))^(k-1) S_j/ω_j  /  Σ (same)/ω_j
+            // with remainder estimates ω_j = (j+1)·a_{j+1}
+            std::vector<double> sums = partialSums(terms, std::min(N, kTransformTerms));
+            for (size_t k = 1; k < sums.size(); k++) {
+                double numerator = 0.0, denominator = 0.0, binomial = 1.0;
+                bool defined = true;
+                for (size_t j = 0; j <= k; j++) {
+                    double omega = (j + 1.0) * terms[j];
+                    if (omega == 0.0) {
+                        defined = false;
+                        break;
+                    }
+                    double weight = binomial * std::pow((1.0 + j) / (1.0 + k), static_cast<double>(k) - 1.0) / omega;
+                    if (j & 1) weight = -weight;
+                    numerator += weight * sums[j];
+                    denominator += weight;
+                    binomial = binomial * static_cast<double>(k - j) / static_cast<double>(j + 1);
+                }
+                if (!defined) break;
+                estimates.push_back({numerator / denominator, static_cast<int>(k + 1)});
+            }
+            break;
+        }
+    }
+    
+    return bestEstimate(estimates, method);
+}
+
+// aₙ₊₁/aₙ → 1 with terms of one sign. Aitken and Wynn only accelerate
+// linear convergence and settle on a wrong limit for these, so only
+// Richardson and Levin u apply. The ratio limit is extrapolated from
+// n = 10, 20, 40, ... as in ratioTest.
+static bool convergesLogarithmically(const std::vector<double>& terms) {
+    std::vector<double> ratios;
+    for (size_t n = 10; n < terms.size(); n *= 2) {
+        ratios.push_back(terms[n] / terms[n - 1]);
+    }
+    if (ratios.empty()) {
+        if (terms.size() < 2) return false;
+        ratios.push_back(terms.back() / terms[terms.size() - 2]);
+    }
+    double limit = extrapolateHalving(ratios).back();
+    return std::isfinite(limit) && std::abs(limit - 1.0) < 0.02;
+}
+
+static std::vector<SeriesAcceleration> applicableMethods(const std::vector<double>& terms) {
+    if (convergesLogarithmically(terms)) {
+        return {SeriesAcceleration::RICHARDSON, SeriesAcceleration::LEVIN_U};
+    }
+    return {SeriesAcceleration::RICHARDSON, SeriesAcceleration::AITKEN,
+            SeriesAcceleration::WYNN_EPSILON, SeriesAcceleration::LEVIN_U};
+}
+
+// Decay exponent p of terms of one sign with aₙ₊₁/aₙ → 1, from aₙ/a₂ₙ = 2ᵖ
+// extrapolated over n = 8, 16, ... A pure power settles at once, while a
+// logarithmic factor keeps the estimate drifting (by about 0.01 per doubling
+// for 1/(n·ln n)), so [low, high] is p widened by ten times its last change.
+// Returns false when the terms change sign or are too few.
+static bool decayExponent(const std::vector<double>& terms, double& p, double& low, double& high) {
+    const size_t N = terms.size();
+    for (size_t i = N / 8; i < N; i++) {
+        if ((terms[i] < 0) != (terms.back() < 0) || terms[i] == 0.0) return false;
+    }
+    std::vector<double> exponents;
+    for (size_t n = 8; 2 * n <= N; n *= 2) {
+        exponents.push_back(std::log2(terms[n - 1] / terms[2 * n - 1]));
+    }
+    if (exponents.size() < 2) return false;
+    std::vector<double> diagonal = extrapolateHalving(exponents);
+    p = diagonal.back();
+    double drift = 10.0 * std::abs(diagonal.back() - diagonal[diagonal.size() - 2]);
+    low = p - drift;
+    high = p + drift;
+    return std::isfinite(low) && std::isfinite(high);
+}
+
+// Why the leading terms show that Σ aₙ has no finite value, or "" if they
+// do not: a term that is not finite; terms that do not tend to 0 (the
+// largest |aₙ| over the last quarter is not below that over the second);
+// or, for terms of one sign with aₙ₊₁/aₙ → 1, a decay exponent that stays
+// at most 1
+static std::string divergenceReason(const std::vector<double>& terms) {
+    const size_t N = terms.size();
+    for (size_t i = 0; i < N; i++) {
+        if (!std::isfinite(terms[i])) {
+            return "term a" + std::to_string(i + 1) + " is not finite";
+        }
+    }
+    if (N < 8) return "";
+    
+    double early = 0.0, late = 0.0;
+    for (size_t i = N / 4; i < N / 2; i++) early = std::max(early, std::abs(terms[i]));
+    for (size_t i = 3 * N / 4; i < N; i++) late = std::max(late, std::abs(terms[i]));
+    if (late > 0.0 && late >= 0.99 * early) {
+        return "the terms do not tend to 0";
+    }
+    
+    double p, low, high;
+    if (convergesLogarithmically(terms) && decayExponent(terms, p, low, high) && high <= 1.0 + 1e-9) {
+        std::ostringstream oss;
+        oss << std::setprecision(3) << "aₙ₊₁/aₙ → 1 and aₙ decays like n^-" << std::max(p, 0.0)
+            << ", no faster than 1/n";
+        return oss.str();
+    }
+    return "";
+}
+
+// Why no sum is given for a series not shown to diverge, or "" if one can
+// be: with aₙ₊₁/aₙ → 1 the decay exponent must be measurable and stay at
+// least kSummableExponent. Agreement between Richardson and Levin u is not
+// taken as evidence of convergence, since both can settle on a finite
+// value for Σ 1/(n·ln n).
+static std::string inconclusiveReason(const std::vector<double>& terms) {
+    if (!convergesLogarithmically(terms)) return "";
+    double p, low, high;
+    if (!decayExponent(terms, p, low, high)) {
+        return "aₙ₊₁/aₙ → 1 and the decay of aₙ cannot be measured";
+    }
+    if (low < kSummableExponent) {
+        std::ostringstream oss;
+        oss << std::setprecision(3) << "aₙ decays like n^-" << p
+            << ", too close to 1/n to tell convergence from divergence";
+        return oss.str();
+    }
+    return "";
+}
+
+// Logarithmic convergence leaves Richardson and Levin u as the only
+// estimates; when they disagree by more than their error bars neither can
+// be trusted
+static bool logarithmicEstimatesAgree(const SeriesEstimate& richardson, const SeriesEstimate& levin) {
+    if (!std::isfinite(richardson.value) || !std::isfinite(levin.value)) return false;
+    // Levin u understates its error near the last few digits, so a gap at
+    // that level says nothing about divergence.
+    double floor = 1e-8 * std::max(1.0, std::abs(richardson.value));
+    return std::abs(richardson.value - levin.value) <= std::max(floor, 10.0 * (richardson.error + levin.error));
+}
+
+SeriesEstimate SequencesSeriesCalculator::sumSeries(const std::vector<double>& terms) {
+    SeriesEstimate best = accelerateSeries(terms, SeriesAcceleration::NONE);
+    if (!divergenceReason(terms).empty()) {
+        best.value = std::numeric_limits<double>::quiet_NaN();
+        best.error = std::numeric_limits<double>::infinity();
+        best.diverges = true;
+        return best;
+    }
+    if (!inconclusiveReason(terms).empty()) {
+        best.value = std::numeric_limits<double>::quiet_NaN();
+        best.error = std::numeric_limits<double>::infinity();
+        return best;
+    }
+    std::vector<SeriesEstimate> estimates;
+    for (SeriesAcceleration method : applicableMethods(terms)) {
+        SeriesEstimate estimate = accelerateSeries(terms, method);
+        estimates.push_back(estimate);
+        if (std::isfinite(estimate.value) && estimate.error < best.error) {
+            best = estimate;
+        }
+    }
+    if (convergesLogarithmically(terms) && !logarithmicEstimatesAgree(estimates[0], estimates[1])) {
+        best.value = std::numeric_limits<double>::quiet_NaN();
+        best.error = std::numeric_limits<double>::infinity();
+    }
+    return best;
+}
+
 void SequencesSeriesCalculator::analyzeArithmetic(double a, double d, int n) {
     steps.clear();
     
@@ -205,27 +605,153 @@ void SequencesSeriesCalculator::computeSeriesSum(const ASTNode* formula, int num
     step2.expression = "";
     steps.push_back(step2);
     
-    double sum = 0.0;
-    for (int i = 1; i <= numTerms; i++) {
+    // Leading terms one by one for display and acceleration; the full sum
+    // of a long series goes through the batched, threaded path
+    const int leading = std::max(0, std::min(numTerms, kAccelerationTerms));
+    CompensatedSum sum;
+    std::vector<double> terms;
+    terms.reserve(leading);
+    for (int i = 1; i <= leading; i++) {
         double term = evaluateNthTerm(formula, i);
-        sum += term;
+        sum.add(term);
+        terms.push_back(term);
         
         if (i <= 10 || i == numTerms) {
             SequenceStep stepI;
             stepI.description = "S" + std::to_string(i) + " (sum of first " + std::to_string(i) + " terms):";
             std::ostringstream oss;
             oss << std::fixed << std::setprecision(6);
-            oss << sum;
+            oss << sum.value();
             stepI.expression = oss.str();
             steps.push_back(stepI);
         }
     }
+    double total = sum.value();
+    if (numTerms > leading) {
+        total = sumTerms(formula, static_cast<uint64_t>(numTerms)).value();
+        
+        SequenceStep lastStep;
+        lastStep.description = "S" + std::to_string(numTerms) + " (sum of first " + std::to_string(numTerms) + " terms):";
+        std::ostringstream lastOss;
+        lastOss << std::fixed << std::setprecision(6) << total;
+        lastStep.expression = lastOss.str();
+        steps.push_back(lastStep);
+    }
     
     SequenceStep finalStep;
     finalStep.description = "=== Final Result ===";
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(6);
-    oss << "S" << numTerms << " = " << sum;
+    oss << "S" << numTerms << " = " << total;
+    finalStep.expression = oss.str();
+    steps.push_back(finalStep);
+    
+    if (terms.size() < 3) {
+        return;
+    }
+    
+    std::string divergence = divergenceReason(terms);
+    if (!divergence.empty()) {
+        SequenceStep divergeStep;
+        divergeStep.description = "=== Infinite Sum ===";
+        divergeStep.expression = "Diverges: " + divergence;
+        steps.push_back(divergeStep);
+        return;
+    }
+    std::string inconclusive = inconclusiveReason(terms);
+    if (!inconclusive.empty()) {
+        SequenceStep unsureStep;
+        unsureStep.description = "=== Infinite Sum ===";
+        unsureStep.expression = "No reliable estimate: " + inconclusive;
+        steps.push_back(unsureStep);
+        return;
+    }
+    
+    SequenceStep accelStep;
+    accelStep.description = "Series acceleration (first " + std::to_string(terms.size()) + " terms):";
+    accelStep.expression = convergesLogarithmically(terms)
+        ? "Logarithmic convergence (aₙ₊₁/aₙ → 1): Richardson and Levin u only"
+        : "";
+    steps.push_back(accelStep);
+    
+    SeriesEstimate best = accelerateSeries(terms, SeriesAcceleration::NONE);
+    std::vector<SeriesEstimate> estimates;
+    for (SeriesAcceleration method : applicableMethods(terms)) {
+        SeriesEstimate estimate = accelerateSeries(terms, method);
+        estimates.push_back(estimate);
+        
+        SequenceStep methodStep;
+        methodStep.description = std::string(seriesAccelerationName(method)) + ":";
+        std::ostringstream methodOss;
+        methodOss << std::setprecision(12) << estimate.value
+                  << std::scientific << std::setprecision(1) << "  (± " << estimate.error
+                  << ", " << estimate.termsUsed << " terms)";
+        methodStep.expression = methodOss.str();
+        steps.push_back(methodStep);
+        
+        if (std::isfinite(estimate.value) && estimate.error < best.error) {
+            best = estimate;
+        }
+    }
+    
+    if (convergesLogarithmically(terms) && !logarithmicEstimatesAgree(estimates[0], estimates[1])) {
+        SequenceStep unsureStep;
+        unsureStep.description = "=== Infinite Sum ===";
+        unsureStep.expression = "No reliable estimate: Richardson and Levin u disagree, so the series may "
+                                "diverge or converge too slowly to tell";
+        steps.push_back(unsureStep);
+        return;
+    }
+    if (!std::isfinite(best.error)) {
+        SequenceStep unsureStep;
+        unsureStep.description = "=== Infinite Sum ===";
+        unsureStep.expression = "No reliable estimate: no method settled";
+        steps.push_back(unsureStep);
+        return;
+    }
+    
+    SequenceStep bestStep;
+    bestStep.description = "=== Estimated Infinite Sum ===";
+    std::ostringstream bestOss;
+    bestOss << "S ≈ " << std::setprecision(12) << best.value
+            << std::scientific << std::setprecision(1) << "  (± " << best.error
+            << ", " << seriesAccelerationName(best.method) << ")";
+    bestStep.expression = bestOss.str();
+    steps.push_back(bestStep);
+}
+
+void SequencesSeriesCalculator::computeLargeSeriesSum(const ASTNode* formula, uint64_t numTerms) {
+    steps.clear();
+    
+    SequenceStep step1;
+    step1.description = "=== Series Sum ===";
+    step1.expression = "Σ aₙ for n = 1.." + std::to_string(numTerms) + " where aₙ = " + formula->toString();
+    steps.push_back(step1);
+    
+    const size_t blocks = static_cast<size_t>((numTerms + kSumBlock - 1) / kSumBlock);
+    SequenceStep step2;
+    step2.description = "Method:";
+    step2.expression = std::to_string(blocks) + " blocks of " + std::to_string(kSumBlock) + " terms on " +
+                       std::to_string(parallelChunkCount(blocks, 1)) +
+                       " threads; pairwise sums per batch, compensated across batches";
+    steps.push_back(step2);
+    
+    auto start = std::chrono::steady_clock::now();
+    CompensatedSum sum = sumTerms(formula, numTerms);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    SequenceStep timeStep;
+    timeStep.description = "Time:";
+    std::ostringstream timeOss;
+    timeOss << std::fixed << std::setprecision(3) << seconds << " s ("
+            << std::setprecision(1) << numTerms / std::max(seconds, 1e-9) / 1e6 << " M terms/s)";
+    timeStep.expression = timeOss.str();
+    steps.push_back(timeStep);
+    
+    SequenceStep finalStep;
+    finalStep.description = "=== Final Result ===";
+    std::ostringstream oss;
+    oss << "S" << numTerms << " = " << std::setprecision(15) << sum.value();
     finalStep.expression = oss.str();
     steps.push_back(finalStep);
 }
@@ -243,33 +769,44 @@ void SequencesSeriesCalculator::ratioTest(const ASTNode* formula) {
     step2.expression = "";
     steps.push_back(step2);
     
-    // Compute ratio for several n values
+    // Ratios at n = 10, 20, 40, ..., 160 (160! still fits a double),
+    // extrapolated in 1/n since |aₙ₊₁/aₙ| = L + c₁/n + c₂/n² + ...
     std::vector<double> ratios;
-    for (int n = 10; n <= 100; n += 10) {
+    for (int n = 10; n <= 160; n *= 2) {
         double an = evaluateNthTerm(formula, n);
         double an1 = evaluateNthTerm(formula, n+1);
-        if (std::abs(an) > 1e-10) {
-            double ratio = std::abs(an1 / an);
-            ratios.push_back(ratio);
-        }
+        double ratio = std::abs(an1 / an);
+        if (an == 0.0 || !std::isfinite(ratio)) break;
+        ratios.push_back(ratio);
     }
     
     if (!ratios.empty()) {
-        double L = ratios.back();
+        std::vector<std::pair<double, int>> estimates;
+        std::vector<double> diagonal = extrapolateHalving(ratios);
+        for (size_t i = 0; i < diagonal.size(); i++) {
+            estimates.push_back({diagonal[i], 10 << i});
+        }
+        SeriesEstimate limit = bestEstimate(estimates, SeriesAcceleration::RICHARDSON);
+        double L = limit.value;
+        double uncertainty = std::max(limit.error, 1e-8);
         
         SequenceStep step3;
         step3.description = "Computed limit:";
         std::ostringstream oss;
         oss << std::fixed << std::setprecision(6);
         oss << "L ≈ " << L;
+        if (std::isfinite(limit.error)) {
+            oss << std::scientific << std::setprecision(1) << "  (± " << limit.error
+                << ", Richardson over n = 10.." << limit.termsUsed << ")";
+        }
         step3.expression = oss.str();
         steps.push_back(step3);
         
         SequenceStep step4;
         step4.description = "Conclusion:";
-        if (L < 1.0) {
+        if (L < 1.0 - uncertainty) {
             step4.expression = "L < 1: Series CONVERGES absolutely";
-        } else if (L > 1.0) {
+        } else if (L > 1.0 + uncertainty) {
             step4.expression = "L > 1: Series DIVERGES";
         } else {
             step4.expression = "L = 1: Test INCONCLUSIVE";
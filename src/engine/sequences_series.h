@@ -1,5 +1,7 @@
 #pragma once
 #include "ast.h"
+#include <cmath>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -17,12 +19,57 @@ enum class ConvergenceTest {
     ALTERNATING_SERIES
 };
 
+// Sequence transformations for estimating the limit of a slowly converging
+// series from its first few hundred partial sums
+enum class SeriesAcceleration {
+    NONE,           // Last partial sum
+    RICHARDSON,     // Polynomial extrapolation in 1/n over S_1, S_2, S_4, ...
+    AITKEN,         // Iterated Aitken Δ²
+    WYNN_EPSILON,   // Wynn's ε algorithm (Shanks transform)
+    LEVIN_U         // Levin u transform, remainder estimate n·aₙ
+};
+
+const char* seriesAccelerationName(SeriesAcceleration method);
+
+struct SeriesEstimate {
+    double value = 0.0;
+    double error = 0.0;     // Difference between the last two transforms
+    SeriesAcceleration method = SeriesAcceleration::NONE;
+    int termsUsed = 0;
+    bool diverges = false;  // The terms show Σ has no finite value (value is NaN)
+};
+
+// Neumaier's compensated summation: the running sum plus the rounding error
+// lost by each addition, so long sums of mixed-sign or decreasing terms keep
+// full precision
+struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+    
+    void add(double x) {
+        double t = sum + x;
+        if (std::abs(sum) >= std::abs(x)) {
+            compensation += (sum - t) + x;
+        } else {
+            compensation += (x - t) + sum;
+        }
+        sum = t;
+    }
+    
+    void add(const CompensatedSum& other) {
+        add(other.sum);
+        compensation += other.compensation;
+    }
+    
+    double value() const { return sum + compensation; }
+};
+
 class SequencesSeriesCalculator {
 private:
     std::vector<SequenceStep> steps;
     
     double evaluateNthTerm(const ASTNode* formula, int n);
-    
+
 public:
     // Arithmetic sequence: a, a+d, a+2d, ...
     void analyzeArithmetic(double a, double d, int n);
@@ -33,9 +80,27 @@ public:
     // General sequence analysis
     void analyzeSequence(const ASTNode* formula, int numTerms);
     
-    // Series sum
+    // Series sum, with accelerated estimates of the infinite sum
     void computeSeriesSum(const ASTNode* formula, int numTerms);
     
+    // Σ aₙ for n = 1..numTerms by brute force over many threads
+    void computeLargeSeriesSum(const ASTNode* formula, uint64_t numTerms);
+    
+    // The sum itself. The index range is cut into fixed blocks that threads
+    // evaluate with a compiled ExpressionProgram a batch at a time; batches
+    // are summed pairwise and accumulated with Neumaier compensation. Block
+    // sums are combined in index order, so the result is the same for any
+    // number of threads.
+    static CompensatedSum sumTerms(const ASTNode* formula, uint64_t numTerms);
+    
+    // Estimate Σ terms[i] (to infinity) from the given leading terms a₁, a₂, ...
+    static SeriesEstimate accelerateSeries(const std::vector<double>& terms, SeriesAcceleration method);
+    // Runs every method and keeps the one with the smallest error estimate.
+    // Divergent series give NaN with an infinite error instead, as do ones
+    // with aₙ₊₁/aₙ → 1 whose terms decay slower than about n^-1.1 or whose
+    // Richardson and Levin u estimates disagree.
+    static SeriesEstimate sumSeries(const std::vector<double>& terms);
+    
     // Convergence tests
     void ratioTest(const ASTNode* formula);
     void rootTest(const ASTNode* formula);
@@ -24,13 +24,45 @@ double Simplifier::getNumericValue(const ASTNode* node, bool& isNumeric) {
 }
 
 std::unique_ptr<ASTNode> Simplifier::simplify(std::unique_ptr<ASTNode> node) {
+    // Post-order walk over the owning slots with an explicit stack: children are
+    // rewritten in place before their parent, without recursing per level
+    struct Frame {
+        std::unique_ptr<ASTNode>* slot;
+        bool childrenDone;
+    };
+    
+    std::unique_ptr<ASTNode> root = std::move(node);
+    std::vector<Frame> stack;
+    stack.push_back({&root, false});
+    
+    while (!stack.empty()) {
+        Frame frame = stack.back();
+        ASTNode* current = frame.slot->get();
+        
+        if (!frame.childrenDone) {
+            stack.back().childrenDone = true;
+            if (current->type == NodeType::BINARY_OP) {
+                auto binOp = static_cast<BinaryOpNode*>(current);
+                stack.push_back({&binOp->right, false});
+                stack.push_back({&binOp->left, false});
+            } else if (current->type == NodeType::UNARY_FUNC) {
+                auto funcNode = static_cast<UnaryFuncNode*>(current);
+                stack.push_back({&funcNode->arg, false});
+            }
+            continue;
+        }
+        
+        stack.pop_back();
+        *frame.slot = simplifyNode(std::move(*frame.slot));
+    }
+    
+    return root;
+}
+
+std::unique_ptr<ASTNode> Simplifier::simplifyNode(std::unique_ptr<ASTNode> node) {
     if (node->type == NodeType::BINARY_OP) {
         auto binOp = static_cast<BinaryOpNode*>(node.get());
         
-        // Recursively simplify children
-        binOp->left = simplify(std::move(binOp->left));
-        binOp->right = simplify(std::move(binOp->right));
-        
         switch (binOp->op) {
             case BinaryOp::ADD:
                 // 0 + x = x
@@ -149,10 +181,6 @@ std::unique_ptr<ASTNode> Simplifier::simplify(std::unique_ptr<ASTNode> node) {
                 break;
         }
     }
-    else if (node->type == NodeType::UNARY_FUNC) {
-        auto funcNode = static_cast<UnaryFuncNode*>(node.get());
-        funcNode->arg = simplify(std::move(funcNode->arg));
-    }
     
     return node;
 }
@@ -9,4 +9,7 @@ private:
     static bool isZero(const ASTNode* node);
     static bool isOne(const ASTNode* node);
     static double getNumericValue(const ASTNode* node, bool& isNumeric);
+    
+    // Applies the local rewrite rules to a node whose children are already simplified
+    static std::unique_ptr<ASTNode> simplifyNode(std::unique_ptr<ASTNode> node);
 };
@@ -0,0 +1,136 @@
+#include "sparse_matrix.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Products with fewer nonzeros than this stay on the calling thread; below it
+// the thread start-up costs more than the memory-bound loop it would split
+static const size_t kParallelNonZeros = size_t(1) << 18;
+
+SparseMatrix SparseMatrix::fromEntries(size_t rows, size_t cols, std::vector<SparseEntry> entries) {
+    for (const SparseEntry& entry : entries) {
+        if (entry.row >= rows || entry.col >= cols) {
+            throw std::out_of_range("Sparse entry outside the matrix dimensions");
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const SparseEntry& a, const SparseEntry& b) {
+        return a.row != b.row ? a.row < b.row : a.col < b.col;
+    });
+    
+    SparseMatrix result;
+    result.rowCount = rows;
+    result.colCount = cols;
+    result.rowStart.assign(rows + 1, 0);
+    result.columnIndex.reserve(entries.size());
+    result.values.reserve(entries.size());
+    
+    size_t i = 0;
+    while (i < entries.size()) {
+        size_t row = entries[i].row;
+        size_t col = entries[i].col;
+        double sum = 0.0;
+        for (; i < entries.size() && entries[i].row == row && entries[i].col == col; i++) {
+            sum += entries[i].value;
+        }
+        if (sum != 0.0) {
+            result.columnIndex.push_back(col);
+            result.values.push_back(sum);
+            result.rowStart[row + 1]++;
+        }
+    }
+    for (size_t r = 0; r < rows; r++) {
+        result.rowStart[r + 1] += result.rowStart[r];
+    }
+    return result;
+}
+
+SparseMatrix SparseMatrix::fromDense(const Matrix& A, double dropTolerance) {
+    SparseMatrix result;
+    result.rowCount = A.rows;
+    result.colCount = A.cols;
+    result.rowStart.assign(A.rows + 1, 0);
+    for (int i = 0; i < A.rows; i++) {
+        for (int j = 0; j < A.cols; j++) {
+            double value = A.data[i][j];
+            if (value != 0.0 && std::abs(value) > dropTolerance) {
+                result.columnIndex.push_back(j);
+                result.values.push_back(value);
+            }
+        }
+        result.rowStart[i + 1] = result.values.size();
+    }
+    return result;
+}
+
+double SparseMatrix::get(size_t row, size_t col) const {
+    if (row >= rowCount || col >= colCount) {
+        throw std::out_of_range("Sparse matrix index out of bounds");
+    }
+    auto begin = columnIndex.begin() + rowStart[row];
+    auto end = columnIndex.begin() + rowStart[row + 1];
+    auto it = std::lower_bound(begin, end, col);
+    return (it != end && *it == col) ? values[it - columnIndex.begin()] : 0.0;
+}
+
+std::vector<double> SparseMatrix::diagonal() const {
+    std::vector<double> result(std::min(rowCount, colCount), 0.0);
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = get(i, i);
+    }
+    return result;
+}
+
+void SparseMatrix::multiply(const double* x, double* y) const {
+    size_t chunks = nonZeros() >= kParallelNonZeros ? parallelChunkCount(rowCount, 1024) : 1;
+    parallelChunks(rowCount, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            double sum = 0.0;
+            for (size_t k = rowStart[i]; k < rowStart[i + 1]; k++) {
+                sum += values[k] * x[columnIndex[k]];
+            }
+            y[i] = sum;
+        }
+    });
+}
+
+std::vector<double> SparseMatrix::multiply(const std::vector<double>& x) const {
+    if (x.size() != colCount) {
+        throw std::invalid_argument("Vector length must match the number of columns");
+    }
+    std::vector<double> y(rowCount);
+    multiply(x.data(), y.data());
+    return y;
+}
+
+Matrix SparseMatrix::multiply(const Matrix& B) const {
+    if (static_cast<size_t>(B.rows) != colCount) {
+        throw std::invalid_argument("Cannot multiply: columns of A must equal rows of B");
+    }
+    Matrix C(static_cast<int>(rowCount), B.cols);
+    const size_t width = B.cols;
+    size_t chunks = nonZeros() * width >= kParallelNonZeros ? parallelChunkCount(rowCount, 64) : 1;
+    parallelChunks(rowCount, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            double* out = C.data[i].data();
+            for (size_t k = rowStart[i]; k < rowStart[i + 1]; k++) {
+                double a = values[k];
+                const double* in = B.data[columnIndex[k]].data();
+                for (size_t j = 0; j < width; j++) {
+                    out[j] += a * in[j];
+                }
+            }
+        }
+    });
+    return C;
+}
+
+Matrix SparseMatrix::toDense() const {
+    Matrix result(static_cast<int>(rowCount), static_cast<int>(colCount));
+    for (size_t i = 0; i < rowCount; i++) {
+        for (size_t k = rowStart[i]; k < rowStart[i + 1]; k++) {
+            result.data[i][columnIndex[k]] = values[k];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "matrix_operations.h"
+
+struct SparseEntry {
+    size_t row;
+    size_t col;
+    double value;
+};
+
+// Compressed sparse row matrix: the nonzeros of row i are
+// values[rowStart[i] .. rowStart[i+1]) at columns columnIndex[...], sorted by
+// column with no duplicates. Storage and every product are O(nonzeros), so a
+// discretized model with a few entries per row never pays for n².
+class SparseMatrix {
+private:
+    size_t rowCount = 0;
+    size_t colCount = 0;
+    std::vector<size_t> rowStart;      // rowCount + 1 offsets
+    std::vector<size_t> columnIndex;
+    std::vector<double> values;
+
+public:
+    SparseMatrix() : rowStart(1, 0) {}
+    
+    // Entries may come in any order; duplicates are summed and explicit zeros
+    // dropped. Throws std::out_of_range for an entry outside the dimensions.
+    static SparseMatrix fromEntries(size_t rows, size_t cols, std::vector<SparseEntry> entries);
+    static SparseMatrix fromDense(const Matrix& A, double dropTolerance = 0.0);
+    
+    size_t rows() const { return rowCount; }
+    size_t cols() const { return colCount; }
+    size_t nonZeros() const { return values.size(); }
+    
+    const std::vector<size_t>& getRowStart() const { return rowStart; }
+    const std::vector<size_t>& getColumnIndex() const { return columnIndex; }
+    const std::vector<double>& getValues() const { return values; }
+    
+    double get(size_t row, size_t col) const;   // Binary search within the row
+    std::vector<double> diagonal() const;
+    
+    // y = A·x. Rows are split across threads once the matrix is large enough
+    // to pay for them. x must hold cols() values and y rows().
+    void multiply(const double* x, double* y) const;
+    std::vector<double> multiply(const std::vector<double>& x) const;
+    
+    // C = A·B for dense B, accumulating whole rows of B per nonzero
+    Matrix multiply(const Matrix& B) const;
+    
+    Matrix toDense() const;
+};
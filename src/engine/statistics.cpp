@@ -1,7 +1,7 @@
 #include "statistics.h"
+#include "distributions.h"
 #include <algorithm>
 #include <cmath>
-#include <numeric>
 #include <sstream>
 #include <iomanip>
 
@@ -9,33 +9,7 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-double StatisticsCalculator::mean(const std::vector<double>& data) {
-    return std::accumulate(data.begin(), data.end(), 0.0) / data.size();
-}
-
-double StatisticsCalculator::median(std::vector<double> data) {
-    std::sort(data.begin(), data.end());
-    size_t n = data.size();
-    if (n % 2 == 0) {
-        return (data[n/2 - 1] + data[n/2]) / 2.0;
-    } else {
-        return data[n/2];
-    }
-}
-
-double StatisticsCalculator::variance(const std::vector<double>& data, double mean) {
-    double sum = 0.0;
-    for (double x : data) {
-        sum += (x - mean) * (x - mean);
-    }
-    return sum / data.size();
-}
-
-double StatisticsCalculator::standardDeviation(const std::vector<double>& data, double mean) {
-    return std::sqrt(variance(data, mean));
-}
-
-void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
+void StatisticsCalculator::analyzeDataSet(DoubleSpan data) {
     steps.clear();
     
     StatisticsStep step1;
@@ -56,8 +30,12 @@ void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
     step2.expression = oss2.str();
     steps.push_back(step2);
     
+    // Mean, spread and shape all come from one pass over the data
+    RunningStatistics moments;
+    moments.add(data.data(), data.size());
+    
     // Mean
-    double m = mean(data);
+    double m = moments.mean();
     StatisticsStep step3;
     step3.description = "--- Mean (Average) ---";
     std::ostringstream oss3;
@@ -66,8 +44,13 @@ void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
     step3.expression = oss3.str();
     steps.push_back(step3);
     
+    // Median and quartiles come from one multi-rank selection (no sort)
+    size_t n = data.size();
+    std::vector<double> ranked = order_statistics::selectRanks(
+        data.data(), n, {n > 0 ? (n - 1) / 2 : 0, n / 2, n / 4, 3 * n / 4});
+    
     // Median
-    double med = median(data);
+    double med = (n % 2 == 0) ? (ranked[0] + ranked[1]) / 2.0 : ranked[1];
     StatisticsStep step4;
     step4.description = "--- Median (Middle Value) ---";
     std::ostringstream oss4;
@@ -80,8 +63,8 @@ void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
     // Skip for now, would need frequency counting
     
     // Range
-    double minVal = *std::min_element(data.begin(), data.end());
-    double maxVal = *std::max_element(data.begin(), data.end());
+    double minVal = moments.min();
+    double maxVal = moments.max();
     double range = maxVal - minVal;
     
     StatisticsStep step5;
@@ -94,7 +77,7 @@ void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
     steps.push_back(step5);
     
     // Variance
-    double var = variance(data, m);
+    double var = moments.variance();
     StatisticsStep step6;
     step6.description = "--- Variance ---";
     std::ostringstream oss6;
@@ -104,7 +87,7 @@ void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
     steps.push_back(step6);
     
     // Standard Deviation
-    double sd = standardDeviation(data, m);
+    double sd = moments.standardDeviation();
     StatisticsStep step7;
     step7.description = "--- Standard Deviation ---";
     std::ostringstream oss7;
@@ -113,16 +96,22 @@ void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
     step7.expression = oss7.str();
     steps.push_back(step7);
     
-    // Quartiles
-    std::vector<double> sortedData = data;
-    std::sort(sortedData.begin(), sortedData.end());
+    // Shape
+    StatisticsStep shape;
+    shape.description = "--- Shape ---";
+    std::ostringstream ossShape;
+    ossShape << std::fixed << std::setprecision(4);
+    ossShape << "Skewness g₁ = " << moments.skewness() << "\n";
+    ossShape << "Excess kurtosis g₂ = " << moments.kurtosis();
+    shape.expression = ossShape.str();
+    steps.push_back(shape);
     
-    size_t n = sortedData.size();
+    // Quartiles
     double q1, q3;
     
     if (n >= 4) {
-        q1 = sortedData[n/4];
-        q3 = sortedData[3*n/4];
+        q1 = ranked[2];
+        q3 = ranked[3];
         double iqr = q3 - q1;
         
         StatisticsStep step8;
@@ -145,6 +134,59 @@ void StatisticsCalculator::analyzeDataSet(const std::vector<double>& data) {
     steps.push_back(summary);
 }
 
+void StatisticsCalculator::analyzeStream(StreamingStatistics& stream) {
+    steps.clear();
+    const RunningStatistics& moments = stream.getMoments();
+    
+    StatisticsStep header;
+    header.description = "=== Streaming Statistics ===";
+    std::ostringstream ossHeader;
+    ossHeader << "Values seen: n = " << moments.count();
+    header.expression = ossHeader.str();
+    steps.push_back(header);
+    
+    if (moments.count() == 0) {
+        StatisticsStep empty;
+        empty.description = "No data";
+        empty.expression = "";
+        steps.push_back(empty);
+        return;
+    }
+    
+    StatisticsStep center;
+    center.description = "--- Moments (single pass) ---";
+    std::ostringstream ossCenter;
+    ossCenter << std::fixed << std::setprecision(4);
+    ossCenter << "x̄ = " << moments.mean() << ", σ² = " << moments.variance()
+              << ", σ = " << moments.standardDeviation() << "\n";
+    ossCenter << "Skewness g₁ = " << moments.skewness()
+              << ", excess kurtosis g₂ = " << moments.kurtosis();
+    center.expression = ossCenter.str();
+    steps.push_back(center);
+    
+    StatisticsStep range;
+    range.description = "--- Range ---";
+    std::ostringstream ossRange;
+    ossRange << std::fixed << std::setprecision(4);
+    ossRange << "Min = " << moments.min() << ", Max = " << moments.max() << "\n";
+    ossRange << "Range = " << (moments.max() - moments.min());
+    range.expression = ossRange.str();
+    steps.push_back(range);
+    
+    double q1 = stream.quantile(0.25);
+    double med = stream.median();
+    double q3 = stream.quantile(0.75);
+    
+    StatisticsStep quantiles;
+    quantiles.description = "--- Quantiles (t-digest estimate) ---";
+    std::ostringstream ossQuantiles;
+    ossQuantiles << std::fixed << std::setprecision(4);
+    ossQuantiles << "Q1 ≈ " << q1 << ", Median ≈ " << med << ", Q3 ≈ " << q3 << "\n";
+    ossQuantiles << "P1 ≈ " << stream.quantile(0.01) << ", P99 ≈ " << stream.quantile(0.99);
+    quantiles.expression = ossQuantiles.str();
+    steps.push_back(quantiles);
+}
+
 void StatisticsCalculator::normalDistribution(double x, double mu, double sigma) {
     steps.clear();
     
@@ -166,9 +208,8 @@ void StatisticsCalculator::normalDistribution(double x, double mu, double sigma)
     step3.expression = "";
     steps.push_back(step3);
     
-    double exponent = -(x - mu) * (x - mu) / (2 * sigma * sigma);
-    double coefficient = 1.0 / (sigma * std::sqrt(2 * M_PI));
-    double pdf = coefficient * std::exp(exponent);
+    double pdf;
+    distributions::normalPdf(&x, &pdf, 1, mu, sigma);
     
     StatisticsStep step4;
     step4.description = "Result:";
@@ -178,6 +219,17 @@ void StatisticsCalculator::normalDistribution(double x, double mu, double sigma)
     step4.expression = oss4.str();
     steps.push_back(step4);
     
+    double cdf;
+    distributions::normalCdf(&x, &cdf, 1, mu, sigma);
+    
+    StatisticsStep cdfStep;
+    cdfStep.description = "Cumulative probability:";
+    std::ostringstream ossCdf;
+    ossCdf << std::fixed << std::setprecision(6);
+    ossCdf << "P(X ≤ " << x << ") = Φ((x-μ)/σ) = " << cdf;
+    cdfStep.expression = ossCdf.str();
+    steps.push_back(cdfStep);
+    
     // Z-score
     double z = (x - mu) / sigma;
     StatisticsStep step5;
@@ -217,11 +269,15 @@ void StatisticsCalculator::binomialProbability(int n, int k, double p) {
     step3.expression = "P(X=k) = C(n,k) × p^k × (1-p)^(n-k)";
     steps.push_back(step3);
     
-    // Compute binomial coefficient C(n,k)
-    long long binomCoeff = 1;
-    for (int i = 0; i < k; i++) {
-        binomCoeff = binomCoeff * (n - i) / (i + 1);
+    // Binomial coefficient C(n,k) via lgamma, so large n cannot overflow
+    double logCoeff = distributions::logChoose(n, k);
+    std::ostringstream coeffOss;
+    if (logCoeff < std::log(1e15)) {
+        coeffOss << std::llround(std::exp(logCoeff));
+    } else {
+        coeffOss << std::scientific << std::setprecision(6) << std::exp(logCoeff);
     }
+    std::string binomCoeff = coeffOss.str();
     
     StatisticsStep step4;
     step4.description = "Binomial coefficient:";
@@ -230,10 +286,12 @@ void StatisticsCalculator::binomialProbability(int n, int k, double p) {
     step4.expression = oss4.str();
     steps.push_back(step4);
     
-    double probability = binomCoeff * std::pow(p, k) * std::pow(1-p, n-k);
+    double kValue = k;
+    double probability;
+    distributions::binomialPmf(&kValue, &probability, 1, n, p);
     
     StatisticsStep step5;
-    step5.description = "Computing:";
+    step5.description = "Computing (in log space):";
     std::ostringstream oss5;
     oss5 << std::fixed << std::setprecision(6);
     oss5 << binomCoeff << " × " << p << "^" << k << " × " << (1-p) << "^" << (n-k);
@@ -248,6 +306,17 @@ void StatisticsCalculator::binomialProbability(int n, int k, double p) {
     finalStep.expression = oss6.str();
     steps.push_back(finalStep);
     
+    double cumulative;
+    distributions::binomialCdf(&kValue, &cumulative, 1, n, p);
+    
+    StatisticsStep cdfStep;
+    cdfStep.description = "Cumulative probability:";
+    std::ostringstream ossCdf;
+    ossCdf << std::fixed << std::setprecision(6);
+    ossCdf << "P(X ≤ " << k << ") = " << cumulative;
+    cdfStep.expression = ossCdf.str();
+    steps.push_back(cdfStep);
+    
     // Mean and variance
     double meanBinom = n * p;
     double varBinom = n * p * (1 - p);
@@ -283,19 +352,25 @@ void StatisticsCalculator::poissonProbability(int k, double lambda) {
     step3.expression = "P(X=k) = (λ^k × e^(-λ)) / k!";
     steps.push_back(step3);
     
-    // Compute k!
-    long long factorial = 1;
-    for (int i = 2; i <= k; i++) {
-        factorial *= i;
+    // k! only for display; the probability is exp(k·ln λ - λ - ln k!) so it
+    // stays finite long after k! overflows (k > 20 for 64-bit integers)
+    double logFactorial = std::lgamma(k + 1.0);
+    std::ostringstream factorialOss;
+    if (k <= 20) {
+        factorialOss << std::llround(std::exp(logFactorial));
+    } else {
+        factorialOss << std::scientific << std::setprecision(6) << std::exp(logFactorial);
     }
     
-    double probability = (std::pow(lambda, k) * std::exp(-lambda)) / factorial;
+    double kValue = k;
+    double probability;
+    distributions::poissonPmf(&kValue, &probability, 1, lambda);
     
     StatisticsStep step4;
-    step4.description = "Computing:";
+    step4.description = "Computing (in log space):";
     std::ostringstream oss4;
     oss4 << std::fixed << std::setprecision(6);
-    oss4 << "(" << lambda << "^" << k << " × e^(-" << lambda << ")) / " << factorial;
+    oss4 << "(" << lambda << "^" << k << " × e^(-" << lambda << ")) / " << factorialOss.str();
     step4.expression = oss4.str();
     steps.push_back(step4);
     
@@ -307,6 +382,17 @@ void StatisticsCalculator::poissonProbability(int k, double lambda) {
     finalStep.expression = oss5.str();
     steps.push_back(finalStep);
     
+    double cumulative;
+    distributions::poissonCdf(&kValue, &cumulative, 1, lambda);
+    
+    StatisticsStep cdfStep;
+    cdfStep.description = "Cumulative probability:";
+    std::ostringstream ossCdf;
+    ossCdf << std::fixed << std::setprecision(6);
+    ossCdf << "P(X ≤ " << k << ") = " << cumulative;
+    cdfStep.expression = ossCdf.str();
+    steps.push_back(cdfStep);
+    
     StatisticsStep step5;
     step5.description = "Distribution properties:";
     std::ostringstream oss6;
@@ -317,7 +403,7 @@ void StatisticsCalculator::poissonProbability(int k, double lambda) {
     steps.push_back(step5);
 }
 
-void StatisticsCalculator::linearRegression(const std::vector<double>& x, const std::vector<double>& y) {
+void StatisticsCalculator::linearRegression(DoubleSpan x, DoubleSpan y) {
     steps.clear();
     
     if (x.size() != y.size() || x.empty()) {
@@ -340,19 +426,10 @@ void StatisticsCalculator::linearRegression(const std::vector<double>& x, const
     step2.expression = "";
     steps.push_back(step2);
     
-    double meanX = mean(x);
-    double meanY = mean(y);
-    
-    double numerator = 0.0;
-    double denominator = 0.0;
-    
-    for (size_t i = 0; i < x.size(); i++) {
-        numerator += (x[i] - meanX) * (y[i] - meanY);
-        denominator += (x[i] - meanX) * (x[i] - meanX);
-    }
-    
-    double slope = numerator / denominator;
-    double intercept = meanY - slope * meanX;
+    // One parallel pass over both columns for the means and co-moments
+    BivariateStatistics pairs = BivariateStatistics::fromData(x.data(), y.data(), x.size());
+    double slope = pairs.slope();
+    double intercept = pairs.intercept();
     
     StatisticsStep step3;
     step3.description = "Computing slope:";
@@ -378,3 +455,65 @@ void StatisticsCalculator::linearRegression(const std::vector<double>& x, const
     finalStep.expression = oss5.str();
     steps.push_back(finalStep);
 }
+
+void StatisticsCalculator::correlation(DoubleSpan x, DoubleSpan y) {
+    steps.clear();
+    
+    if (x.size() != y.size() || x.size() < 2) {
+        StatisticsStep errorStep;
+        errorStep.description = "Error: Invalid data";
+        errorStep.expression = "x and y must have same size (at least 2 points)";
+        steps.push_back(errorStep);
+        return;
+    }
+    
+    StatisticsStep step1;
+    step1.description = "=== Correlation ===";
+    std::ostringstream oss1;
+    oss1 << "Data points: n = " << x.size();
+    step1.expression = oss1.str();
+    steps.push_back(step1);
+    
+    BivariateStatistics pairs = BivariateStatistics::fromData(x.data(), y.data(), x.size());
+    
+    StatisticsStep step2;
+    step2.description = "Sums of squares and cross products:";
+    std::ostringstream oss2;
+    oss2 << std::fixed << std::setprecision(4);
+    oss2 << "Sxx = " << pairs.getSxx() << ", Syy = " << pairs.getSyy() << ", Sxy = " << pairs.getSxy();
+    step2.expression = oss2.str();
+    steps.push_back(step2);
+    
+    StatisticsStep step3;
+    step3.description = "Covariance:";
+    std::ostringstream oss3;
+    oss3 << std::fixed << std::setprecision(4);
+    oss3 << "cov(x,y) = Sxy/n = " << pairs.covariance();
+    step3.expression = oss3.str();
+    steps.push_back(step3);
+    
+    double r = pairs.correlation();
+    if (std::isnan(r)) {
+        StatisticsStep undefinedStep;
+        undefinedStep.description = "Correlation undefined:";
+        undefinedStep.expression = "x or y has zero variance";
+        steps.push_back(undefinedStep);
+        return;
+    }
+    
+    StatisticsStep finalStep;
+    finalStep.description = "=== Pearson Correlation ===";
+    std::ostringstream oss4;
+    oss4 << std::fixed << std::setprecision(4);
+    oss4 << "r = Sxy / √(Sxx × Syy) = " << r << "\n";
+    oss4 << "r² = " << r * r;
+    finalStep.expression = oss4.str();
+    steps.push_back(finalStep);
+    
+    StatisticsStep step5;
+    step5.description = "Interpretation:";
+    double strength = std::abs(r);
+    std::string label = strength >= 0.8 ? "strong" : (strength >= 0.5 ? "moderate" : (strength >= 0.2 ? "weak" : "negligible"));
+    step5.expression = label + (r >= 0 ? " positive" : " negative") + " linear relationship";
+    steps.push_back(step5);
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
 #include <string>
+#include "streaming_statistics.h"
+#include "order_statistics.h"
+#include "double_span.h"
 
 struct StatisticsStep {
     std::string description;
@@ -11,14 +14,14 @@ class StatisticsCalculator {
 private:
     std::vector<StatisticsStep> steps;
     
-    double mean(const std::vector<double>& data);
-    double median(std::vector<double> data); // pass by value to sort
-    double variance(const std::vector<double>& data, double mean);
-    double standardDeviation(const std::vector<double>& data, double mean);
-    
 public:
-    // Descriptive statistics
-    void analyzeDataSet(const std::vector<double>& data);
+    // Descriptive statistics. Spans accept vectors as well as columns
+    // from ColumnLoader, which are analyzed in place without copying.
+    void analyzeDataSet(DoubleSpan data);
+    
+    // Summary of a column accumulated incrementally (constant memory);
+    // quartiles are t-digest estimates rather than exact order statistics
+    void analyzeStream(StreamingStatistics& stream);
     
     // Probability distributions
     void normalDistribution(double x, double mu, double sigma);
@@ -26,8 +29,8 @@ public:
     void poissonProbability(int k, double lambda);
     
     // Correlation and regression
-    void linearRegression(const std::vector<double>& x, const std::vector<double>& y);
-    void correlation(const std::vector<double>& x, const std::vector<double>& y);
+    void linearRegression(DoubleSpan x, DoubleSpan y);
+    void correlation(DoubleSpan x, DoubleSpan y);
     
     const std::vector<StatisticsStep>& getSteps() const { return steps; }
     void clearSteps() { steps.clear(); }
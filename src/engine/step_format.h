@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+// Formatting shared by the step lists of the numerical engines
+
+// Rows shown in a table of numerical values
+static const size_t kTableRows = 11;
+
+// Ten significant digits, without trailing zeros
+inline std::string formatNumber(double value) {
+    std::ostringstream oss;
+    oss << std::setprecision(10) << value;
+    return oss.str();
+}
+
+// Up to kTableRows lines, one per point spread evenly over [0, points) with
+// the first and last included; row(i) formats point i
+template <typename Row>
+std::string valueTable(size_t points, Row row) {
+    std::string table;
+    const size_t rows = std::min(points, kTableRows);
+    for (size_t r = 0; r < rows; r++) {
+        size_t i = rows > 1 ? r * (points - 1) / (rows - 1) : 0;
+        if (r > 0) table += "\n";
+        table += row(i);
+    }
+    return table;
+}
@@ -0,0 +1,319 @@
+#include "streaming_statistics.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+void RunningStatistics::add(double x) {
+    if (std::isnan(x)) return;
+    
+    if (n == 0) {
+        minValue = x;
+        maxValue = x;
+    } else {
+        minValue = std::min(minValue, x);
+        maxValue = std::max(maxValue, x);
+    }
+    
+    double n1 = static_cast<double>(n);
+    n++;
+    double nd = static_cast<double>(n);
+    double delta = x - meanValue;
+    double deltaN = delta / nd;
+    double deltaN2 = deltaN * deltaN;
+    double term1 = delta * deltaN * n1;
+    
+    // Higher moments first: each update uses the previous lower moments
+    meanValue += deltaN;
+    m4 += term1 * deltaN2 * (nd * nd - 3 * nd + 3) + 6 * deltaN2 * m2 - 4 * deltaN * m3;
+    m3 += term1 * deltaN * (nd - 2) - 3 * deltaN * m2;
+    m2 += term1;
+}
+
+void RunningStatistics::add(const double* data, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        add(data[i]);
+    }
+}
+
+void RunningStatistics::merge(const RunningStatistics& other) {
+    if (other.n == 0) return;
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+    
+    double na = static_cast<double>(n);
+    double nb = static_cast<double>(other.n);
+    double nt = na + nb;
+    double delta = other.meanValue - meanValue;
+    double delta2 = delta * delta;
+    double delta3 = delta2 * delta;
+    double delta4 = delta2 * delta2;
+    
+    double combinedM2 = m2 + other.m2 + delta2 * na * nb / nt;
+    double combinedM3 = m3 + other.m3
+        + delta3 * na * nb * (na - nb) / (nt * nt)
+        + 3 * delta * (na * other.m2 - nb * m2) / nt;
+    double combinedM4 = m4 + other.m4
+        + delta4 * na * nb * (na * na - na * nb + nb * nb) / (nt * nt * nt)
+        + 6 * delta2 * (na * na * other.m2 + nb * nb * m2) / (nt * nt)
+        + 4 * delta * (na * other.m3 - nb * m3) / nt;
+    
+    meanValue += delta * nb / nt;
+    m2 = combinedM2;
+    m3 = combinedM3;
+    m4 = combinedM4;
+    n += other.n;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+double RunningStatistics::variance() const {
+    return n > 0 ? m2 / n : 0.0;
+}
+
+double RunningStatistics::sampleVariance() const {
+    return n > 1 ? m2 / (n - 1) : 0.0;
+}
+
+double RunningStatistics::standardDeviation() const {
+    return std::sqrt(variance());
+}
+
+double RunningStatistics::skewness() const {
+    if (n < 2 || m2 == 0.0) return 0.0;
+    return std::sqrt(static_cast<double>(n)) * m3 / std::pow(m2, 1.5);
+}
+
+double RunningStatistics::kurtosis() const {
+    if (n < 2 || m2 == 0.0) return 0.0;
+    return static_cast<double>(n) * m4 / (m2 * m2) - 3.0;
+}
+
+void BivariateStatistics::add(double x, double y) {
+    n++;
+    double nd = static_cast<double>(n);
+    double dx = x - meanX;
+    double dy = y - meanY;
+    meanX += dx / nd;
+    meanY += dy / nd;
+    
+    // Old deviation of one variable times new deviation of the other
+    sxx += dx * (x - meanX);
+    syy += dy * (y - meanY);
+    sxy += dx * (y - meanY);
+}
+
+void BivariateStatistics::add(const double* x, const double* y, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        add(x[i], y[i]);
+    }
+}
+
+void BivariateStatistics::merge(const BivariateStatistics& other) {
+    if (other.n == 0) return;
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+    
+    double na = static_cast<double>(n);
+    double nb = static_cast<double>(other.n);
+    double nt = na + nb;
+    double dx = other.meanX - meanX;
+    double dy = other.meanY - meanY;
+    
+    sxx += other.sxx + dx * dx * na * nb / nt;
+    syy += other.syy + dy * dy * na * nb / nt;
+    sxy += other.sxy + dx * dy * na * nb / nt;
+    meanX += dx * nb / nt;
+    meanY += dy * nb / nt;
+    n += other.n;
+}
+
+BivariateStatistics BivariateStatistics::fromData(const double* x, const double* y, size_t count) {
+    size_t chunks = parallelChunkCount(count, 1 << 16);
+    std::vector<BivariateStatistics> partials(chunks);
+    
+    parallelChunks(count, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        partials[chunk].add(x + begin, y + begin, end - begin);
+    });
+    
+    BivariateStatistics result = partials[0];
+    for (size_t i = 1; i < partials.size(); i++) {
+        result.merge(partials[i]);
+    }
+    return result;
+}
+
+double BivariateStatistics::correlation() const {
+    if (sxx <= 0.0 || syy <= 0.0) return std::numeric_limits<double>::quiet_NaN();
+    return sxy / std::sqrt(sxx * syy);
+}
+
+TDigest::TDigest(double compression) : compression(std::max(20.0, compression)) {}
+
+// k₁ scale function: centroids near q = 0 and q = 1 stay small
+static double scaleK(double q, double compression) {
+    return compression / (2 * M_PI) * std::asin(2 * q - 1);
+}
+
+static double scaleKInverse(double k, double compression) {
+    return (std::sin(k * 2 * M_PI / compression) + 1) / 2;
+}
+
+void TDigest::add(double x, double weight) {
+    if (weight <= 0.0 || std::isnan(x)) return;
+    
+    if (totalWeight == 0.0) {
+        minValue = x;
+        maxValue = x;
+    } else {
+        minValue = std::min(minValue, x);
+        maxValue = std::max(maxValue, x);
+    }
+    
+    buffer.push_back({x, weight});
+    totalWeight += weight;
+    
+    if (buffer.size() >= static_cast<size_t>(5 * compression)) {
+        compress();
+    }
+}
+
+void TDigest::compress() {
+    if (buffer.empty()) return;
+    
+    buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+    std::sort(buffer.begin(), buffer.end(), [](const Centroid& a, const Centroid& b) {
+        return a.mean < b.mean;
+    });
+    
+    centroids.clear();
+    Centroid current = buffer[0];
+    double weightSoFar = 0.0;
+    double weightLimit = totalWeight * scaleKInverse(scaleK(0.0, compression) + 1, compression);
+    
+    for (size_t i = 1; i < buffer.size(); i++) {
+        const Centroid& next = buffer[i];
+        if (weightSoFar + current.weight + next.weight <= weightLimit) {
+            // Fold into the current centroid (weighted running mean)
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            centroids.push_back(current);
+            double q = weightSoFar / totalWeight;
+            weightLimit = totalWeight * scaleKInverse(scaleK(q, compression) + 1, compression);
+            current = next;
+        }
+    }
+    centroids.push_back(current);
+    buffer.clear();
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.totalWeight == 0.0) return;
+    
+    if (totalWeight == 0.0) {
+        minValue = other.minValue;
+        maxValue = other.maxValue;
+    } else {
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+    
+    buffer.insert(buffer.end(), other.centroids.begin(), other.centroids.end());
+    buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    totalWeight += other.totalWeight;
+    compress();
+}
+
+void TDigest::reset() {
+    centroids.clear();
+    buffer.clear();
+    totalWeight = 0.0;
+    minValue = 0.0;
+    maxValue = 0.0;
+}
+
+size_t TDigest::centroidCount() {
+    compress();
+    return centroids.size();
+}
+
+double TDigest::quantile(double q) {
+    compress();
+    if (centroids.empty()) return std::numeric_limits<double>::quiet_NaN();
+    if (centroids.size() == 1) return centroids[0].mean;
+    
+    q = std::max(0.0, std::min(1.0, q));
+    double index = q * totalWeight;
+    
+    // Left tail: between the minimum and the first centroid's center
+    const Centroid& first = centroids.front();
+    if (index < first.weight / 2) {
+        if (first.weight <= 1.0) return minValue;
+        return minValue + (first.mean - minValue) * index / (first.weight / 2);
+    }
+    
+    // Interior: interpolate between neighbouring centroid centers
+    double center = first.weight / 2;
+    for (size_t i = 0; i + 1 < centroids.size(); i++) {
+        double gap = (centroids[i].weight + centroids[i + 1].weight) / 2;
+        if (index < center + gap) {
+            double t = (index - center) / gap;
+            return centroids[i].mean + t * (centroids[i + 1].mean - centroids[i].mean);
+        }
+        center += gap;
+    }
+    
+    // Right tail: between the last centroid's center and the maximum
+    const Centroid& last = centroids.back();
+    if (last.weight <= 1.0) return maxValue;
+    double t = std::min(1.0, (index - center) / (last.weight / 2));
+    return last.mean + t * (maxValue - last.mean);
+}
+
+void StreamingStatistics::add(double x) {
+    moments.add(x);
+    digest.add(x);
+}
+
+void StreamingStatistics::add(const double* data, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        moments.add(data[i]);
+        digest.add(data[i]);
+    }
+}
+
+void StreamingStatistics::merge(const StreamingStatistics& other) {
+    moments.merge(other.moments);
+    digest.merge(other.digest);
+}
+
+void StreamingStatistics::reset() {
+    moments.reset();
+    digest.reset();
+}
+
+StreamingStatistics StreamingStatistics::fromData(const double* data, size_t count, double compression) {
+    size_t chunks = parallelChunkCount(count, 1 << 16);
+    std::vector<StreamingStatistics> partials(chunks, StreamingStatistics(compression));
+    
+    parallelChunks(count, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        partials[chunk].add(data + begin, end - begin);
+    });
+    
+    // Merged in chunk order so the result does not depend on thread timing
+    StreamingStatistics result = partials[0];
+    for (size_t i = 1; i < partials.size(); i++) {
+        result.merge(partials[i]);
+    }
+    return result;
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// One-pass moment accumulator (Welford, extended to third and fourth moments
+// by Pébay). Values are never stored, so memory is constant in the stream
+// length, and two accumulators built on separate threads merge exactly.
+class RunningStatistics {
+private:
+    size_t n = 0;
+    double meanValue = 0.0;
+    double m2 = 0.0;    // Σ(xᵢ - x̄)²
+    double m3 = 0.0;    // Σ(xᵢ - x̄)³
+    double m4 = 0.0;    // Σ(xᵢ - x̄)⁴
+    double minValue = 0.0;
+    double maxValue = 0.0;
+
+public:
+    // NaN (a missing value) is skipped, as in TDigest, so both see the same data
+    void add(double x);
+    void add(const double* data, size_t count);
+    void merge(const RunningStatistics& other);
+    void reset() { *this = RunningStatistics(); }
+    
+    size_t count() const { return n; }
+    double mean() const { return meanValue; }
+    double variance() const;            // Population variance σ² = M2/n
+    double sampleVariance() const;      // Unbiased s² = M2/(n-1)
+    double standardDeviation() const;
+    double skewness() const;            // g₁ = √n M3 / M2^(3/2)
+    double kurtosis() const;            // Excess kurtosis g₂ = n M4 / M2² - 3
+    double min() const { return minValue; }
+    double max() const { return maxValue; }
+};
+
+// Paired (x, y) co-moments for covariance, correlation and the least-squares
+// line, with the same one-pass update and exact merge as RunningStatistics
+class BivariateStatistics {
+private:
+    size_t n = 0;
+    double meanX = 0.0;
+    double meanY = 0.0;
+    double sxx = 0.0;   // Σ(xᵢ - x̄)²
+    double syy = 0.0;   // Σ(yᵢ - ȳ)²
+    double sxy = 0.0;   // Σ(xᵢ - x̄)(yᵢ - ȳ)
+
+public:
+    void add(double x, double y);
+    void add(const double* x, const double* y, size_t count);
+    void merge(const BivariateStatistics& other);
+    
+    // Per-thread chunks merged in chunk order
+    static BivariateStatistics fromData(const double* x, const double* y, size_t count);
+    
+    size_t count() const { return n; }
+    double getMeanX() const { return meanX; }
+    double getMeanY() const { return meanY; }
+    double getSxx() const { return sxx; }
+    double getSyy() const { return syy; }
+    double getSxy() const { return sxy; }
+    double covariance() const { return n > 0 ? sxy / n : 0.0; }
+    double correlation() const;    // Pearson r; NaN if either variable is constant
+    double slope() const { return sxy / sxx; }
+    double intercept() const { return meanY - slope() * meanX; }
+};
+
+// Merging t-digest (Dunning) quantile sketch. Keeps O(compression) centroids
+// whatever the stream length; accuracy is best in the tails, where the
+// scale function allows only small centroids.
+class TDigest {
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+    
+    double compression;
+    std::vector<Centroid> centroids;    // Sorted by mean after compress()
+    std::vector<Centroid> buffer;       // Unmerged incoming points
+    double totalWeight = 0.0;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    
+    void compress();
+
+public:
+    explicit TDigest(double compression = 100.0);
+    
+    void add(double x, double weight = 1.0);
+    void merge(const TDigest& other);
+    void reset();
+    
+    // q in [0, 1]; NaN when nothing has been added
+    double quantile(double q);
+    
+    double count() const { return totalWeight; }
+    size_t centroidCount();
+};
+
+// Moments plus quantile sketch over one column of values
+class StreamingStatistics {
+private:
+    RunningStatistics moments;
+    TDigest digest;
+
+public:
+    explicit StreamingStatistics(double compression = 100.0) : digest(compression) {}
+    
+    void add(double x);
+    void add(const double* data, size_t count);
+    void merge(const StreamingStatistics& other);
+    void reset();
+    
+    // Splits the data into per-thread chunks and merges their accumulators
+    static StreamingStatistics fromData(const double* data, size_t count, double compression = 100.0);
+    
+    const RunningStatistics& getMoments() const { return moments; }
+    double quantile(double q) { return digest.quantile(q); }
+    double median() { return digest.quantile(0.5); }
+    size_t count() const { return moments.count(); }
+};
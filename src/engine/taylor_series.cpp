@@ -1,9 +1,9 @@
 #include "taylor_series.h"
-#include "differentiator.h"
-#include "simplifier.h"
+#include "job_system.h"
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <stdexcept>
 
 double TaylorSeriesCalculator::factorial(int n) {
     if (n <= 1) return 1.0;
@@ -14,23 +14,245 @@ double TaylorSeriesCalculator::factorial(int n) {
     return result;
 }
 
-double TaylorSeriesCalculator::evaluateAt(const ASTNode* node, double x) {
-    return node->evaluate(x);
+// Truncated power series arithmetic. A jet holds u_0..u_N, the Taylor
+// coefficients of a subexpression at a; each operation below produces the
+// coefficients of its result from those of its operands.
+using Jet = std::vector<double>;
+
+static bool isConstantJet(const Jet& u) {
+    for (size_t k = 1; k < u.size(); k++) {
+        if (u[k] != 0.0) return false;
+    }
+    return true;
+}
+
+static void multiplyJets(const Jet& u, const Jet& v, Jet& out) {
+    const size_t N = u.size();
+    out.assign(N, 0.0);
+    for (size_t k = 0; k < N; k++) {
+        double sum = 0.0;
+        for (size_t j = 0; j <= k; j++) sum += u[j] * v[k - j];
+        out[k] = sum;
+    }
+}
+
+// c = u/v: c_k = (u_k - Σ_{j=1..k} v_j·c_{k-j}) / v_0
+static void divideJets(const Jet& u, const Jet& v, Jet& out) {
+    const size_t N = u.size();
+    out.assign(N, 0.0);
+    for (size_t k = 0; k < N; k++) {
+        double sum = u[k];
+        for (size_t j = 1; j <= k; j++) sum -= v[j] * out[k - j];
+        out[k] = sum / v[0];
+    }
+}
+
+// e = exp(u): e_k = (1/k) Σ_{j=1..k} j·u_j·e_{k-j}
+static void expJet(const Jet& u, Jet& out) {
+    const size_t N = u.size();
+    out.assign(N, 0.0);
+    out[0] = std::exp(u[0]);
+    for (size_t k = 1; k < N; k++) {
+        double sum = 0.0;
+        for (size_t j = 1; j <= k; j++) sum += j * u[j] * out[k - j];
+        out[k] = sum / k;
+    }
+}
+
+// l = ln(u): l_k = (u_k - (1/k) Σ_{j=1..k-1} j·l_j·u_{k-j}) / u_0
+static void lnJet(const Jet& u, Jet& out) {
+    const size_t N = u.size();
+    out.assign(N, 0.0);
+    out[0] = std::log(u[0]);
+    for (size_t k = 1; k < N; k++) {
+        double sum = 0.0;
+        for (size_t j = 1; j < k; j++) sum += j * out[j] * u[k - j];
+        out[k] = (u[k] - sum / k) / u[0];
+    }
+}
+
+// sin and cos together: s_k = (1/k) Σ j·u_j·c_{k-j}, c_k = -(1/k) Σ j·u_j·s_{k-j}
+static void sinCosJets(const Jet& u, Jet& sine, Jet& cosine) {
+    const size_t N = u.size();
+    sine.assign(N, 0.0);
+    cosine.assign(N, 0.0);
+    sine[0] = std::sin(u[0]);
+    cosine[0] = std::cos(u[0]);
+    for (size_t k = 1; k < N; k++) {
+        double s = 0.0, c = 0.0;
+        for (size_t j = 1; j <= k; j++) {
+            s += j * u[j] * cosine[k - j];
+            c += j * u[j] * sine[k - j];
+        }
+        sine[k] = s / k;
+        cosine[k] = -c / k;
+    }
+}
+
+// t = tan(u) from t' = (1 + t²)·u', building w = 1 + t² alongside
+static void tanJet(const Jet& u, Jet& out) {
+    const size_t N = u.size();
+    out.assign(N, 0.0);
+    Jet w(N, 0.0);
+    out[0] = std::tan(u[0]);
+    w[0] = 1.0 + out[0] * out[0];
+    for (size_t k = 1; k < N; k++) {
+        double sum = 0.0;
+        for (size_t j = 1; j <= k; j++) sum += j * u[j] * w[k - j];
+        out[k] = sum / k;
+        double square = 0.0;
+        for (size_t i = 0; i <= k; i++) square += out[i] * out[k - i];
+        w[k] = square;
+    }
+}
+
+// r = √u: r_k = (u_k - Σ_{j=1..k-1} r_j·r_{k-j}) / (2·r_0)
+static void sqrtJet(const Jet& u, Jet& out) {
+    const size_t N = u.size();
+    out.assign(N, 0.0);
+    out[0] = std::sqrt(u[0]);
+    for (size_t k = 1; k < N; k++) {
+        double sum = u[k];
+        for (size_t j = 1; j < k; j++) sum -= out[j] * out[k - j];
+        out[k] = sum / (2.0 * out[0]);
+    }
 }
 
-std::unique_ptr<ASTNode> TaylorSeriesCalculator::nthDerivative(const ASTNode* node, int n) {
-    if (n == 0) {
-        return node->clone();
+// p = u^α for constant α. Small non-negative integer powers are multiplied
+// out, which also covers u_0 = 0; otherwise
+// p_k = (1/(k·u_0)) Σ_{j=1..k} ((α + 1)·j - k)·u_j·p_{k-j}
+static void powerJet(const Jet& u, double alpha, Jet& out) {
+    const size_t N = u.size();
+    if (alpha >= 0.0 && alpha == std::floor(alpha) && alpha <= 64.0) {
+        Jet power(N, 0.0), square = u, scratch;
+        power[0] = 1.0;
+        for (unsigned int k = static_cast<unsigned int>(alpha); k > 0; k >>= 1) {
+            if (k & 1u) {
+                multiplyJets(power, square, scratch);
+                power.swap(scratch);
+            }
+            if (k > 1) {
+                multiplyJets(square, square, scratch);
+                square.swap(scratch);
+            }
+        }
+        out = std::move(power);
+        return;
+    }
+    out.assign(N, 0.0);
+    out[0] = std::pow(u[0], alpha);
+    for (size_t k = 1; k < N; k++) {
+        double sum = 0.0;
+        for (size_t j = 1; j <= k; j++) {
+            sum += ((alpha + 1.0) * j - static_cast<double>(k)) * u[j] * out[k - j];
+        }
+        out[k] = sum / (k * u[0]);
+    }
+}
+
+std::vector<double> TaylorSeriesCalculator::taylorCoefficients(const ASTNode* root, double a, int order) {
+    if (order < 0) {
+        throw std::invalid_argument("Taylor order must be non-negative");
     }
+    const size_t N = static_cast<size_t>(order) + 1;
     
-    Differentiator diff;
-    auto result = diff.differentiate(node);
+    // Post-order walk with an explicit stack; jets holds operand results
+    struct Task {
+        const ASTNode* node;
+        bool expanded;
+    };
+    std::vector<Task> tasks;
+    std::vector<Jet> jets;
+    Jet result, scratch;
+    size_t visited = 0;
     
-    for (int i = 1; i < n; i++) {
-        result = diff.differentiate(result.get());
+    tasks.push_back({root, false});
+    while (!tasks.empty()) {
+        Task task = tasks.back();
+        tasks.pop_back();
+        const ASTNode* node = task.node;
+        if (++visited % 64 == 0) {
+            JobContext::checkpoint();
+        }
+        
+        switch (node->type) {
+            case NodeType::NUMBER:
+                jets.emplace_back(N, 0.0);
+                jets.back()[0] = static_cast<const NumberNode*>(node)->value;
+                break;
+            
+            case NodeType::VARIABLE:
+                // x = a + (x - a)
+                jets.emplace_back(N, 0.0);
+                jets.back()[0] = a;
+                if (N > 1) jets.back()[1] = 1.0;
+                break;
+            
+            case NodeType::BINARY_OP: {
+                auto binOp = static_cast<const BinaryOpNode*>(node);
+                if (!task.expanded) {
+                    tasks.push_back({node, true});
+                    tasks.push_back({binOp->right.get(), false});
+                    tasks.push_back({binOp->left.get(), false});
+                    break;
+                }
+                Jet right = std::move(jets.back());
+                jets.pop_back();
+                Jet& left = jets.back();
+                switch (binOp->op) {
+                    case BinaryOp::ADD:
+                        for (size_t k = 0; k < N; k++) left[k] += right[k];
+                        break;
+                    case BinaryOp::SUB:
+                        for (size_t k = 0; k < N; k++) left[k] -= right[k];
+                        break;
+                    case BinaryOp::MUL:
+                        multiplyJets(left, right, result);
+                        left.swap(result);
+                        break;
+                    case BinaryOp::DIV:
+                        divideJets(left, right, result);
+                        left.swap(result);
+                        break;
+                    case BinaryOp::POW:
+                        if (isConstantJet(right)) {
+                            powerJet(left, right[0], result);
+                        } else {
+                            // u^v = exp(v·ln u)
+                            lnJet(left, scratch);
+                            multiplyJets(right, scratch, result);
+                            expJet(result, scratch);
+                            result.swap(scratch);
+                        }
+                        left.swap(result);
+                        break;
+                }
+                break;
+            }
+            
+            case NodeType::UNARY_FUNC: {
+                auto funcNode = static_cast<const UnaryFuncNode*>(node);
+                if (!task.expanded) {
+                    tasks.push_back({node, true});
+                    tasks.push_back({funcNode->arg.get(), false});
+                    break;
+                }
+                Jet& u = jets.back();
+                switch (funcNode->func) {
+                    case UnaryFunc::SIN: sinCosJets(u, result, scratch); break;
+                    case UnaryFunc::COS: sinCosJets(u, scratch, result); break;
+                    case UnaryFunc::TAN: tanJet(u, result); break;
+                    case UnaryFunc::EXP: expJet(u, result); break;
+                    case UnaryFunc::LN: lnJet(u, result); break;
+                    case UnaryFunc::SQRT: sqrtJet(u, result); break;
+                }
+                u.swap(result);
+                break;
+            }
+        }
     }
     
-    return Simplifier::simplify(std::move(result));
+    return std::move(jets.back());
 }
 
 std::string TaylorSeriesCalculator::computeTaylorSeries(const ASTNode* root, double a, int order) {
@@ -57,17 +279,17 @@ std::string TaylorSeriesCalculator::computeTaylorSeries(const ASTNode* root, dou
     formulaStep.expression = "f(x) = Σ[n=0 to ∞] (f⁽ⁿ⁾(a)/n!) × (x-a)ⁿ";
     steps.push_back(formulaStep);
     
-    // Compute each term
+    // All coefficients in one pass; f⁽ⁿ⁾(a) = n!·c_n
+    std::vector<double> coefficients = taylorCoefficients(root, a, order);
     std::vector<std::string> terms;
     
     for (int n = 0; n <= order; n++) {
+        JobContext::reportProgress(n, order + 1);
+        
         TaylorSeriesStep termStep;
         std::ostringstream stepOss;
         stepOss << std::fixed << std::setprecision(4);
         
-        // Compute nth derivative
-        auto nthDeriv = nthDerivative(root, n);
-        
         termStep.description = "Term " + std::to_string(n) + " (n=" + std::to_string(n) + ")";
         
         if (n == 0) {
@@ -80,14 +302,12 @@ std::string TaylorSeriesCalculator::computeTaylorSeries(const ASTNode* root, dou
             stepOss << "f⁽" << n << "⁾(" << a << ") = ";
         }
         
-        double derivValue = evaluateAt(nthDeriv.get(), a);
+        double coefficient = coefficients[n];
+        double derivValue = coefficient * factorial(n);
         stepOss << derivValue;
         termStep.expression = stepOss.str();
         steps.push_back(termStep);
         
-        // Compute coefficient
-        double coefficient = derivValue / factorial(n);
-        
         TaylorSeriesStep coeffStep;
         std::ostringstream coeffOss;
         coeffOss << std::fixed << std::setprecision(4);
@@ -156,14 +376,12 @@ std::string TaylorSeriesCalculator::computeTaylorSeries(const ASTNode* root, dou
 }
 
 double TaylorSeriesCalculator::evaluateTaylorPolynomial(const ASTNode* root, double a, int order, double x) {
+    // Horner's rule in (x - a)
+    std::vector<double> coefficients = taylorCoefficients(root, a, order);
     double result = 0.0;
     
-    for (int n = 0; n <= order; n++) {
-        auto nthDeriv = nthDerivative(root, n);
-        double derivValue = evaluateAt(nthDeriv.get(), a);
-        double coefficient = derivValue / factorial(n);
-        double term = coefficient * std::pow(x - a, n);
-        result += term;
+    for (int n = order; n >= 0; n--) {
+        result = result * (x - a) + coefficients[n];
     }
     
     return result;
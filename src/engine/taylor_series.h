@@ -12,11 +12,15 @@ class TaylorSeriesCalculator {
 private:
     std::vector<TaylorSeriesStep> steps;
     
-    std::unique_ptr<ASTNode> nthDerivative(const ASTNode* node, int n);
-    double evaluateAt(const ASTNode* node, double x);
     double factorial(int n);
-    
+
 public:
+    // Taylor coefficients c_k = f⁽ᵏ⁾(a)/k!, k = 0..order, by propagating
+    // truncated power series (jets) through the tree: each node costs
+    // O(order²) via the standard recurrences, with no symbolic derivatives.
+    // Every variable is treated as x, as in ASTNode::evaluate(x).
+    static std::vector<double> taylorCoefficients(const ASTNode* root, double a, int order);
+    
     // Compute Taylor series expansion around point 'a' up to order 'n'
     std::string computeTaylorSeries(const ASTNode* root, double a, int order);
     
@@ -0,0 +1,161 @@
+#include "transform_batch.h"
+#include "parallel.h"
+#include <stdexcept>
+
+// Vectors per thread: below this the thread start-up outweighs the streaming work
+static const size_t kMinParallelVectors = size_t(1) << 18;
+
+VectorBatch2D::VectorBatch2D(const std::vector<Vector2D>& vectors) {
+    x.reserve(vectors.size());
+    y.reserve(vectors.size());
+    for (const Vector2D& v : vectors) {
+        push_back(v);
+    }
+}
+
+MatrixBatch2D::MatrixBatch2D(const std::vector<Matrix2D>& matrices) {
+    a.reserve(matrices.size());
+    b.reserve(matrices.size());
+    c.reserve(matrices.size());
+    d.reserve(matrices.size());
+    for (const Matrix2D& m : matrices) {
+        push_back(m);
+    }
+}
+
+namespace transform_batch {
+
+static Matrix2D multiply(const Matrix2D& T1, const Matrix2D& T2) {
+    return Matrix2D(T1.a * T2.a + T1.b * T2.c, T1.a * T2.b + T1.b * T2.d,
+                    T1.c * T2.a + T1.d * T2.c, T1.c * T2.b + T1.d * T2.d);
+}
+
+Matrix2D compose(const std::vector<Matrix2D>& chain) {
+    Matrix2D result;
+    for (const Matrix2D& T : chain) {
+        result = multiply(T, result);
+    }
+    return result;
+}
+
+// The kernels take __restrict pointers so the compiler vectorizes without
+// runtime overlap checks; the in-place form only promises that x and y differ
+static void transformKernel(double a, double b, double c, double d,
+                            const double* __restrict x, const double* __restrict y,
+                            double* __restrict outX, double* __restrict outY, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        outX[i] = a * x[i] + b * y[i];
+        outY[i] = c * x[i] + d * y[i];
+    }
+}
+
+static void transformInPlaceKernel(double a, double b, double c, double d,
+                                   double* __restrict x, double* __restrict y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double vx = x[i];
+        double vy = y[i];
+        x[i] = a * vx + b * vy;
+        y[i] = c * vx + d * vy;
+    }
+}
+
+void apply(const Matrix2D& matrix, const double* x, const double* y,
+           double* outX, double* outY, size_t n) {
+    const bool inPlace = (outX == x && outY == y);
+    size_t chunks = parallelChunkCount(n, kMinParallelVectors);
+    parallelChunks(n, chunks, [&](size_t, size_t begin, size_t end) {
+        if (inPlace) {
+            transformInPlaceKernel(matrix.a, matrix.b, matrix.c, matrix.d, outX + begin, outY + begin, end - begin);
+        } else {
+            transformKernel(matrix.a, matrix.b, matrix.c, matrix.d, x + begin, y + begin,
+                            outX + begin, outY + begin, end - begin);
+        }
+    });
+}
+
+void apply(const Matrix2D& matrix, const VectorBatch2D& in, VectorBatch2D& out) {
+    if (&out != &in) {
+        out.resize(in.size());
+    }
+    apply(matrix, in.x.data(), in.y.data(), out.x.data(), out.y.data(), in.size());
+}
+
+void apply(const Matrix2D& matrix, VectorBatch2D& vectors) {
+    apply(matrix, vectors, vectors);
+}
+
+void applyChain(const std::vector<Matrix2D>& chain, VectorBatch2D& vectors) {
+    apply(compose(chain), vectors);
+}
+
+static void transformEachKernel(const double* __restrict a, const double* __restrict b,
+                                const double* __restrict c, const double* __restrict d,
+                                const double* __restrict x, const double* __restrict y,
+                                double* __restrict outX, double* __restrict outY, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        outX[i] = a[i] * x[i] + b[i] * y[i];
+        outY[i] = c[i] * x[i] + d[i] * y[i];
+    }
+}
+
+static void transformEachInPlaceKernel(const double* __restrict a, const double* __restrict b,
+                                       const double* __restrict c, const double* __restrict d,
+                                       double* __restrict x, double* __restrict y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double vx = x[i];
+        double vy = y[i];
+        x[i] = a[i] * vx + b[i] * vy;
+        y[i] = c[i] * vx + d[i] * vy;
+    }
+}
+
+void applyEach(const MatrixBatch2D& matrices, const VectorBatch2D& in, VectorBatch2D& out) {
+    const size_t n = in.size();
+    if (matrices.size() != n) {
+        throw std::invalid_argument("Need one matrix per vector");
+    }
+    if (&out != &in) {
+        out.resize(n);
+    }
+    
+    size_t chunks = parallelChunkCount(n, kMinParallelVectors);
+    parallelChunks(n, chunks, [&](size_t, size_t begin, size_t end) {
+        if (&out == &in) {
+            transformEachInPlaceKernel(matrices.a.data() + begin, matrices.b.data() + begin,
+                                       matrices.c.data() + begin, matrices.d.data() + begin,
+                                       out.x.data() + begin, out.y.data() + begin, end - begin);
+        } else {
+            transformEachKernel(matrices.a.data() + begin, matrices.b.data() + begin,
+                                matrices.c.data() + begin, matrices.d.data() + begin,
+                                in.x.data() + begin, in.y.data() + begin,
+                                out.x.data() + begin, out.y.data() + begin, end - begin);
+        }
+    });
+}
+
+void composeEach(const MatrixBatch2D& A, const MatrixBatch2D& B, MatrixBatch2D& out) {
+    const size_t n = A.size();
+    if (B.size() != n) {
+        throw std::invalid_argument("Matrix batches must have the same size");
+    }
+    if (&out != &A && &out != &B) {
+        out.a.resize(n);
+        out.b.resize(n);
+        out.c.resize(n);
+        out.d.resize(n);
+    }
+    
+    size_t chunks = parallelChunkCount(n, kMinParallelVectors);
+    parallelChunks(n, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            double a1 = A.a[i], b1 = A.b[i], c1 = A.c[i], d1 = A.d[i];
+            double a2 = B.a[i], b2 = B.b[i], c2 = B.c[i], d2 = B.d[i];
+            out.a[i] = a1 * a2 + b1 * c2;
+            out.b[i] = a1 * b2 + b1 * d2;
+            out.c[i] = c1 * a2 + d1 * c2;
+            out.d[i] = c1 * b2 + d1 * d2;
+        }
+    });
+}
+
+} // namespace transform_batch
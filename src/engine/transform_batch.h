@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "linear_transformation.h"
+
+// Structure-of-arrays buffer of 2D vectors: x and y coordinates are stored
+// in separate contiguous arrays so batch kernels load full SIMD registers of
+// one coordinate at a time
+struct VectorBatch2D {
+    std::vector<double> x;
+    std::vector<double> y;
+    
+    VectorBatch2D() = default;
+    explicit VectorBatch2D(size_t n) : x(n, 0.0), y(n, 0.0) {}
+    explicit VectorBatch2D(const std::vector<Vector2D>& vectors);
+    
+    size_t size() const { return x.size(); }
+    void resize(size_t n) { x.resize(n, 0.0); y.resize(n, 0.0); }
+    void push_back(const Vector2D& v) { x.push_back(v.x); y.push_back(v.y); }
+    Vector2D operator[](size_t i) const { return Vector2D(x[i], y[i]); }
+};
+
+// One 2×2 matrix per vector, entries in separate arrays like VectorBatch2D
+struct MatrixBatch2D {
+    std::vector<double> a, b, c, d;
+    
+    MatrixBatch2D() = default;
+    explicit MatrixBatch2D(const std::vector<Matrix2D>& matrices);
+    
+    size_t size() const { return a.size(); }
+    void push_back(const Matrix2D& m) { a.push_back(m.a); b.push_back(m.b); c.push_back(m.c); d.push_back(m.d); }
+    Matrix2D operator[](size_t i) const { return Matrix2D(a[i], b[i], c[i], d[i]); }
+};
+
+// Batch counterparts of LinearTransformation::applyTransformation and
+// composeTransformations for point clouds. No steps are recorded. The loops
+// are branch-free with unit stride so the compiler vectorizes them, and large
+// batches are split across threads; both are memory-bound, so throughput is
+// limited by bandwidth rather than arithmetic.
+namespace transform_batch {
+
+// Single matrix for a chain applied in order: chain[0] first, chain.back()
+// last, i.e. chain.back() ∘ ... ∘ chain[0]. Identity for an empty chain.
+Matrix2D compose(const std::vector<Matrix2D>& chain);
+
+// out_i = M·v_i. The output arrays must either be the input arrays (in place)
+// or not overlap them.
+void apply(const Matrix2D& matrix, const double* x, const double* y,
+           double* outX, double* outY, size_t n);
+void apply(const Matrix2D& matrix, const VectorBatch2D& in, VectorBatch2D& out);
+void apply(const Matrix2D& matrix, VectorBatch2D& vectors);
+
+// Pre-multiplies the chain once, then makes a single pass over the vectors
+void applyChain(const std::vector<Matrix2D>& chain, VectorBatch2D& vectors);
+
+// out_i = M_i·v_i with a different matrix per vector. Throws
+// std::invalid_argument when the batch sizes differ.
+void applyEach(const MatrixBatch2D& matrices, const VectorBatch2D& in, VectorBatch2D& out);
+
+// out_i = A_i·B_i (apply B_i first), e.g. to fold a per-point transform
+// into a per-point frame before applyEach
+void composeEach(const MatrixBatch2D& A, const MatrixBatch2D& B, MatrixBatch2D& out);
+
+} // namespace transform_batch
@@ -2,6 +2,8 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include "engine/parser.h"
 #include "engine/differentiator.h"
 #include "engine/integrator.h"
@@ -24,12 +26,16 @@
 #include "engine/numerical_methods.h"
 #include "engine/eigenvalues.h"
 #include "engine/statistics.h"
+#include "engine/column_loader.h"
+#include "engine/multiple_regression.h"
 #include "engine/polynomial_operations.h"
+#include "engine/job_system.h"
 #include <iomanip>
 #include <sstream>
 #include "ui/renderer.h"
 #include "ui/text_renderer.h"
 #include "ui/plotter.h"
+#include "ui/live_preview.h"
 
 enum class Mode {
     MENU,
@@ -184,6 +190,7 @@ int main(int argc, char* argv[]) {
     Parser parser;
     std::unique_ptr<ASTNode> ast;
     std::unique_ptr<ASTNode> result;
+    std::string resultText;  // Printed once per result, drawn every frame
     std::vector<DifferentiationStep> diffSteps;
     std::vector<IntegrationStep> integSteps;
     bool parseSuccess = false;
@@ -236,6 +243,8 @@ int main(int argc, char* argv[]) {
     std::vector<PartialDerivativeStep> partialStepsY;
     std::unique_ptr<ASTNode> partialResultX;
     std::unique_ptr<ASTNode> partialResultY;
+    std::string partialResultXText;
+    std::string partialResultYText;
     
     // Double integration mode variables
     int currentDoubleIntegralExpressionIndex = 0;
@@ -314,6 +323,10 @@ int main(int argc, char* argv[]) {
     double numTolerance = 0.0001;
     bool numConfigMode = false;
     std::string numX0Str = "1.0";
+    int numMethod = 0;  // 0=Newton-Raphson, 1=Brent, 2=all roots in [a, b]
+    double numA = 0.0, numB = 2.0;  // Bracket for Brent, scan interval for all roots
+    std::string numIntervalStr = "0, 2";
+    const char* numMethodNames[] = {"Newton-Raphson", "Brent's Method", "All Roots"};
     
     // Eigenvalues mode variables
     std::vector<EigenStep> eigenSteps;
@@ -328,6 +341,8 @@ int main(int argc, char* argv[]) {
     std::vector<double> statsData = {2.0, 4.0, 6.0, 8.0, 10.0};
     bool statsInputMode = false;
     std::string statsDataStr = "2, 4, 6, 8, 10";
+    std::string statsSource;      // "@file[:column]" input: analyzed from disk
+    size_t statsSourceRows = 0;
     
     // Polynomial Operations mode variables
     std::vector<PolynomialStep> polySteps;
@@ -355,11 +370,42 @@ int main(int argc, char* argv[]) {
     bool inputMode = false;
     std::string userInput = "";
     
+    // As-you-type derivative preview for differentiation mode
+    LivePreview livePreview;
+    
     // UI variables
     int scrollOffset = 0;
     Plotter plotter(600, 300);
     plotter.setViewport(-5, 5, -5, 5);
     
+    // Background computation: slow engine calls run on worker threads
+    JobSystem jobSystem;
+    std::shared_ptr<JobContext> activeJob;
+    Mode activeJobMode = Mode::MENU;
+    
+    // Cancel any running job and queue new work. 'apply' runs on this thread once
+    // the job finishes, and only if the user is still in the mode that started it.
+    auto startJob = [&](JobSystem::Work work, std::function<void()> apply) {
+        if (activeJob) {
+            activeJob->cancel();
+        }
+        activeJobMode = currentMode;
+        Mode jobMode = currentMode;
+        activeJob = jobSystem.submit(std::move(work), [&, apply, jobMode](const JobContext& job) {
+            if (currentMode != jobMode) {
+                return;
+            }
+            if (!job.getError().empty()) {
+                parseSuccess = false;
+                errorMsg = "Error: " + job.getError();
+                return;
+            }
+            apply();
+            parseSuccess = true;
+            errorMsg.clear();
+        });
+    };
+    
     // LaTeX export variables
     LaTeXExporter latexExporter;
     std::string exportMessage = "";
@@ -376,6 +422,7 @@ int main(int argc, char* argv[]) {
             diffSteps = diff.getSteps();
             
             result = Simplifier::simplify(std::move(result));
+            resultText = result->toString();
             
             parseSuccess = true;
             errorMsg.clear();
@@ -395,6 +442,7 @@ int main(int argc, char* argv[]) {
             integSteps = integ.getSteps();
             
             result = Simplifier::simplify(std::move(result));
+            resultText = result->toString();
             
             parseSuccess = true;
             errorMsg.clear();
@@ -457,15 +505,27 @@ int main(int argc, char* argv[]) {
                 return;
             }
             
-            // Perform multiplication
-            if (matrixResult) {
-                delete matrixResult;
-            }
-            matrixResult = new Matrix(matOps.multiply(*matrixA, *matrixB));
-            matrixSteps = matOps.getSteps();
-            
-            parseSuccess = true;
-            errorMsg.clear();
+            // Perform multiplication on a worker thread with copies of the operands
+            struct MultiplyOutput {
+                std::unique_ptr<Matrix> product;
+                std::vector<MatrixStep> steps;
+            };
+            auto lhs = std::make_shared<const Matrix>(*matrixA);
+            auto rhs = std::make_shared<const Matrix>(*matrixB);
+            auto output = std::make_shared<MultiplyOutput>();
+            matrixSteps.clear();
+            
+            startJob([lhs, rhs, output](JobContext&) {
+                MatrixOperations jobOps;
+                output->product = std::make_unique<Matrix>(jobOps.multiply(*lhs, *rhs));
+                output->steps = jobOps.getSteps();
+            }, [&, output]() {
+                if (matrixResult) {
+                    delete matrixResult;
+                }
+                matrixResult = output->product.release();
+                matrixSteps = std::move(output->steps);
+            });
         } catch (const std::exception& e) {
             parseSuccess = false;
             errorMsg = std::string("Error: ") + e.what();
@@ -482,12 +542,14 @@ int main(int argc, char* argv[]) {
             partialResultX = partialX.differentiate(ast.get(), DiffVariable::X);
             partialStepsX = partialX.getSteps();
             partialResultX = Simplifier::simplify(std::move(partialResultX));
+            partialResultXText = partialResultX->toString();
             
             // Compute partial derivative with respect to y
             PartialDerivative partialY;
             partialResultY = partialY.differentiate(ast.get(), DiffVariable::Y);
             partialStepsY = partialY.getSteps();
             partialResultY = Simplifier::simplify(std::move(partialResultY));
+            partialResultYText = partialResultY->toString();
             
             parseSuccess = true;
             errorMsg.clear();
@@ -507,12 +569,22 @@ int main(int argc, char* argv[]) {
             double y_lower = std::stod(yLowerBoundStr);
             double y_upper = std::stod(yUpperBoundStr);
             
-            MultivariateIntegrator multiInteg;
-            doubleIntegralResult = multiInteg.doubleIntegrate(ast.get(), x_lower, x_upper, y_lower, y_upper);
-            doubleIntegSteps = multiInteg.getSteps();
-            
-            parseSuccess = true;
-            errorMsg.clear();
+            struct DoubleIntegralOutput {
+                double value = 0.0;
+                std::vector<MultivariateIntegrationStep> steps;
+            };
+            std::shared_ptr<const ASTNode> integrand = ast->clone();
+            auto output = std::make_shared<DoubleIntegralOutput>();
+            doubleIntegSteps.clear();
+            
+            startJob([integrand, x_lower, x_upper, y_lower, y_upper, output](JobContext&) {
+                MultivariateIntegrator multiInteg;
+                output->value = multiInteg.doubleIntegrate(integrand.get(), x_lower, x_upper, y_lower, y_upper);
+                output->steps = multiInteg.getSteps();
+            }, [&, output]() {
+                doubleIntegralResult = output->value;
+                doubleIntegSteps = std::move(output->steps);
+            });
         } catch (const std::exception& e) {
             parseSuccess = false;
             errorMsg = std::string("Error: ") + e.what();
@@ -569,12 +641,24 @@ int main(int argc, char* argv[]) {
             taylorCenter = std::stod(taylorCenterStr);
             taylorOrder = std::stoi(taylorOrderStr);
             
-            TaylorSeriesCalculator taylorCalc;
-            taylorResult = taylorCalc.computeTaylorSeries(ast.get(), taylorCenter, taylorOrder);
-            taylorSteps = taylorCalc.getSteps();
-            
-            parseSuccess = true;
-            errorMsg.clear();
+            struct TaylorOutput {
+                std::string polynomial;
+                std::vector<TaylorSeriesStep> steps;
+            };
+            std::shared_ptr<const ASTNode> func = ast->clone();
+            double center = taylorCenter;
+            int order = taylorOrder;
+            auto output = std::make_shared<TaylorOutput>();
+            taylorSteps.clear();
+            
+            startJob([func, center, order, output](JobContext&) {
+                TaylorSeriesCalculator taylorCalc;
+                output->polynomial = taylorCalc.computeTaylorSeries(func.get(), center, order);
+                output->steps = taylorCalc.getSteps();
+            }, [&, output]() {
+                taylorResult = std::move(output->polynomial);
+                taylorSteps = std::move(output->steps);
+            });
         } catch (const std::exception& e) {
             parseSuccess = false;
             errorMsg = std::string("Error: ") + e.what();
@@ -635,7 +719,13 @@ int main(int argc, char* argv[]) {
     auto processNumericalMethods = [&]() {
         try {
             NumericalMethods numMethods;
-            numMethods.newtonRaphson(ast.get(), numX0, numIterations, numTolerance);
+            if (numMethod == 1) {
+                numMethods.brentMethod(ast.get(), numA, numB, 100, 1e-12);
+            } else if (numMethod == 2) {
+                numMethods.findAllRoots(ast.get(), numA, numB, 1000);
+            } else {
+                numMethods.newtonRaphson(ast.get(), numX0, numIterations, numTolerance);
+            }
             numericalSteps = numMethods.getSteps();
             parseSuccess = true;
             errorMsg.clear();
@@ -659,6 +749,129 @@ int main(int argc, char* argv[]) {
         }
     };
     
+    // Lambda to process Statistics from a column file (CSV or raw float64).
+    // Loading and analysis run as a job; the column is viewed in place from
+    // the loader rather than copied into statsData.
+    auto processStatisticsFile = [&]() {
+        std::string path = statsSource;
+        std::string columnName;
+        size_t colon = path.find_last_of(':');
+        if (colon != std::string::npos && colon > 1) {  // Keep "C:\..." drive letters
+            columnName = path.substr(colon + 1);
+            path = path.substr(0, colon);
+        }
+        
+        struct StatsOutput {
+            std::vector<StatisticsStep> steps;
+            size_t rows = 0;
+        };
+        auto output = std::make_shared<StatsOutput>();
+        statsSteps.clear();
+        
+        startJob([path, columnName, output](JobContext&) {
+            ColumnLoader loader;
+            
+            // "y~x1+x2" fits a multiple regression of column y on x1 and x2
+            size_t tilde = columnName.find('~');
+            if (tilde != std::string::npos) {
+                auto trim = [](const std::string& text) {
+                    size_t first = text.find_first_not_of(" \t");
+                    if (first == std::string::npos) return std::string();
+                    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+                };
+                std::string responseName = trim(columnName.substr(0, tilde));
+                std::vector<std::string> names;
+                std::stringstream terms(columnName.substr(tilde + 1));
+                std::string term;
+                while (std::getline(terms, term, '+')) {
+                    term = trim(term);
+                    if (!term.empty()) names.push_back(term);
+                }
+                
+                std::vector<std::string> used(names);
+                used.push_back(responseName);
+                loader.load(path, used);
+                std::vector<DoubleSpan> columns;
+                for (const std::string& name : used) {
+                    columns.push_back(loader.column(name));
+                }
+                
+                // Rows with a missing value in any used column are left out,
+                // copying the columns only when there are such rows
+                const size_t rows = columns.back().size();
+                std::vector<bool> complete(rows, true);
+                size_t missing = 0;
+                for (size_t r = 0; r < rows; r++) {
+                    for (const DoubleSpan& column : columns) {
+                        if (column[r] != column[r]) {
+                            complete[r] = false;
+                            missing++;
+                            break;
+                        }
+                    }
+                }
+                std::vector<std::vector<double>> kept;
+                if (missing > 0) {
+                    kept.resize(columns.size());
+                    for (size_t c = 0; c < columns.size(); c++) {
+                        kept[c].reserve(rows - missing);
+                        for (size_t r = 0; r < rows; r++) {
+                            if (complete[r]) kept[c].push_back(columns[c][r]);
+                        }
+                        columns[c] = DoubleSpan(kept[c]);
+                    }
+                }
+                
+                DoubleSpan response = columns.back();
+                columns.pop_back();
+                MultipleRegression regression;
+                regression.fit(columns, response, names);
+                output->steps = regression.getSteps();
+                output->rows = rows;
+                if (missing > 0) {
+                    StatisticsStep skipped;
+                    skipped.description = "Missing values:";
+                    skipped.expression = std::to_string(missing) + " of " + std::to_string(rows) +
+                                         " rows have no number in a used column and were left out";
+                    output->steps.insert(output->steps.begin() + 1, skipped);
+                }
+                return;
+            }
+            
+            // Only the analyzed column is parsed out of a text file
+            std::string name = columnName.empty() ? ColumnLoader::columnNames(path).at(0) : columnName;
+            loader.load(path, {name});
+            DoubleSpan column = loader.column(name);
+            
+            // Missing fields load as NaN, which the order statistics cannot
+            // rank; copy the column without them only when there are any
+            size_t missing = std::count_if(column.begin(), column.end(), [](double v) { return v != v; });
+            std::vector<double> present;
+            if (missing > 0) {
+                present.reserve(column.size() - missing);
+                std::copy_if(column.begin(), column.end(), std::back_inserter(present), [](double v) { return v == v; });
+            }
+            if (missing == column.size()) {
+                throw std::runtime_error("Column '" + name + "' has no numeric values");
+            }
+            
+            StatisticsCalculator statsCalc;
+            statsCalc.analyzeDataSet(missing > 0 ? DoubleSpan(present) : column);
+            output->steps = statsCalc.getSteps();
+            output->rows = column.size();
+            if (missing > 0) {
+                StatisticsStep skipped;
+                skipped.description = "Missing values:";
+                skipped.expression = std::to_string(missing) + " of " + std::to_string(column.size()) +
+                                     " rows have no number in '" + name + "' and were left out";
+                output->steps.insert(output->steps.begin() + 1, skipped);
+            }
+        }, [&, output]() {
+            statsSteps = std::move(output->steps);
+            statsSourceRows = output->rows;
+        });
+    };
+    
     // Lambda to process Statistics
     auto processStatistics = [&]() {
         try {
@@ -718,11 +931,22 @@ int main(int argc, char* argv[]) {
     // Lambda to process Fourier Series
     auto processFourierSeries = [&]() {
         try {
-            FourierSeriesCalculator fourierCalc;
-            std::string result = fourierCalc.computeFourierSeries(ast.get(), fourierPeriod, fourierTerms);
-            fourierSteps = fourierCalc.getSteps();
-            parseSuccess = true;
-            errorMsg.clear();
+            struct FourierOutput {
+                std::vector<FourierStep> steps;
+            };
+            std::shared_ptr<const ASTNode> func = ast->clone();
+            double period = fourierPeriod;
+            int terms = fourierTerms;
+            auto output = std::make_shared<FourierOutput>();
+            fourierSteps.clear();
+            
+            startJob([func, period, terms, output](JobContext&) {
+                FourierSeriesCalculator fourierCalc;
+                fourierCalc.computeFourierSeries(func.get(), period, terms);
+                output->steps = fourierCalc.getSteps();
+            }, [&, output]() {
+                fourierSteps = std::move(output->steps);
+            });
         } catch (const std::exception& e) {
             parseSuccess = false;
             errorMsg = std::string("Error: ") + e.what();
@@ -806,7 +1030,7 @@ int main(int argc, char* argv[]) {
                     );
                 }
                 break;
-                
+            
             case Mode::INDEFINITE_INTEGRATION:
                 if (parseSuccess && result) {
                     filename = "integration_solution.tex";
@@ -815,7 +1039,7 @@ int main(int argc, char* argv[]) {
                     );
                 }
                 break;
-                
+            
             case Mode::DEFINITE_INTEGRATION:
                 if (parseSuccess) {
                     filename = "definite_integration_solution.tex";
@@ -825,7 +1049,7 @@ int main(int argc, char* argv[]) {
                     );
                 }
                 break;
-                
+            
             case Mode::LIMITS:
                 if (parseSuccess && !limitSteps.empty()) {
                     filename = "limit_solution.tex";
@@ -835,7 +1059,7 @@ int main(int argc, char* argv[]) {
                     );
                 }
                 break;
-                
+            
             case Mode::MATRIX_MULTIPLICATION:
                 if (matrixA && matrixB && matrixResult && !matrixSteps.empty()) {
                     filename = "matrix_multiplication_solution.tex";
@@ -844,7 +1068,7 @@ int main(int argc, char* argv[]) {
                     );
                 }
                 break;
-                
+            
             default:
                 break;
         }
@@ -879,6 +1103,17 @@ int main(int argc, char* argv[]) {
     SDL_Event event;
     
     while (running) {
+        // Apply results of background jobs that finished since the last frame
+        jobSystem.pollCompleted();
+        if (activeJob && currentMode != activeJobMode) {
+            activeJob->cancel();
+        }
+        
+        // Debounced re-parse of the expression being typed
+        if (inputMode && currentMode == Mode::DIFFERENTIATION) {
+            livePreview.update(SDL_GetTicks());
+        }
+        
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) {
                 running = false;
@@ -897,6 +1132,7 @@ int main(int argc, char* argv[]) {
             else if (event.type == SDL_TEXTINPUT) {
                 if (inputMode) {
                     userInput += event.text.text;
+                    livePreview.notifyEdit(userInput, SDL_GetTicks());
                 }
                 else if (boundsInputMode) {
                     if (editingLowerBound) {
@@ -983,7 +1219,11 @@ int main(int argc, char* argv[]) {
                     }
                 }
                 else if (numConfigMode) {
-                    numX0Str += event.text.text;
+                    if (numMethod == 0) {
+                        numX0Str += event.text.text;
+                    } else {
+                        numIntervalStr += event.text.text;
+                    }
                 }
                 else if (eigenInputMode) {
                     if (eigenInputField == 0) {
@@ -1255,14 +1495,17 @@ int main(int argc, char* argv[]) {
                             // Note: Parametric curve uses parametricXInputMode/parametricYInputMode instead
                         }
                         inputMode = false;
+                        livePreview.reset();
                         SDL_StopTextInput();
                     }
                     else if (event.key.keysym.sym == SDLK_BACKSPACE && !userInput.empty()) {
                         userInput = userInput.substr(0, userInput.length() - 1);
+                        livePreview.notifyEdit(userInput, SDL_GetTicks());
                     }
                     else if (event.key.keysym.sym == SDLK_ESCAPE) {
                         inputMode = false;
                         userInput = "";
+                        livePreview.reset();
                         SDL_StopTextInput();
                     }
                 }
@@ -1691,17 +1934,31 @@ int main(int argc, char* argv[]) {
                 else if (numConfigMode && currentMode == Mode::NUMERICAL_METHODS) {
                     if (event.key.keysym.sym == SDLK_RETURN) {
                         try {
-                            numX0 = std::stod(numX0Str);
+                            if (numMethod == 0) {
+                                numX0 = std::stod(numX0Str);
+                            } else {
+                                // "a, b"
+                                size_t comma = numIntervalStr.find(',');
+                                if (comma == std::string::npos) throw std::invalid_argument("interval");
+                                double a = std::stod(numIntervalStr.substr(0, comma));
+                                double b = std::stod(numIntervalStr.substr(comma + 1));
+                                if (!(a < b)) throw std::invalid_argument("interval");
+                                numA = a;
+                                numB = b;
+                            }
                             numConfigMode = false;
                             SDL_StopTextInput();
                             ast = parser.parse(currentExpression);
                             processNumericalMethods();
                         } catch (...) {
-                            errorMsg = "Invalid initial guess";
+                            errorMsg = numMethod == 0 ? "Invalid initial guess" : "Invalid interval (use a, b with a < b)";
                         }
                     }
-                    else if (event.key.keysym.sym == SDLK_BACKSPACE && !numX0Str.empty()) {
-                        numX0Str = numX0Str.substr(0, numX0Str.length() - 1);
+                    else if (event.key.keysym.sym == SDLK_BACKSPACE) {
+                        std::string& field = numMethod == 0 ? numX0Str : numIntervalStr;
+                        if (!field.empty()) {
+                            field = field.substr(0, field.length() - 1);
+                        }
                     }
                     else if (event.key.keysym.sym == SDLK_ESCAPE) {
                         numConfigMode = false;
@@ -1745,18 +2002,26 @@ int main(int argc, char* argv[]) {
                 // Handle statistics data input
                 else if (statsInputMode && currentMode == Mode::STATISTICS) {
                     if (event.key.keysym.sym == SDLK_RETURN) {
-                        try {
-                            statsData.clear();
-                            std::stringstream ss(statsDataStr);
-                            std::string item;
-                            while (std::getline(ss, item, ',')) {
-                                statsData.push_back(std::stod(item));
-                            }
+                        if (!statsDataStr.empty() && statsDataStr[0] == '@') {
+                            statsSource = statsDataStr.substr(1);
                             statsInputMode = false;
                             SDL_StopTextInput();
-                            processStatistics();
-                        } catch (...) {
-                            errorMsg = "Invalid data format (use: 1, 2, 3, 4)";
+                            processStatisticsFile();
+                        } else {
+                            try {
+                                statsSource.clear();
+                                statsData.clear();
+                                std::stringstream ss(statsDataStr);
+                                std::string item;
+                                while (std::getline(ss, item, ',')) {
+                                    statsData.push_back(std::stod(item));
+                                }
+                                statsInputMode = false;
+                                SDL_StopTextInput();
+                                processStatistics();
+                            } catch (...) {
+                                errorMsg = "Invalid data format (use: 1, 2, 3, 4)";
+                            }
                         }
                     }
                     else if (event.key.keysym.sym == SDLK_BACKSPACE && !statsDataStr.empty()) {
@@ -1851,8 +2116,12 @@ int main(int argc, char* argv[]) {
                             }
                             break;
                         case SDLK_t:
-                            // T key to quick toggle limit type (limits only)
-                            if (currentMode == Mode::LIMITS) {
+                            // T key to quick toggle limit type, or the root-finding method
+                            if (currentMode == Mode::NUMERICAL_METHODS) {
+                                numMethod = (numMethod + 1) % 3;
+                                scrollOffset = 0;
+                                processNumericalMethods();
+                            } else if (currentMode == Mode::LIMITS) {
                                 limitTypeSelection = (limitTypeSelection + 1) % 3;
                                 if (limitTypeSelection == 0) {
                                     limitType = LimitType::FINITE;
@@ -2174,7 +2443,17 @@ int main(int argc, char* argv[]) {
                 std::string inputPrompt = "Type equation: " + userInput + "_";
                 textRenderer.renderText(inputPrompt, leftMargin, y, yellow);
                 textRenderer.renderText("(Press ENTER to compute, ESC to cancel)", leftMargin, y + lineHeight, gray);
-                y += lineHeight * 2 + 15;
+                y += lineHeight * 2;
+                
+                if (livePreview.hasResult()) {
+                    textRenderer.renderText("Preview: f'(x) = " + livePreview.getDerivativeText(), leftMargin, y, cyan);
+                    y += lineHeight;
+                }
+                std::ostringstream latencyOss;
+                latencyOss << std::fixed << std::setprecision(2)
+                           << "Live preview p99: " << livePreview.latencyPercentile(99.0) << " ms";
+                textRenderer.renderText(latencyOss.str(), leftMargin, y, gray);
+                y += lineHeight + 15;
             } else {
                 std::string inputLine = "Input: f(x) = " + currentExpression;
                 textRenderer.renderText(inputLine, leftMargin, y, green);
@@ -2197,7 +2476,7 @@ int main(int argc, char* argv[]) {
                 y += 10;
                 textRenderer.renderText("--- Simplified Result ---", leftMargin, y, yellow);
                 y += lineHeight;
-                std::string finalResult = "f'(x) = " + result->toString();
+                std::string finalResult = "f'(x) = " + resultText;
                 textRenderer.renderText(finalResult, leftMargin, y, green);
                 y += lineHeight + 20;
                 
@@ -2220,9 +2499,11 @@ int main(int argc, char* argv[]) {
                 glMatrixMode(GL_MODELVIEW);
                 glLoadIdentity();
                 
+                // While typing, plot the live preview instead of the last computed result
+                bool showPreview = inputMode && livePreview.hasResult();
                 plotter.render();
-                plotter.plotFunction(ast.get(), 0.3f, 0.6f, 1.0f);
-                plotter.plotFunction(result.get(), 1.0f, 0.3f, 0.3f);
+                plotter.plotFunction(showPreview ? livePreview.getFunction() : ast.get(), 0.3f, 0.6f, 1.0f);
+                plotter.plotFunction(showPreview ? livePreview.getDerivative() : result.get(), 1.0f, 0.3f, 0.3f);
                 
                 glViewport(0, 0, renderer.getWidth(), renderer.getHeight());
                 glMatrixMode(GL_PROJECTION);
@@ -2272,7 +2553,7 @@ int main(int argc, char* argv[]) {
                 y += 10;
                 textRenderer.renderText("--- Result (Antiderivative) ---", leftMargin, y, yellow);
                 y += lineHeight;
-                std::string finalResult = "∫ f(x) dx = " + result->toString() + " + C";
+                std::string finalResult = "∫ f(x) dx = " + resultText + " + C";
                 textRenderer.renderText(finalResult, leftMargin, y, green);
                 y += lineHeight + 20;
                 
@@ -2658,7 +2939,7 @@ int main(int argc, char* argv[]) {
                     y += lineHeight + 5;
                 }
                 
-                std::string resultX = "∂f/∂x = " + partialResultX->toString();
+                std::string resultX = "∂f/∂x = " + partialResultXText;
                 textRenderer.renderText(resultX, leftMargin, y, green);
                 y += lineHeight + 15;
                 
@@ -2675,7 +2956,7 @@ int main(int argc, char* argv[]) {
                     y += lineHeight + 5;
                 }
                 
-                std::string resultY = "∂f/∂y = " + partialResultY->toString();
+                std::string resultY = "∂f/∂y = " + partialResultYText;
                 textRenderer.renderText(resultY, leftMargin, y, green);
                 y += lineHeight + 20;
                 
@@ -3098,7 +3379,7 @@ int main(int argc, char* argv[]) {
         // === NUMERICAL METHODS MODE ===
         else if (currentMode == Mode::NUMERICAL_METHODS) {
             y = 20 - scrollOffset;
-            textRenderer.renderText("Numerical Methods Mode - Newton-Raphson", leftMargin, y, cyan);
+            textRenderer.renderText(std::string("Numerical Methods Mode - ") + numMethodNames[numMethod], leftMargin, y, cyan);
             y += lineHeight + 10;
             
             if (inputMode) {
@@ -3107,10 +3388,11 @@ int main(int argc, char* argv[]) {
                 textRenderer.renderText("(Press ENTER to set, ESC to cancel)", leftMargin, y + lineHeight, gray);
                 y += lineHeight * 2 + 15;
             } else if (numConfigMode) {
-                textRenderer.renderText("Configure Initial Guess:", leftMargin, y, yellow);
+                textRenderer.renderText(numMethod == 0 ? "Configure Initial Guess:" : "Configure Interval:", leftMargin, y, yellow);
                 y += lineHeight + 10;
                 
-                std::string x0Prompt = "> Initial guess (x0): " + numX0Str + "_";
+                std::string x0Prompt = numMethod == 0 ? "> Initial guess (x0): " + numX0Str + "_"
+                                                      : "> Interval (a, b): " + numIntervalStr + "_";
                 textRenderer.renderText(x0Prompt, leftMargin + 20, y, green);
                 y += lineHeight + 10;
                 
@@ -3119,12 +3401,14 @@ int main(int argc, char* argv[]) {
                 std::string func = "f(x) = " + currentExpression;
                 textRenderer.renderText(func, leftMargin, y, green);
                 y += lineHeight;
-                std::string initial = "Initial guess: x0 = " + std::to_string(numX0);
+                std::string initial = numMethod == 0
+                    ? "Initial guess: x0 = " + std::to_string(numX0)
+                    : "Interval: [" + std::to_string(numA) + ", " + std::to_string(numB) + "]";
                 textRenderer.renderText(initial, leftMargin, y, white);
                 y += lineHeight + 15;
                 
                 if (parseSuccess && !numericalSteps.empty()) {
-                    textRenderer.renderText("--- Newton-Raphson Method ---", leftMargin, y, yellow);
+                    textRenderer.renderText(std::string("--- ") + numMethodNames[numMethod] + " ---", leftMargin, y, yellow);
                     y += lineHeight;
                     
                     for (size_t i = 0; i < numericalSteps.size(); i++) {
@@ -3140,7 +3424,9 @@ int main(int argc, char* argv[]) {
                     }
                     
                     y += 10;
-                    textRenderer.renderText("ENTER: custom | C: config x0 | ESC: menu", 20, 690, gray);
+                    textRenderer.renderText(numMethod == 0 ? "ENTER: custom | C: config x0 | T: method | ESC: menu"
+                                                           : "ENTER: custom | C: config [a, b] | T: method | ESC: menu",
+                                            20, 690, gray);
                 } else if (!errorMsg.empty()) {
                     textRenderer.renderText(errorMsg, leftMargin, y, {255, 100, 100, 255});
                 }
@@ -3218,14 +3504,24 @@ int main(int argc, char* argv[]) {
                 
                 textRenderer.renderText("Example: 2, 4, 6, 8, 10", leftMargin + 20, y, gray);
                 y += lineHeight;
+                textRenderer.renderText("File: @data.csv:column, @data.csv:y~x1+x2 or @values.bin (raw float64)", leftMargin + 20, y, gray);
+                y += lineHeight;
                 textRenderer.renderText("(ENTER to compute, ESC to cancel)", leftMargin, y, gray);
             } else {
-                std::string dataStr = "Data: {";
-                for (size_t i = 0; i < statsData.size(); i++) {
-                    if (i > 0) dataStr += ", ";
-                    dataStr += std::to_string((int)statsData[i]);
+                std::string dataStr;
+                if (!statsSource.empty()) {
+                    dataStr = "Data: " + statsSource;
+                    if (statsSourceRows > 0) {
+                        dataStr += " (" + std::to_string(statsSourceRows) + " values)";
+                    }
+                } else {
+                    dataStr = "Data: {";
+                    for (size_t i = 0; i < statsData.size(); i++) {
+                        if (i > 0) dataStr += ", ";
+                        dataStr += std::to_string((int)statsData[i]);
+                    }
+                    dataStr += "}";
                 }
-                dataStr += "}";
                 textRenderer.renderText(dataStr, leftMargin, y, green);
                 y += lineHeight + 15;
                 
@@ -3517,6 +3813,14 @@ int main(int argc, char* argv[]) {
             exportMessageTimer--;
         }
         
+        // Spinner while a background job is running
+        if (activeJob && !activeJob->isFinished() && !activeJob->isCancelled()) {
+            float seconds = SDL_GetTicks() / 1000.0f;
+            renderer.drawSpinner(1240.0f, 40.0f, 14.0f, seconds);
+            int percent = static_cast<int>(activeJob->getProgress() * 100.0f);
+            textRenderer.renderText("Computing... " + std::to_string(percent) + "%", 1060, 28, cyan);
+        }
+        
         renderer.present();
         SDL_Delay(16);
     }
@@ -3526,6 +3830,9 @@ int main(int argc, char* argv[]) {
     if (matrixB) delete matrixB;
     if (matrixResult) delete matrixResult;
     
+    // Stop background work before tearing down the UI
+    jobSystem.cancelAll();
+    
     textRenderer.cleanup();
     renderer.cleanup();
     
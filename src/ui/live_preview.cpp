@@ -0,0 +1,95 @@
+#include "live_preview.h"
+#include "../engine/differentiator.h"
+#include "../engine/simplifier.h"
+#include <algorithm>
+#include <chrono>
+
+static const size_t LATENCY_WINDOW = 256;
+static const uint32_t MAX_DEBOUNCE_MS = 1000;
+
+LivePreview::LivePreview(uint32_t debounceMs, double budgetMs)
+    : lastEditMs(0), dirty(false), baseDebounceMs(debounceMs), debounceMs(debounceMs),
+      budgetMs(budgetMs), nextSample(0) {
+    latencySamples.reserve(LATENCY_WINDOW);
+}
+
+void LivePreview::notifyEdit(const std::string& input, uint32_t nowMs) {
+    pendingInput = input;
+    lastEditMs = nowMs;
+    dirty = true;
+}
+
+bool LivePreview::update(uint32_t nowMs) {
+    if (!dirty || nowMs - lastEditMs < debounceMs) {
+        return false;
+    }
+    dirty = false;
+    
+    if (pendingInput == previewedInput) {
+        return false;
+    }
+    previewedInput = pendingInput;
+    
+    if (pendingInput.empty()) {
+        function.reset();
+        derivative.reset();
+        derivativeText.clear();
+        error.clear();
+        return true;
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    try {
+        auto parsed = parser.parse(pendingInput, parseCache);
+        
+        Differentiator diff;
+        auto deriv = Simplifier::simplify(diff.differentiate(parsed.get()));
+        
+        derivativeText = deriv->toString();
+        function = std::move(parsed);
+        derivative = std::move(deriv);
+        error.clear();
+    } catch (const std::exception& e) {
+        // Half-typed input: keep showing the last good preview
+        error = e.what();
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    recordLatency(elapsed.count());
+    
+    // Back off while over budget so typing stays responsive
+    if (!withinBudget()) {
+        debounceMs = std::min(MAX_DEBOUNCE_MS, debounceMs * 2);
+    } else if (debounceMs > baseDebounceMs) {
+        debounceMs = std::max(baseDebounceMs, debounceMs / 2);
+    }
+    return true;
+}
+
+void LivePreview::reset() {
+    pendingInput.clear();
+    previewedInput.clear();
+    dirty = false;
+    function.reset();
+    derivative.reset();
+    derivativeText.clear();
+    error.clear();
+}
+
+void LivePreview::recordLatency(double ms) {
+    if (latencySamples.size() < LATENCY_WINDOW) {
+        latencySamples.push_back(ms);
+    } else {
+        latencySamples[nextSample] = ms;
+    }
+    nextSample = (nextSample + 1) % LATENCY_WINDOW;
+}
+
+double LivePreview::latencyPercentile(double p) const {
+    if (latencySamples.empty()) {
+        return 0.0;
+    }
+    std::vector<double> sorted = latencySamples;
+    size_t rank = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
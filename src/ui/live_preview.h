@@ -0,0 +1,56 @@
+#pragma once
+#include "../engine/parser.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// Re-parses and differentiates the expression while it is being typed, so the
+// derivative and plot follow the input without waiting for ENTER.
+class LivePreview {
+private:
+    Parser parser;
+    ParseCache parseCache;
+    
+    std::string pendingInput;
+    std::string previewedInput;
+    uint32_t lastEditMs;
+    bool dirty;
+    
+    std::unique_ptr<ASTNode> function;
+    std::unique_ptr<ASTNode> derivative;
+    std::string derivativeText;
+    std::string error;
+    
+    // Debounce grows while the pipeline misses its budget and shrinks back once it fits
+    uint32_t baseDebounceMs;
+    uint32_t debounceMs;
+    double budgetMs;
+    
+    // Ring buffer of recent parse + differentiate + simplify latencies
+    std::vector<double> latencySamples;
+    size_t nextSample;
+    
+    void recordLatency(double ms);
+    
+public:
+    LivePreview(uint32_t debounceMs = 100, double budgetMs = 4.0);
+    
+    void notifyEdit(const std::string& input, uint32_t nowMs);
+    
+    // Call once per frame; returns true when a new preview was computed
+    bool update(uint32_t nowMs);
+    void reset();
+    
+    bool hasResult() const { return function && derivative; }
+    const ASTNode* getFunction() const { return function.get(); }
+    const ASTNode* getDerivative() const { return derivative.get(); }
+    const std::string& getDerivativeText() const { return derivativeText; }
+    const std::string& getError() const { return error; }
+    
+    // Latency percentile (0..100) over the recent samples, in milliseconds
+    double latencyPercentile(double p) const;
+    bool withinBudget() const { return latencyPercentile(99.0) <= budgetMs; }
+    uint32_t getDebounceMs() const { return debounceMs; }
+    const ParseCache& getParseCache() const { return parseCache; }
+};
@@ -1,5 +1,6 @@
 #include "renderer.h"
 #include <iostream>
+#include <cmath>
 
 Renderer::Renderer() : window(nullptr), glContext(nullptr), windowWidth(0), windowHeight(0) {}
 
@@ -80,6 +81,25 @@ void Renderer::present() {
     SDL_GL_SwapWindow(window);
 }
 
+void Renderer::drawSpinner(float cx, float cy, float radius, float timeSeconds) {
+    // Rotating arc of segments fading from head to tail
+    const int segments = 12;
+    const float twoPi = 6.28318530718f;
+    float head = timeSeconds * twoPi;
+    
+    glLineWidth(3.0f);
+    glBegin(GL_LINES);
+    for (int i = 0; i < segments; i++) {
+        float angle = head - i * (twoPi / segments);
+        float alpha = 1.0f - static_cast<float>(i) / segments;
+        glColor4f(0.4f, 0.8f, 1.0f, alpha);
+        glVertex2f(cx + 0.5f * radius * std::cos(angle), cy + 0.5f * radius * std::sin(angle));
+        glVertex2f(cx + radius * std::cos(angle), cy + radius * std::sin(angle));
+    }
+    glEnd();
+    glLineWidth(1.0f);
+}
+
 void Renderer::cleanup() {
     if (glContext) {
         SDL_GL_DeleteContext(glContext);
@@ -16,6 +16,7 @@ public:
     bool init(const char* title, int width, int height);
     void clear(float r, float g, float b);
     void present();
+    void drawSpinner(float cx, float cy, float radius, float timeSeconds);
     void cleanup();
     
     int getWidth() const { return windowWidth; }
@@ -1,7 +1,14 @@
 #include "text_renderer.h"
 #include <iostream>
+#include <functional>
+#include <iterator>
 
-TextRenderer::TextRenderer() : font(nullptr) {}
+// Default cache budget: 64 MB of RGBA texels or 4096 strings, whichever is hit first
+static const size_t DEFAULT_CACHE_BYTES = 64 * 1024 * 1024;
+static const size_t DEFAULT_CACHE_ENTRIES = 4096;
+
+TextRenderer::TextRenderer()
+    : font(nullptr), maxCacheBytes(DEFAULT_CACHE_BYTES), maxCacheEntries(DEFAULT_CACHE_ENTRIES) {}
 
 TextRenderer::~TextRenderer() {
     cleanup();
@@ -87,23 +94,100 @@ void TextRenderer::drawTexture(const TextTexture& texture, int x, int y) {
     glDisable(GL_TEXTURE_2D);
 }
 
+uint32_t TextRenderer::packColor(SDL_Color color) {
+    return (uint32_t(color.r) << 24) | (uint32_t(color.g) << 16) |
+           (uint32_t(color.b) << 8) | uint32_t(color.a);
+}
+
+uint64_t TextRenderer::makeCacheKey(const std::string& text, uint32_t packedColor) {
+    uint64_t h = std::hash<std::string>{}(text);
+    // Mix the color in (splitmix64 finalizer) so equal strings in different colors spread out
+    h ^= uint64_t(packedColor) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+void TextRenderer::eraseEntry(std::list<CacheEntry>::iterator it) {
+    glDeleteTextures(1, &it->texture.textureID);
+    cacheStats.bytesResident -= it->bytes;
+    textureCache.erase(it->key);
+    lruList.erase(it);
+    cacheStats.entries = lruList.size();
+}
+
+void TextRenderer::evictToBudget(size_t incomingBytes) {
+    while (!lruList.empty() &&
+           (cacheStats.bytesResident + incomingBytes > maxCacheBytes ||
+            lruList.size() + 1 > maxCacheEntries)) {
+        eraseEntry(std::prev(lruList.end()));
+        cacheStats.evictions++;
+    }
+}
+
+void TextRenderer::setCacheBudget(size_t maxBytes, size_t maxEntries) {
+    maxCacheBytes = maxBytes;
+    maxCacheEntries = maxEntries > 0 ? maxEntries : 1;
+    
+    // Shrink immediately if the new budget is tighter
+    while (!lruList.empty() &&
+           (cacheStats.bytesResident > maxCacheBytes || lruList.size() > maxCacheEntries)) {
+        eraseEntry(std::prev(lruList.end()));
+        cacheStats.evictions++;
+    }
+}
+
+void TextRenderer::clearCache() {
+    for (auto& entry : lruList) {
+        glDeleteTextures(1, &entry.texture.textureID);
+    }
+    lruList.clear();
+    textureCache.clear();
+    cacheStats.bytesResident = 0;
+    cacheStats.entries = 0;
+}
+
 void TextRenderer::renderText(const std::string& text, int x, int y, SDL_Color color) {
     // Check cache
-    std::string cacheKey = text + "_" + std::to_string(color.r) + "_" + 
-                          std::to_string(color.g) + "_" + std::to_string(color.b);
+    uint32_t packed = packColor(color);
+    uint64_t cacheKey = makeCacheKey(text, packed);
     
     auto it = textureCache.find(cacheKey);
     if (it != textureCache.end()) {
-        drawTexture(it->second, x, y);
-        return;
+        auto entry = it->second;
+        if (entry->color == packed && entry->text == text) {
+            cacheStats.hits++;
+            lruList.splice(lruList.begin(), lruList, entry);
+            drawTexture(entry->texture, x, y);
+            return;
+        }
+        // Hash collision: drop the old string, the new one takes the slot
+        eraseEntry(entry);
     }
+    cacheStats.misses++;
     
     // Create and cache new texture
     TextTexture texture = createTextTexture(text, color);
-    if (texture.textureID != 0) {
-        textureCache[cacheKey] = texture;
+    if (texture.textureID == 0) {
+        return;
+    }
+    
+    size_t bytes = size_t(texture.width) * size_t(texture.height) * 4;
+    if (bytes > maxCacheBytes) {
+        // Larger than the whole budget: draw once without caching
         drawTexture(texture, x, y);
+        glDeleteTextures(1, &texture.textureID);
+        return;
     }
+    
+    evictToBudget(bytes);
+    lruList.push_front({cacheKey, text, packed, texture, bytes});
+    textureCache[cacheKey] = lruList.begin();
+    cacheStats.bytesResident += bytes;
+    cacheStats.entries = lruList.size();
+    
+    drawTexture(texture, x, y);
 }
 
 int TextRenderer::getTextWidth(const std::string& text) {
@@ -121,10 +205,7 @@ int TextRenderer::getTextHeight() {
 
 void TextRenderer::cleanup() {
     // Delete all cached textures
-    for (auto& pair : textureCache) {
-        glDeleteTextures(1, &pair.second.textureID);
-    }
-    textureCache.clear();
+    clearCache();
     
     if (font) {
         TTF_CloseFont(font);
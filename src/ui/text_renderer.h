@@ -3,7 +3,9 @@
 #include <SDL2/SDL_ttf.h>
 #include <GL/glew.h>
 #include <string>
-#include <map>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
 
 struct TextTexture {
     GLuint textureID;
@@ -11,10 +13,39 @@ struct TextTexture {
     int height;
 };
 
+// Counters for the glyph texture cache
+struct TextCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t bytesResident = 0;  // Sum of width × height × 4 over cached textures
+    size_t entries = 0;
+};
+
 class TextRenderer {
 private:
+    struct CacheEntry {
+        uint64_t key;
+        std::string text;      // Kept to reject hash collisions
+        uint32_t color;
+        TextTexture texture;
+        size_t bytes;
+    };
+    
     TTF_Font* font;
-    std::map<std::string, TextTexture> textureCache;
+    
+    // LRU order: front is most recently used
+    std::list<CacheEntry> lruList;
+    std::unordered_map<uint64_t, std::list<CacheEntry>::iterator> textureCache;
+    
+    size_t maxCacheBytes;
+    size_t maxCacheEntries;
+    TextCacheStats cacheStats;
+    
+    static uint32_t packColor(SDL_Color color);
+    static uint64_t makeCacheKey(const std::string& text, uint32_t packedColor);
+    void eraseEntry(std::list<CacheEntry>::iterator it);
+    void evictToBudget(size_t incomingBytes);
     
 public:
     TextRenderer();
@@ -26,6 +57,11 @@ public:
     void drawTexture(const TextTexture& texture, int x, int y);
     void cleanup();
     
+    // Texture cache control
+    void setCacheBudget(size_t maxBytes, size_t maxEntries);
+    void clearCache();
+    const TextCacheStats& getCacheStats() const { return cacheStats; }
+    
     int getTextWidth(const std::string& text);
     int getTextHeight();
 };